@@ -0,0 +1,379 @@
+// imnode_graph: headless benchmark
+// Runs the editor on synthetic graphs without any display backend and reports per-frame CPU time, vertex counts
+// and allocation counts. Nothing is rendered: ImGui::Render() only builds the draw lists, which is the part we own.
+
+// Build (Dear ImGui sources in ../imgui, or pass -DIMGUI_DIR=...):
+//   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target imnode_graph_bench
+// Usage:
+//   imnode_graph_bench [--max-nodes N] [--frames N] [--output bench_output.txt]
+
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imgui.h"
+#include "imnode_graph.h"
+#include "imnode_graph_internal.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Allocation counting
+//-----------------------------------------------------------------------------
+
+static int GAllocCount = 0;
+
+static void* BenchMemAlloc(size_t size, void*)
+{
+    GAllocCount++;
+    return malloc(size);
+}
+
+static void BenchMemFree(void* ptr, void*)
+{
+    free(ptr);
+}
+
+//-----------------------------------------------------------------------------
+// Synthetic graphs
+//-----------------------------------------------------------------------------
+
+enum BenchGraphKind
+{
+    BenchGraphKind_Grid,            // Nodes on a square grid, each linked to its left neighbour
+    BenchGraphKind_RandomDag,       // Random positions, each node linked to one or two random earlier nodes
+    BenchGraphKind_Chains,          // Rows of 1000 nodes, each linked to the previous one
+    BenchGraphKind_COUNT
+};
+
+static const char* BenchGraphKindNames[BenchGraphKind_COUNT] = { "grid", "random_dag", "chains" };
+
+// Node n: node ID = n*4+1, inputs n*4+2 and n*4+3, output n*4+4. Links are numbered from 1 separately.
+static inline ImGuiID NodeID(int n)     { return (ImGuiID)n * 4 + 1; }
+
+static const float NodeSpacingX = 220.0f;
+static const float NodeSpacingY = 140.0f;
+
+static ImU32 GRandState = 1;
+static int BenchRand(int range)
+{
+    GRandState = GRandState * 1664525u + 1013904223u;
+    return (int)((GRandState >> 8) % (ImU32)range);
+}
+
+// Every node sits at x >= 0, y >= 0 so the area left and above of the origin stays empty
+static void BuildGraph(BenchGraphKind kind, int node_count)
+{
+    GRandState = 1;
+    ImNodeGraph::ReserveGraph(node_count, node_count * 3, node_count * 2);
+    const int columns = (int)ImSqrt((float)node_count);
+    ImGuiID link_id = 1;
+    for (int n = 0; n < node_count; n++)
+    {
+        ImVec2 pos;
+        switch (kind)
+        {
+        case BenchGraphKind_Grid:       pos = ImVec2((n % columns) * NodeSpacingX, (n / columns) * NodeSpacingY); break;
+        case BenchGraphKind_RandomDag:  pos = ImVec2((float)BenchRand(columns * (int)NodeSpacingX), (float)BenchRand(columns * (int)NodeSpacingY)); break;
+        default:                        pos = ImVec2((n % 1000) * NodeSpacingX, (n / 1000) * NodeSpacingY); break;
+        }
+        const ImGuiID id = NodeID(n);
+        ImNodeGraph::AddNode(id, pos);
+        ImNodeGraph::AddPin(id, id + 1, ImPinDirection_Input);
+        ImNodeGraph::AddPin(id, id + 2, ImPinDirection_Input);
+        ImNodeGraph::AddPin(id, id + 3, ImPinDirection_Output);
+        if (n == 0)
+            continue;
+        switch (kind)
+        {
+        case BenchGraphKind_Grid:
+            if (n % columns != 0)
+                ImNodeGraph::Link(link_id++, NodeID(n - 1) + 3, id + 1);
+            break;
+        case BenchGraphKind_RandomDag:
+            ImNodeGraph::Link(link_id++, NodeID(BenchRand(n)) + 3, id + 1);
+            if (BenchRand(2) == 0)
+                ImNodeGraph::Link(link_id++, NodeID(BenchRand(n)) + 3, id + 2);
+            break;
+        default:
+            if (n % 1000 != 0)
+                ImNodeGraph::Link(link_id++, NodeID(n - 1) + 3, id + 1);
+            break;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Frames
+//-----------------------------------------------------------------------------
+
+enum BenchScenario
+{
+    BenchScenario_Idle,
+    BenchScenario_Pan,
+    BenchScenario_Zoom,
+    BenchScenario_BoxSelect,
+    BenchScenario_Drag1k,
+    BenchScenario_COUNT
+};
+
+static const char* BenchScenarioNames[BenchScenario_COUNT] = { "idle", "pan", "zoom", "box_select", "drag_1k" };
+
+struct BenchFrameStats
+{
+    double  Ms;
+    int     Vertices;
+    int     Indices;
+    int     DrawCmds;
+    int     Allocs;
+};
+
+static const ImVec2 DisplaySize(1920.0f, 1080.0f);
+static const ImVec2 InitialPan(100.0f, 100.0f);
+
+// 'setup' runs between BeginGraph() and EndGraph(), before the nodes are submitted
+static BenchFrameStats RunFrame(void (*setup)(void*), void* setup_data)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = DisplaySize;
+    io.DeltaTime = 1.0f / 60.0f;
+
+    const int allocs_before = GAllocCount;
+    const std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(DisplaySize);
+    ImGui::Begin("Benchmark", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings);
+    ImNodeGraph::BeginGraph("Graph");
+    if (setup)
+        setup(setup_data);
+    for (int n = 0; n < ImNodeGraph::GetVisibleNodeCount(); n++)
+    {
+        const ImGuiID id = ImNodeGraph::GetVisibleNodeID(n);
+        if (ImNodeGraph::BeginNode(id, "Node", 1))
+        {
+            ImNodeGraph::Pin(id + 1, "A", ImPinDirection_Input);
+            ImNodeGraph::Pin(id + 2, "B", ImPinDirection_Input);
+            ImNodeGraph::Pin(id + 3, "Out", ImPinDirection_Output);
+            ImNodeGraph::EndNode();
+        }
+    }
+    ImNodeGraph::EndGraph();
+    ImGui::End();
+    ImGui::Render();
+    const std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    BenchFrameStats stats;
+    stats.Ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    stats.Vertices = ImGui::GetDrawData()->TotalVtxCount;
+    stats.Indices = ImGui::GetDrawData()->TotalIdxCount;
+    stats.DrawCmds = 0;
+    for (int n = 0; n < ImGui::GetDrawData()->CmdListsCount; n++)
+        stats.DrawCmds += ImGui::GetDrawData()->CmdLists[n]->CmdBuffer.Size;
+    stats.Allocs = GAllocCount - allocs_before;
+    return stats;
+}
+
+struct BenchBuildData
+{
+    BenchGraphKind  Kind;
+    int             NodeCount;
+};
+
+static void SetupBuild(void* user_data)
+{
+    BenchBuildData* data = (BenchBuildData*)user_data;
+    ImNodeGraph::GetCurrentGraph()->Pan = InitialPan;
+    BuildGraph(data->Kind, data->NodeCount);
+}
+
+static int CompareU64s(const void* lhs, const void* rhs)
+{
+    const ImU64 a = *(const ImU64*)lhs, b = *(const ImU64*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+// Select the 1000 nodes closest to the top-left corner of the graph, outputs the closest one as the drag handle
+static void SetupSelect1k(void* user_data)
+{
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImVector<ImU64> order;
+    for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+        if (nodes.Slots.IsSlotAlive(node_idx))
+            order.push_back(((ImU64)(nodes.Pos[node_idx].x + nodes.Pos[node_idx].y) << 32) | (ImU32)node_idx);
+    ImQsort(order.Data, (size_t)order.Size, sizeof(ImU64), CompareU64s);
+    for (int n = 0; n < order.Size && n < 1000; n++)
+        ImNodeGraph::SetNodeSelected(graph, (int)(order[n] & 0xFFFFFFFF), true);
+    *(int*)user_data = order.Size > 0 ? (int)(order[0] & 0xFFFFFFFF) : 0;
+}
+
+static int CompareDoubles(const void* lhs, const void* rhs)
+{
+    const double a = *(const double*)lhs, b = *(const double*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+struct BenchResult
+{
+    double  MeanMs, P50Ms, P95Ms, MaxMs;
+    int     Vertices, Indices, DrawCmds;
+    double  AllocsPerFrame;
+};
+
+static BenchResult RunScenario(BenchScenario scenario, int frame_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const ImVec2 center = DisplaySize * 0.5f;
+    const ImVec2 empty_pos = InitialPan * 0.5f; // Left and above of the graph origin, never covered by a node
+    ImVector<double> times;
+    BenchResult result;
+    memset(&result, 0, sizeof(result));
+    int allocs = 0;
+
+    // Back to a known view and state
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentContext()->LastGraph;
+    graph->Pan = InitialPan;
+    graph->Zoom = 1.0f;
+    io.AddMousePosEvent(center.x, center.y);
+    RunFrame(NULL, NULL);
+    RunFrame(NULL, NULL);
+
+    ImVec2 drag_start = center;
+    if (scenario == BenchScenario_Drag1k)
+    {
+        int handle_idx = 0;
+        RunFrame(SetupSelect1k, &handle_idx);
+        drag_start = graph->CanvasToScreen(graph->Nodes.Pos[handle_idx] + ImVec2(20.0f, 5.0f)); // Title bar
+    }
+    if (scenario == BenchScenario_BoxSelect)
+        drag_start = empty_pos;
+    io.AddMousePosEvent(drag_start.x, drag_start.y);
+    RunFrame(NULL, NULL);
+    if (scenario == BenchScenario_Pan)
+        io.AddMouseButtonEvent(ImGuiMouseButton_Right, true);
+    if (scenario == BenchScenario_BoxSelect || scenario == BenchScenario_Drag1k)
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, true);
+
+    ImVec2 mouse = drag_start;
+    for (int frame = 0; frame < frame_count; frame++)
+    {
+        // Movements go back and forth so long runs stay around the same area
+        const float dir = ((frame / 60) % 2 == 0) ? 1.0f : -1.0f;
+        switch (scenario)
+        {
+        case BenchScenario_Pan:
+        case BenchScenario_Drag1k:
+            mouse += ImVec2(4.0f, 2.0f) * dir;
+            io.AddMousePosEvent(mouse.x, mouse.y);
+            break;
+        case BenchScenario_Zoom:
+            io.AddMouseWheelEvent(0.0f, ((frame / 10) % 2 == 0) ? -1.0f : 1.0f);
+            break;
+        case BenchScenario_BoxSelect:
+            mouse = ImLerp(empty_pos, DisplaySize, (float)(frame % 60 + 1) / 60.0f);
+            io.AddMousePosEvent(mouse.x, mouse.y);
+            break;
+        default:
+            break;
+        }
+        // Box selection is applied on release, which is where most of its cost goes
+        if (scenario == BenchScenario_BoxSelect && frame % 60 == 59)
+            io.AddMouseButtonEvent(ImGuiMouseButton_Left, false);
+        if (scenario == BenchScenario_BoxSelect && frame % 60 == 0 && frame > 0)
+        {
+            io.AddMousePosEvent(empty_pos.x, empty_pos.y);
+            io.AddMouseButtonEvent(ImGuiMouseButton_Left, true);
+        }
+
+        const BenchFrameStats stats = RunFrame(NULL, NULL);
+        times.push_back(stats.Ms);
+        result.MeanMs += stats.Ms;
+        result.MaxMs = ImMax(result.MaxMs, stats.Ms);
+        result.Vertices = ImMax(result.Vertices, stats.Vertices);
+        result.Indices = ImMax(result.Indices, stats.Indices);
+        result.DrawCmds = ImMax(result.DrawCmds, stats.DrawCmds);
+        allocs += stats.Allocs;
+    }
+    io.AddMouseButtonEvent(ImGuiMouseButton_Left, false);
+    io.AddMouseButtonEvent(ImGuiMouseButton_Right, false);
+    RunFrame(NULL, NULL);
+    graph->Interaction = ImNodeGraphInteraction_None;
+    ImNodeGraph::ClearNodeSelection(graph);
+
+    qsort(times.Data, (size_t)times.Size, sizeof(double), CompareDoubles);
+    result.MeanMs /= frame_count;
+    result.P50Ms = times[frame_count / 2];
+    result.P95Ms = times[ImMin(frame_count - 1, frame_count * 95 / 100)];
+    result.AllocsPerFrame = (double)allocs / frame_count;
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    int max_nodes = 1000000;
+    int frame_count = 300;
+    const char* output_path = "bench_output.txt";
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--max-nodes") == 0 && n + 1 < argc)
+            max_nodes = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--frames") == 0 && n + 1 < argc)
+            frame_count = ImMax(1, atoi(argv[++n]));
+        else if (strcmp(argv[n], "--output") == 0 && n + 1 < argc)
+            output_path = argv[++n];
+        else
+        {
+            fprintf(stderr, "Usage: %s [--max-nodes N] [--frames N] [--output PATH]\n", argv[0]);
+            return 1;
+        }
+    }
+    FILE* f = fopen(output_path, "w");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Cannot open '%s' for writing\n", output_path);
+        return 1;
+    }
+
+    // No backend: fonts are built to a CPU side texture which is never uploaded, draw data is produced and dropped
+    ImGui::SetAllocatorFunctions(BenchMemAlloc, BenchMemFree, NULL);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = DisplaySize;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    const char* header = "%-11s %8s %-11s %9s %9s %9s %9s %10s %10s %9s %10s %12s\n";
+    const char* row = "%-11s %8d %-11s %9.3f %9.3f %9.3f %9.3f %10d %10d %9d %10.1f %12.1f\n";
+    fprintf(f, "# imnode_graph benchmark, %d frames per scenario, %.0fx%.0f canvas\n", frame_count, DisplaySize.x, DisplaySize.y);
+    fprintf(f, header, "graph", "nodes", "scenario", "mean_ms", "p50_ms", "p95_ms", "max_ms", "vertices", "indices", "draw_cmds", "allocs", "build_ms");
+    for (int node_count = 1000; node_count <= max_nodes; node_count *= 10)
+        for (int kind = 0; kind < BenchGraphKind_COUNT; kind++)
+        {
+            // Fresh editor context per graph so nothing carries over from the previous one
+            ImNodeGraph::CreateContext();
+            BenchBuildData build_data = { (BenchGraphKind)kind, node_count };
+            const BenchFrameStats build = RunFrame(SetupBuild, &build_data);
+            for (int scenario = 0; scenario < BenchScenario_COUNT; scenario++)
+            {
+                const BenchResult r = RunScenario((BenchScenario)scenario, frame_count);
+                fprintf(f, row, BenchGraphKindNames[kind], node_count, BenchScenarioNames[scenario], r.MeanMs, r.P50Ms, r.P95Ms, r.MaxMs, r.Vertices, r.Indices, r.DrawCmds, r.AllocsPerFrame, build.Ms);
+                fflush(f);
+                printf(row, BenchGraphKindNames[kind], node_count, BenchScenarioNames[scenario], r.MeanMs, r.P50Ms, r.P95Ms, r.MaxMs, r.Vertices, r.Indices, r.DrawCmds, r.AllocsPerFrame, build.Ms);
+            }
+            ImNodeGraph::DestroyContext();
+        }
+
+    ImGui::DestroyContext();
+    fclose(f);
+    return 0;
+}
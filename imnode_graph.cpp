@@ -0,0 +1,6925 @@
+// imnode_graph: Node Graph Editor for Dear ImGui
+
+/*
+
+Index of this file:
+
+// [SECTION] Context
+// [SECTION] Style
+// [SECTION] Frame arena
+// [SECTION] ID map
+// [SECTION] Spatial index
+// [SECTION] Graph elements
+// [SECTION] Graph
+// [SECTION] Interaction
+// [SECTION] Minimap
+// [SECTION] Nodes and pins
+// [SECTION] Links
+// [SECTION] Groups
+// [SECTION] Link routing
+// [SECTION] Undo history
+// [SECTION] Evaluation
+// [SECTION] Auto layout
+// [SECTION] Queries
+// [SECTION] Graph files
+// [SECTION] Instrumentation
+
+*/
+
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imnode_graph.h"
+#include "imnode_graph_internal.h"
+#include <chrono>
+
+#ifndef IMNODEGRAPH_DISABLE_FILE_MAPPING
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif
+
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Current context pointer, implicitly used by all ImNodeGraph functions. Same threading rules as GImGui.
+static ImNodeGraphContext* GImNodeGraph = NULL;
+
+namespace ImNodeGraph
+{
+static void             DrawGrid(ImNodeGraphData* graph, ImDrawList* draw_list);
+static void             UpdateVisibleNodes(ImNodeGraphData* graph);
+static void             UpdateVisibleLinks(ImNodeGraphData* graph);
+static void             DrawReducedNodes(ImNodeGraphData* graph, ImDrawList* draw_list);
+static bool             ArePinsCompatible(ImNodeGraphData* graph, int pin_a, int pin_b);
+static bool             IsLinkDragCyclic(ImNodeGraphData* graph, int start_pin_idx, int target_pin_idx);
+static void             UpdateHovered(ImNodeGraphData* graph);
+static void             UpdateInteraction(ImNodeGraphData* graph, ImDrawList* draw_list);
+static void             DrawLinks(ImNodeGraphData* graph, ImDrawList* draw_list);
+static void             UpdateMinimap(ImNodeGraphData* graph, ImDrawList* draw_list);
+static void             DestroyExecutor(ImNodeGraphContext* ctx);
+static void             FlushTraceEvents(ImNodeGraphContext* ctx);
+static void             RecordNodesMoved(ImNodeGraphData* graph, const ImVec2& offset);
+static void             UnlinkFromGroup(ImNodeGraphData* graph, int node_idx);
+static void             AddGroupBoundaryLink(ImNodeGraphData* graph, int group_idx, ImNodeGraphHandle link);
+static ImVec2           GetGroupBoundaryPinPos(ImNodeGraphData* graph, int group_idx, ImPinDirection direction);
+static int              GetGroupBoundaryPins(ImNodeGraphData* graph, int group_idx);
+static void             UpdateLayout(ImNodeGraphData* graph);
+static int              BuildElbowRoute(const ImVec2& start, const ImVec2& end, float margin, ImVec2 out_points[6]);
+static void             SetLinkRoute(ImNodeGraphData* graph, int link_idx, const ImVec2* points, int count);
+static void             ResetLinkRoutes(ImNodeGraphData* graph);
+static ImNodeGraphMappedFile* MapFile(const char* filename);
+static void             UnmapFile(ImNodeGraphMappedFile* file);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Context
+//-----------------------------------------------------------------------------
+
+ImNodeGraphContext* ImNodeGraph::CreateContext()
+{
+    ImNodeGraphContext* ctx = IM_NEW(ImNodeGraphContext)();
+    if (GImNodeGraph == NULL)
+        SetCurrentContext(ctx);
+    return ctx;
+}
+
+void ImNodeGraph::DestroyContext(ImNodeGraphContext* ctx)
+{
+    if (ctx == NULL)
+        ctx = GImNodeGraph;
+    if (GImNodeGraph == ctx)
+        SetCurrentContext(NULL);
+    DestroyExecutor(ctx);
+    if (ctx->TraceFile != NULL)
+    {
+        ImNodeGraphContext* backup_ctx = GImNodeGraph;
+        SetCurrentContext(ctx);
+        EndTraceCapture();
+        SetCurrentContext(backup_ctx);
+    }
+    IM_DELETE(ctx);
+}
+
+ImNodeGraphContext* ImNodeGraph::GetCurrentContext()
+{
+    return GImNodeGraph;
+}
+
+void ImNodeGraph::SetCurrentContext(ImNodeGraphContext* ctx)
+{
+    GImNodeGraph = ctx;
+}
+
+ImNodeGraphData* ImNodeGraph::GetCurrentGraph()
+{
+    IM_ASSERT(GImNodeGraph != NULL && "No current context. Did you call ImNodeGraph::CreateContext()?");
+    return GImNodeGraph->CurrentGraph;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Style
+//-----------------------------------------------------------------------------
+
+ImNodeGraphStyle::ImNodeGraphStyle()
+{
+    GridSpacing         = 32.0f;
+    NodePadding         = ImVec2(8.0f, 6.0f);
+    NodeRounding        = 4.0f;
+    NodeBorderSize      = 1.0f;
+    PinRadius           = 4.5f;
+    PinHoverRadius      = 8.0f;
+    LinkThickness       = 2.5f;
+    LinkSegmentLength   = 10.0f;
+    LinkHoverDistance   = 6.0f;
+    LinkSnapDistance    = 24.0f;
+    LinkRouteMargin     = 16.0f;
+    ZoomMin             = 0.05f;
+    ZoomMax             = 4.0f;
+    LodSimpleZoom       = 0.5f;
+    LodBoxZoom          = 0.25f;
+    LodDensityZoom      = 0.1f;
+    LayoutSpacing       = ImVec2(80.0f, 30.0f);
+    LayoutAnimDuration  = 0.3f;
+    MinimapSize         = ImVec2(200.0f, 150.0f);
+    MinimapOffset       = ImVec2(10.0f, 10.0f);
+    MinimapPadding      = ImVec2(4.0f, 4.0f);
+
+    Colors[ImNodeGraphCol_GridBg]           = IM_COL32(32, 32, 36, 255);
+    Colors[ImNodeGraphCol_GridLine]         = IM_COL32(56, 56, 64, 255);
+    Colors[ImNodeGraphCol_NodeBg]           = IM_COL32(48, 48, 54, 240);
+    Colors[ImNodeGraphCol_NodeHeader]       = IM_COL32(70, 80, 110, 255);
+    Colors[ImNodeGraphCol_NodeOutline]      = IM_COL32(90, 90, 100, 255);
+    Colors[ImNodeGraphCol_NodeSelected]     = IM_COL32(255, 176, 60, 255);
+    Colors[ImNodeGraphCol_NodeTitle]        = IM_COL32(235, 235, 240, 255);
+    Colors[ImNodeGraphCol_NodeDensity]      = IM_COL32(110, 130, 180, 255);
+    Colors[ImNodeGraphCol_PinLabel]         = IM_COL32(200, 200, 205, 255);
+    Colors[ImNodeGraphCol_Pin]              = IM_COL32(150, 190, 230, 255);
+    Colors[ImNodeGraphCol_PinHovered]       = IM_COL32(230, 240, 255, 255);
+    Colors[ImNodeGraphCol_Link]             = IM_COL32(160, 170, 190, 255);
+    Colors[ImNodeGraphCol_LinkHovered]      = IM_COL32(240, 240, 255, 255);
+    Colors[ImNodeGraphCol_BoxSelect]        = IM_COL32(90, 130, 220, 40);
+    Colors[ImNodeGraphCol_BoxSelectOutline] = IM_COL32(90, 130, 220, 160);
+    Colors[ImNodeGraphCol_MinimapBg]        = IM_COL32(24, 24, 28, 220);
+    Colors[ImNodeGraphCol_MinimapDensity]   = IM_COL32(110, 130, 180, 255);
+    Colors[ImNodeGraphCol_MinimapViewport]  = IM_COL32(255, 255, 255, 24);
+    Colors[ImNodeGraphCol_MinimapViewportOutline] = IM_COL32(255, 255, 255, 140);
+}
+
+ImNodeGraphStyle& ImNodeGraph::GetStyle()
+{
+    IM_ASSERT(GImNodeGraph != NULL && "No current context. Did you call ImNodeGraph::CreateContext()?");
+    return GImNodeGraph->Style;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Frame arena
+//-----------------------------------------------------------------------------
+
+ImNodeGraphFrameArena* ImNodeGraph::GetFrameArena()
+{
+    IM_ASSERT(GImNodeGraph != NULL && "No current context. Did you call ImNodeGraph::CreateContext()?");
+    return &GImNodeGraph->FrameArena;
+}
+
+void* ImNodeGraphFrameArena::Alloc(size_t size)
+{
+    size = (size + 15) & ~(size_t)15;
+    if (Size + size <= Capacity)
+    {
+        void* ptr = Data + Size;
+        Size += size;
+        return ptr;
+    }
+    void* block = IM_ALLOC(size);
+    Overflow.push_back(block);
+    OverflowSize += size;
+    return block;
+}
+
+void ImNodeGraphFrameArena::Reset()
+{
+    if (Overflow.Size > 0)
+    {
+        // The frame didn't fit: grow to what it used, with some headroom for the visible set changing
+        const size_t used = Size + OverflowSize;
+        for (int n = 0; n < Overflow.Size; n++)
+            IM_FREE(Overflow[n]);
+        Overflow.resize(0);
+        OverflowSize = 0;
+        if (Data != NULL)
+            IM_FREE(Data);
+        Capacity = ImMax(used + used / 2, (size_t)16 * 1024);
+        Data = (char*)IM_ALLOC(Capacity);
+    }
+    Size = 0;
+    Epoch++;
+}
+
+void ImNodeGraphFrameArena::Clear()
+{
+    for (int n = 0; n < Overflow.Size; n++)
+        IM_FREE(Overflow[n]);
+    Overflow.clear();
+    OverflowSize = 0;
+    if (Data != NULL)
+        IM_FREE(Data);
+    Data = NULL;
+    Size = Capacity = 0;
+    Epoch++;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ID map
+//-----------------------------------------------------------------------------
+
+// Finalizer of MurmurHash3, spreads sequential IDs over the whole table
+static inline ImU32 IDMapHash(ImGuiID key)
+{
+    key ^= key >> 16;
+    key *= 0x85EBCA6B;
+    key ^= key >> 13;
+    key *= 0xC2B2AE35;
+    key ^= key >> 16;
+    return key;
+}
+
+ImU32 ImNodeGraphIDMap::Get(ImGuiID key, ImU32 default_val) const
+{
+    if (key == 0)
+        return HasZeroKey ? ZeroKeyValue : default_val;
+    if (Pairs.Size == 0)
+        return default_val;
+    const ImU32 mask = (ImU32)Pairs.Size - 1;
+    for (ImU32 idx = IDMapHash(key) & mask; ; idx = (idx + 1) & mask)
+    {
+        const ImNodeGraphIDMapPair& pair = Pairs.Data[idx];
+        if (pair.Key == key)
+            return pair.Value;
+        if (pair.Key == 0)
+            return default_val;
+    }
+}
+
+ImU32* ImNodeGraphIDMap::GetRef(ImGuiID key, ImU32 default_val)
+{
+    if (key == 0)
+    {
+        if (!HasZeroKey)
+        {
+            HasZeroKey = true;
+            ZeroKeyValue = default_val;
+            Count++;
+        }
+        return &ZeroKeyValue;
+    }
+
+    // Keep the load factor under 70%
+    if ((Count + 1) * 10 > Pairs.Size * 7)
+        Reserve(Count + 1);
+    const ImU32 mask = (ImU32)Pairs.Size - 1;
+    for (ImU32 idx = IDMapHash(key) & mask; ; idx = (idx + 1) & mask)
+    {
+        ImNodeGraphIDMapPair& pair = Pairs.Data[idx];
+        if (pair.Key == key)
+            return &pair.Value;
+        if (pair.Key == 0)
+        {
+            pair.Key = key;
+            pair.Value = default_val;
+            Count++;
+            return &pair.Value;
+        }
+    }
+}
+
+bool ImNodeGraphIDMap::Remove(ImGuiID key)
+{
+    if (key == 0)
+    {
+        if (!HasZeroKey)
+            return false;
+        HasZeroKey = false;
+        Count--;
+        return true;
+    }
+    if (Pairs.Size == 0)
+        return false;
+
+    const ImU32 mask = (ImU32)Pairs.Size - 1;
+    ImU32 hole = IDMapHash(key) & mask;
+    while (Pairs.Data[hole].Key != key)
+    {
+        if (Pairs.Data[hole].Key == 0)
+            return false;
+        hole = (hole + 1) & mask;
+    }
+
+    // Backward shift: move up every following entry which would not be reachable anymore from its home slot
+    for (ImU32 idx = (hole + 1) & mask; Pairs.Data[idx].Key != 0; idx = (idx + 1) & mask)
+    {
+        const ImU32 home = IDMapHash(Pairs.Data[idx].Key) & mask;
+        if (((idx - home) & mask) >= ((idx - hole) & mask))
+        {
+            Pairs.Data[hole] = Pairs.Data[idx];
+            hole = idx;
+        }
+    }
+    Pairs.Data[hole].Key = 0;
+    Count--;
+    return true;
+}
+
+void ImNodeGraphIDMap::Reserve(int count)
+{
+    int new_size = 16;
+    while (count * 10 > new_size * 7)
+        new_size *= 2;
+    if (new_size <= Pairs.Size)
+        return;
+
+    ImVector<ImNodeGraphIDMapPair> old_pairs;
+    old_pairs.swap(Pairs);
+    Pairs.resize(new_size);
+    memset(Pairs.Data, 0, (size_t)Pairs.size_in_bytes());
+    const ImU32 mask = (ImU32)new_size - 1;
+    for (int n = 0; n < old_pairs.Size; n++)
+    {
+        if (old_pairs[n].Key == 0)
+            continue;
+        ImU32 idx = IDMapHash(old_pairs[n].Key) & mask;
+        while (Pairs.Data[idx].Key != 0)
+            idx = (idx + 1) & mask;
+        Pairs.Data[idx] = old_pairs[n];
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Spatial index
+//-----------------------------------------------------------------------------
+
+// Cell coordinates are clamped to 16-bit so a cell key is exact: +/- 8M canvas units with the default cell size.
+static inline ImGuiID GridCellKey(int x, int y)
+{
+    return (ImGuiID)(x + 32768) | ((ImGuiID)(y + 32768) << 16);
+}
+
+static inline int GridCellCoord(float v, float inv_cell_size)
+{
+    return ImClamp((int)floorf(v * inv_cell_size), -32768, 32767);
+}
+
+ImNodeGraphGridRange ImNodeGraphSpatialGrid::GetRange(const ImRect& bb) const
+{
+    const float inv_cell_size = 1.0f / CellSize;
+    return ImNodeGraphGridRange(GridCellCoord(bb.Min.x, inv_cell_size), GridCellCoord(bb.Min.y, inv_cell_size),
+                                GridCellCoord(bb.Max.x, inv_cell_size), GridCellCoord(bb.Max.y, inv_cell_size));
+}
+
+void ImNodeGraphSpatialGrid::Update(int item_idx, ImNodeGraphGridRange* range, const ImRect& bb)
+{
+    const ImNodeGraphGridRange new_range = GetRange(bb);
+    if (new_range == *range)
+        return;
+    Remove(item_idx, range);
+
+    if (item_idx >= QueryStamps.Size)
+        QueryStamps.resize(item_idx + 1, 0);
+    for (int y = new_range.Y0; y <= new_range.Y1; y++)
+        for (int x = new_range.X0; x <= new_range.X1; x++)
+        {
+            int entry_idx = FreeEntry;
+            if (entry_idx != -1)
+                FreeEntry = Entries[entry_idx].Next;
+            else
+            {
+                entry_idx = Entries.Size;
+                Entries.resize(Entries.Size + 1);
+            }
+            ImU32* head = Cells.GetRef(GridCellKey(x, y), (ImU32)-1);
+            Entries[entry_idx].Item = item_idx;
+            Entries[entry_idx].Next = (int)*head;
+            *head = (ImU32)entry_idx;
+        }
+    *range = new_range;
+}
+
+void ImNodeGraphSpatialGrid::Remove(int item_idx, ImNodeGraphGridRange* range)
+{
+    for (int y = range->Y0; y <= range->Y1; y++)
+        for (int x = range->X0; x <= range->X1; x++)
+        {
+            const ImGuiID cell_key = GridCellKey(x, y);
+            const int head = (int)Cells.Get(cell_key, (ImU32)-1);
+            int prev = -1;
+            int entry_idx = head;
+            while (entry_idx != -1 && Entries[entry_idx].Item != item_idx)
+            {
+                prev = entry_idx;
+                entry_idx = Entries[entry_idx].Next;
+            }
+            IM_ASSERT(entry_idx != -1 && "Element missing from a cell of its range");
+            if (entry_idx == -1)
+                continue;
+            if (prev != -1)
+                Entries[prev].Next = Entries[entry_idx].Next;
+            else if (Entries[entry_idx].Next != -1)
+                Cells.Set(cell_key, (ImU32)Entries[entry_idx].Next);
+            else
+                Cells.Remove(cell_key);
+            Entries[entry_idx].Next = FreeEntry;
+            FreeEntry = entry_idx;
+        }
+    *range = ImNodeGraphGridRange();
+}
+
+void ImNodeGraphSpatialGrid::CollectCell(int entry_idx, ImNodeGraphArenaVector<int>* out_items)
+{
+    for (; entry_idx != -1; entry_idx = Entries[entry_idx].Next)
+    {
+        const int item_idx = Entries[entry_idx].Item;
+        if (QueryStamps[item_idx] != QueryStamp)
+        {
+            QueryStamps[item_idx] = QueryStamp;
+            out_items->push_back(item_idx);
+        }
+    }
+}
+
+void ImNodeGraphSpatialGrid::QueryCells(const ImRect& bb, ImNodeGraphArenaVector<ImNodeGraphGridCell>* out_cells) const
+{
+    const ImNodeGraphGridRange range = GetRange(bb);
+    out_cells->resize(0);
+
+    // Zoomed out views can span far more cells than are occupied: walk the occupied cells instead.
+    const ImU64 range_cells = (ImU64)(range.X1 - range.X0 + 1) * (ImU64)(range.Y1 - range.Y0 + 1);
+    if (range_cells <= (ImU64)Cells.Count)
+    {
+        for (int y = range.Y0; y <= range.Y1; y++)
+            for (int x = range.X0; x <= range.X1; x++)
+            {
+                const int head = (int)Cells.Get(GridCellKey(x, y), (ImU32)-1);
+                if (head != -1)
+                    out_cells->push_back(ImNodeGraphGridCell(x, y, head));
+            }
+        return;
+    }
+    for (int pair_n = 0; pair_n < Cells.Pairs.Size + 1; pair_n++)
+    {
+        // The zero key is stored outside of the pairs, visit it last
+        const bool zero_key = (pair_n == Cells.Pairs.Size);
+        if (zero_key ? !Cells.HasZeroKey : Cells.Pairs[pair_n].Key == 0)
+            continue;
+        const ImGuiID cell_key = zero_key ? 0 : Cells.Pairs[pair_n].Key;
+        const int x = (int)(cell_key & 0xFFFF) - 32768;
+        const int y = (int)(cell_key >> 16) - 32768;
+        if (x >= range.X0 && x <= range.X1 && y >= range.Y0 && y <= range.Y1)
+            out_cells->push_back(ImNodeGraphGridCell(x, y, (int)(zero_key ? Cells.ZeroKeyValue : Cells.Pairs[pair_n].Value)));
+    }
+}
+
+void ImNodeGraphSpatialGrid::Query(const ImRect& bb, ImNodeGraphArenaVector<int>* out_items)
+{
+    QueryCells(bb, &CellBuffer);
+    QueryStamp++;
+    for (int n = 0; n < CellBuffer.Size; n++)
+        CollectCell(CellBuffer[n].Head, out_items);
+}
+
+void ImNodeGraphSpatialGrid::QueryMore(const ImRect& bb, ImNodeGraphArenaVector<int>* out_items)
+{
+    QueryCells(bb, &CellBuffer);
+    for (int n = 0; n < CellBuffer.Size; n++)
+        CollectCell(CellBuffer[n].Head, out_items);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Graph elements
+//-----------------------------------------------------------------------------
+
+int ImNodeGraphSlots::Alloc()
+{
+    AliveCount++;
+    if (FreeSlots.Size > 0)
+    {
+        const int idx = FreeSlots.back();
+        FreeSlots.pop_back();
+        Generations[idx]++;
+        return idx;
+    }
+    IM_ASSERT(Generations.Size < IMNODEGRAPH_HANDLE_MAX_SLOTS && "Too many elements for the handle index bits");
+    Generations.push_back(1);
+    return Generations.Size - 1;
+}
+
+void ImNodeGraphSlots::Free(int idx)
+{
+    IM_ASSERT(IsSlotAlive(idx));
+    Generations[idx]++;
+    FreeSlots.push_back(idx);
+    AliveCount--;
+}
+
+int ImNodeGraphNodePool::Add(ImGuiID id)
+{
+    const int idx = Slots.Alloc();
+    if (idx == ID.Size)
+    {
+        ID.push_back(0);
+        Pos.push_back(ImVec2());
+        Size.push_back(ImVec2());
+        FirstPin.push_back(0);
+        GridRange.push_back(ImNodeGraphGridRange());
+        RouteRect.push_back(ImRect());
+        Depth.push_back(0);
+        VisibleFrame.push_back(-1);
+        DrawOrder.push_back(-1);
+        DrawCache.push_back(NULL);
+        TopoOrder.push_back(-1);
+        TopoVisit.push_back(0);
+        Dirty.push_back(false);
+        ComputeCallback.push_back(NULL);
+        ComputeUserData.push_back(NULL);
+        Parent.push_back(0);
+        FirstChild.push_back(0);
+        NextSibling.push_back(0);
+        Collapsed.push_back(false);
+        Hidden.push_back(false);
+        GroupState.push_back(NULL);
+    }
+    ID[idx] = id;
+    Pos[idx] = Size[idx] = ImVec2(0.0f, 0.0f);
+    FirstPin[idx] = 0;
+    GridRange[idx] = ImNodeGraphGridRange();
+    RouteRect[idx] = ImRect();
+    Depth[idx] = 0;
+    VisibleFrame[idx] = -1;
+    DrawOrder[idx] = -1;
+    TopoOrder[idx] = -1;
+    TopoVisit[idx] = 0;
+    Dirty[idx] = false;
+    ComputeCallback[idx] = NULL;
+    ComputeUserData[idx] = NULL;
+    Parent[idx] = FirstChild[idx] = NextSibling[idx] = 0;
+    Collapsed[idx] = Hidden[idx] = false;
+    return idx;
+}
+
+int ImNodeGraphPinPool::Add(ImGuiID id)
+{
+    const int idx = Slots.Alloc();
+    if (idx == ID.Size)
+    {
+        ID.push_back(0);
+        Node.push_back(0);
+        Offset.push_back(ImVec2());
+        Direction.push_back(ImPinDirection_Input);
+        Type.push_back(0);
+        NextPin.push_back(0);
+        FirstLink.push_back(0);
+        GridRange.push_back(ImNodeGraphGridRange());
+    }
+    ID[idx] = id;
+    Node[idx] = NextPin[idx] = FirstLink[idx] = 0;
+    Offset[idx] = ImVec2(0.0f, 0.0f);
+    Direction[idx] = ImPinDirection_Input;
+    Type[idx] = 0;
+    GridRange[idx] = ImNodeGraphGridRange();
+    return idx;
+}
+
+int ImNodeGraphLinkPool::Add(ImGuiID id)
+{
+    const int idx = Slots.Alloc();
+    if (idx == ID.Size)
+    {
+        ID.push_back(0);
+        StartPin.push_back(0);
+        EndPin.push_back(0);
+        NextAtStart.push_back(0);
+        NextAtEnd.push_back(0);
+        Geometry.push_back(ImNodeGraphLinkGeometry());
+        Cyclic.push_back(false);
+    }
+    ID[idx] = id;
+    StartPin[idx] = EndPin[idx] = NextAtStart[idx] = NextAtEnd[idx] = 0;
+    Geometry[idx] = ImNodeGraphLinkGeometry();
+    Cyclic[idx] = false;
+    return idx;
+}
+
+void ImNodeGraphNodePool::Reserve(int capacity)
+{
+    ID.reserve(capacity);
+    Pos.reserve(capacity);
+    Size.reserve(capacity);
+    FirstPin.reserve(capacity);
+    GridRange.reserve(capacity);
+    RouteRect.reserve(capacity);
+    Depth.reserve(capacity);
+    VisibleFrame.reserve(capacity);
+    DrawOrder.reserve(capacity);
+    DrawCache.reserve(capacity);
+    TopoOrder.reserve(capacity);
+    TopoVisit.reserve(capacity);
+    Dirty.reserve(capacity);
+    ComputeCallback.reserve(capacity);
+    ComputeUserData.reserve(capacity);
+    Parent.reserve(capacity);
+    FirstChild.reserve(capacity);
+    NextSibling.reserve(capacity);
+    Collapsed.reserve(capacity);
+    Hidden.reserve(capacity);
+    GroupState.reserve(capacity);
+}
+
+void ImNodeGraphPinPool::Reserve(int capacity)
+{
+    ID.reserve(capacity);
+    Node.reserve(capacity);
+    Offset.reserve(capacity);
+    Direction.reserve(capacity);
+    Type.reserve(capacity);
+    NextPin.reserve(capacity);
+    FirstLink.reserve(capacity);
+    GridRange.reserve(capacity);
+}
+
+void ImNodeGraphLinkPool::Reserve(int capacity)
+{
+    ID.reserve(capacity);
+    StartPin.reserve(capacity);
+    EndPin.reserve(capacity);
+    NextAtStart.reserve(capacity);
+    NextAtEnd.reserve(capacity);
+    Geometry.reserve(capacity);
+    Cyclic.reserve(capacity);
+}
+
+size_t ImNodeGraphNodePool::CalcMemoryUsage() const
+{
+    size_t bytes = Slots.CalcMemoryUsage() + DrawCacheBytes + GroupStateBytes;
+    bytes += ImNodeGraphVectorBytes(ID) + ImNodeGraphVectorBytes(Pos) + ImNodeGraphVectorBytes(Size) + ImNodeGraphVectorBytes(FirstPin) + ImNodeGraphVectorBytes(GridRange) + ImNodeGraphVectorBytes(RouteRect);
+    bytes += ImNodeGraphVectorBytes(Depth) + ImNodeGraphVectorBytes(VisibleFrame) + ImNodeGraphVectorBytes(DrawOrder) + ImNodeGraphVectorBytes(DrawCache);
+    bytes += ImNodeGraphVectorBytes(TopoOrder) + ImNodeGraphVectorBytes(TopoVisit) + ImNodeGraphVectorBytes(Dirty) + ImNodeGraphVectorBytes(ComputeCallback) + ImNodeGraphVectorBytes(ComputeUserData);
+    bytes += ImNodeGraphVectorBytes(Parent) + ImNodeGraphVectorBytes(FirstChild) + ImNodeGraphVectorBytes(NextSibling) + ImNodeGraphVectorBytes(Collapsed) + ImNodeGraphVectorBytes(Hidden) + ImNodeGraphVectorBytes(GroupState);
+    return bytes;
+}
+
+size_t ImNodeGraphPinPool::CalcMemoryUsage() const
+{
+    size_t bytes = Slots.CalcMemoryUsage();
+    bytes += ImNodeGraphVectorBytes(ID) + ImNodeGraphVectorBytes(Node) + ImNodeGraphVectorBytes(Offset) + ImNodeGraphVectorBytes(Direction);
+    bytes += ImNodeGraphVectorBytes(Type) + ImNodeGraphVectorBytes(NextPin) + ImNodeGraphVectorBytes(FirstLink) + ImNodeGraphVectorBytes(GridRange);
+    return bytes;
+}
+
+size_t ImNodeGraphLinkPool::CalcMemoryUsage() const
+{
+    size_t bytes = Slots.CalcMemoryUsage();
+    bytes += ImNodeGraphVectorBytes(ID) + ImNodeGraphVectorBytes(StartPin) + ImNodeGraphVectorBytes(EndPin) + ImNodeGraphVectorBytes(NextAtStart);
+    bytes += ImNodeGraphVectorBytes(NextAtEnd) + ImNodeGraphVectorBytes(Geometry) + ImNodeGraphVectorBytes(Cyclic);
+    return bytes;
+}
+
+static inline int ImNodeGraphCountBits64(ImU64 v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Index of the lowest set bit, v must not be 0
+static inline int ImNodeGraphFindFirstBit64(ImU64 v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    if ((v & 0xFFFFFFFFULL) == 0) { n += 32; v >>= 32; }
+    if ((v & 0xFFFFULL) == 0)     { n += 16; v >>= 16; }
+    if ((v & 0xFFULL) == 0)       { n += 8;  v >>= 8; }
+    if ((v & 0xFULL) == 0)        { n += 4;  v >>= 4; }
+    if ((v & 0x3ULL) == 0)        { n += 2;  v >>= 2; }
+    return n + (int)((v & 1) == 0);
+#endif
+}
+
+int ImNodeGraphSelection::FindNext(int idx) const
+{
+    int word = idx >> 6;
+    if (word >= Bits.Size)
+        return -1;
+    ImU64 bits = Bits[word] & (~(ImU64)0 << (idx & 63));
+    while (bits == 0)
+    {
+        if (++word == Bits.Size)
+            return -1;
+        bits = Bits[word];
+    }
+    return (word << 6) + ImNodeGraphFindFirstBit64(bits);
+}
+
+void ImNodeGraphSelection::AddSlot(int idx)
+{
+    const int words = (idx >> 6) + 1;
+    if (Bits.Size < words)
+    {
+        const int old_size = Bits.Size;
+        Bits.resize(words);
+        Alive.resize(words);
+        for (int n = old_size; n < words; n++)
+            Bits[n] = Alive[n] = 0;
+    }
+    IM_ASSERT(!Test(idx));
+    Alive[idx >> 6] |= (ImU64)1 << (idx & 63);
+}
+
+void ImNodeGraphSelection::AddChange(ImGuiID id)
+{
+    if (ChangesOverflow)
+        return;
+    if (Changes.Size == IMNODEGRAPH_SELECTION_MAX_CHANGES)
+    {
+        ChangesOverflow = true;
+        Changes.resize(0);
+        return;
+    }
+    Changes.push_back(id);
+}
+
+ImNodeGraphHandle ImNodeGraph::FindNode(ImNodeGraphData* graph, ImGuiID node_id)
+{
+    return graph->NodeMap.Get(node_id);
+}
+
+ImNodeGraphHandle ImNodeGraph::FindPin(ImNodeGraphData* graph, ImGuiID pin_id)
+{
+    return graph->PinMap.Get(pin_id);
+}
+
+ImNodeGraphHandle ImNodeGraph::FindLink(ImNodeGraphData* graph, ImGuiID link_id)
+{
+    return graph->LinkMap.Get(link_id);
+}
+
+ImNodeGraphHandle ImNodeGraph::CreateNode(ImNodeGraphData* graph, ImGuiID node_id, const ImVec2& pos)
+{
+    IM_ASSERT(FindNode(graph, node_id) == 0);
+    DetachMappedColumns(graph, true);
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    const int idx = nodes.Add(node_id);
+    graph->Selection.AddSlot(idx);
+    nodes.Pos[idx] = pos;
+    nodes.Depth[idx] = ++graph->DepthCounter;
+    UpdateNodeBounds(graph, idx);
+    const ImNodeGraphHandle handle = nodes.Slots.GetHandle(idx);
+    graph->NodeMap.Set(node_id, handle);
+    if (graph->LayoutTracking)
+        MarkLayoutChanged(graph, idx);
+    if (graph->EvalActive)
+    {
+        nodes.TopoOrder[idx] = graph->TopoNodes.Size;
+        graph->TopoNodes.push_back(idx);
+        MarkDirtyDownstream(graph, idx);
+    }
+    return handle;
+}
+
+ImNodeGraphHandle ImNodeGraph::CreatePin(ImNodeGraphData* graph, ImNodeGraphHandle node, ImGuiID pin_id, ImPinDirection direction, ImPinType type)
+{
+    IM_ASSERT(FindPin(graph, pin_id) == 0 && graph->Nodes.Slots.IsAlive(node));
+    DetachMappedColumns(graph, true);
+    ImNodeGraphPinPool& pins = graph->Pins;
+    const int node_idx = ImNodeGraphHandleIndex(node);
+    const int idx = pins.Add(pin_id);
+    pins.Node[idx] = node;
+    pins.Direction[idx] = direction;
+    pins.Type[idx] = type;
+    pins.Offset[idx] = ImVec2(direction == ImPinDirection_Output ? graph->Nodes.Size[node_idx].x : 0.0f, 0.0f);
+    const ImNodeGraphHandle handle = pins.Slots.GetHandle(idx);
+
+    // Append to keep the node pins in creation order
+    ImNodeGraphHandle* next = &graph->Nodes.FirstPin[node_idx];
+    while (*next != 0)
+        next = &pins.NextPin[ImNodeGraphHandleIndex(*next)];
+    *next = handle;
+    graph->PinMap.Set(pin_id, handle);
+    UpdatePinBounds(graph, idx);
+    return handle;
+}
+
+ImNodeGraphHandle ImNodeGraph::CreateLink(ImNodeGraphData* graph, ImGuiID link_id, ImNodeGraphHandle start_pin, ImNodeGraphHandle end_pin)
+{
+    IM_ASSERT(FindLink(graph, link_id) == 0 && graph->Pins.Slots.IsAlive(start_pin) && graph->Pins.Slots.IsAlive(end_pin) && start_pin != end_pin);
+    DetachMappedColumns(graph, true);
+    ImNodeGraphLinkPool& links = graph->Links;
+    const int idx = links.Add(link_id);
+    const ImNodeGraphHandle handle = links.Slots.GetHandle(idx);
+    const int start_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(start_pin)]);
+    const int end_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(end_pin)]);
+    links.StartPin[idx] = start_pin;
+    links.EndPin[idx] = end_pin;
+    links.NextAtStart[idx] = graph->Pins.FirstLink[ImNodeGraphHandleIndex(start_pin)];
+    links.NextAtEnd[idx] = graph->Pins.FirstLink[ImNodeGraphHandleIndex(end_pin)];
+    graph->Pins.FirstLink[ImNodeGraphHandleIndex(start_pin)] = handle;
+    graph->Pins.FirstLink[ImNodeGraphHandleIndex(end_pin)] = handle;
+    graph->LinkMap.Set(link_id, handle);
+    graph->DragLinkCycleNode = -1;
+    UpdateLinkGeometry(graph, idx);
+
+    // Links leaving a collapsed group are part of its boundary
+    const int start_group_idx = GetVisibleAncestor(graph, start_node_idx);
+    const int end_group_idx = GetVisibleAncestor(graph, end_node_idx);
+    if (start_group_idx != end_group_idx && start_group_idx != start_node_idx)
+        AddGroupBoundaryLink(graph, start_group_idx, handle);
+    if (start_group_idx != end_group_idx && end_group_idx != end_node_idx)
+        AddGroupBoundaryLink(graph, end_group_idx, handle);
+    if (graph->DragGroupPending && graph->Selection.Test(start_node_idx) != graph->Selection.Test(end_node_idx))
+        graph->DragBoundaryLinks.push_back(handle);
+    if (graph->LayoutTracking)
+    {
+        MarkLayoutChanged(graph, start_node_idx);
+        MarkLayoutChanged(graph, end_node_idx);
+    }
+    if (graph->EvalActive)
+    {
+        if (AddTopologicalEdge(graph, start_node_idx, end_node_idx))
+            MarkDirtyDownstream(graph, end_node_idx);
+        else
+        {
+            links.Cyclic[idx] = true;
+            graph->CyclicLinks.push_back(idx);
+        }
+    }
+    return handle;
+}
+
+// A link sits in the lists of both of its pins, follow the next field matching the pin we walk
+static ImNodeGraphHandle* GetLinkNextAtPin(ImNodeGraphLinkPool& links, ImNodeGraphHandle link, ImNodeGraphHandle pin)
+{
+    const int idx = ImNodeGraphHandleIndex(link);
+    return (links.StartPin[idx] == pin) ? &links.NextAtStart[idx] : &links.NextAtEnd[idx];
+}
+
+static void UnlinkFromPin(ImNodeGraphData* graph, ImNodeGraphHandle pin, ImNodeGraphHandle link)
+{
+    ImNodeGraphHandle* next = &graph->Pins.FirstLink[ImNodeGraphHandleIndex(pin)];
+    while (*next != 0 && *next != link)
+        next = GetLinkNextAtPin(graph->Links, *next, pin);
+    IM_ASSERT(*next == link);
+    *next = *GetLinkNextAtPin(graph->Links, link, pin);
+}
+
+void ImNodeGraph::DestroyLink(ImNodeGraphData* graph, ImNodeGraphHandle link)
+{
+    ImNodeGraphLinkPool& links = graph->Links;
+    if (!links.Slots.IsAlive(link))
+        return;
+    const int idx = ImNodeGraphHandleIndex(link);
+    if (graph->LayoutTracking)
+    {
+        MarkLayoutChanged(graph, ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.StartPin[idx])]));
+        MarkLayoutChanged(graph, ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.EndPin[idx])]));
+    }
+    UnlinkFromPin(graph, links.StartPin[idx], link);
+    UnlinkFromPin(graph, links.EndPin[idx], link);
+    graph->LinkPointsUnused += links.Geometry[idx].PointsCapacity;
+    graph->LinkGrid.Remove(idx, &links.Geometry[idx].GridRange);
+    graph->LinkMap.Remove(links.ID[idx]);
+    graph->DragLinkCycleNode = -1;
+    const bool was_cyclic = links.Cyclic[idx];
+    const int end_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.EndPin[idx])]);
+    links.Remove(idx);
+    if (!graph->EvalActive)
+        return;
+    if (was_cyclic)
+    {
+        graph->CyclicLinks.find_erase_unsorted(idx);
+        return;
+    }
+    MarkDirtyDownstream(graph, end_node_idx);
+
+    // Removing a link may have broken a cycle, give the links which closed one another chance
+    for (int n = graph->CyclicLinks.Size - 1; n >= 0; n--)
+    {
+        const int link_idx = graph->CyclicLinks[n];
+        const int start_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.StartPin[link_idx])]);
+        const int cyclic_end_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.EndPin[link_idx])]);
+        if (AddTopologicalEdge(graph, start_node_idx, cyclic_end_node_idx))
+        {
+            links.Cyclic[link_idx] = false;
+            graph->CyclicLinks.erase_unsorted(graph->CyclicLinks.Data + n);
+            MarkDirtyDownstream(graph, cyclic_end_node_idx);
+        }
+    }
+}
+
+void ImNodeGraph::DestroyPin(ImNodeGraphData* graph, ImNodeGraphHandle pin)
+{
+    ImNodeGraphPinPool& pins = graph->Pins;
+    if (!pins.Slots.IsAlive(pin))
+        return;
+    const int idx = ImNodeGraphHandleIndex(pin);
+    while (pins.FirstLink[idx] != 0)
+        DestroyLink(graph, pins.FirstLink[idx]);
+
+    ImNodeGraphHandle* next = &graph->Nodes.FirstPin[ImNodeGraphHandleIndex(pins.Node[idx])];
+    while (*next != 0 && *next != pin)
+        next = &pins.NextPin[ImNodeGraphHandleIndex(*next)];
+    IM_ASSERT(*next == pin);
+    *next = pins.NextPin[idx];
+    graph->PinGrid.Remove(idx, &pins.GridRange[idx]);
+    graph->PinMap.Remove(pins.ID[idx]);
+    pins.Remove(idx);
+}
+
+void ImNodeGraph::DestroyNode(ImNodeGraphData* graph, ImNodeGraphHandle node)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    if (!nodes.Slots.IsAlive(node))
+        return;
+    const int idx = ImNodeGraphHandleIndex(node);
+    if (nodes.FirstChild[idx] != 0)
+    {
+        // Nodes of a removed group go to the group it was in
+        CollapseGroup(graph, idx, false);
+        const int parent_idx = nodes.Parent[idx] ? ImNodeGraphHandleIndex(nodes.Parent[idx]) : -1;
+        while (nodes.FirstChild[idx] != 0)
+            MoveNodeToGroup(graph, ImNodeGraphHandleIndex(nodes.FirstChild[idx]), parent_idx);
+    }
+    UnlinkFromGroup(graph, idx);
+    if (nodes.Hidden[idx])
+        nodes.HiddenCount--;
+    while (nodes.FirstPin[idx] != 0)
+        DestroyPin(graph, nodes.FirstPin[idx]);
+    UpdateMinimapCell(graph, nodes.GridRange[idx], ImNodeGraphGridRange());
+    graph->NodeGrid.Remove(idx, &nodes.GridRange[idx]);
+    if (graph->Flags & ImNodeGraphFlags_OrthogonalLinks)
+        InvalidateLinkRoutes(graph, nodes.RouteRect[idx]);
+    graph->NodeMap.Remove(nodes.ID[idx]);
+    if (graph->EvalActive)
+    {
+        graph->TopoNodes[nodes.TopoOrder[idx]] = -1;
+        graph->TopoHoles++;
+    }
+    SetNodeSelected(graph, idx, false);
+    graph->Selection.RemoveSlot(idx);
+    nodes.Remove(idx);
+}
+
+void ImNodeGraph::UpdateNodeBounds(ImNodeGraphData* graph, int node_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    if (nodes.Hidden[node_idx])
+        return; // Registered again when its group is expanded, links leaving it only depend on the group
+    const ImRect rect = nodes.GetRect(node_idx);
+    const ImNodeGraphGridRange old_range = nodes.GridRange[node_idx];
+    graph->NodeGrid.Update(node_idx, &nodes.GridRange[node_idx], rect);
+    UpdateMinimapCell(graph, old_range, nodes.GridRange[node_idx]);
+    if ((graph->Flags & ImNodeGraphFlags_OrthogonalLinks) && (rect.Min != nodes.RouteRect[node_idx].Min || rect.Max != nodes.RouteRect[node_idx].Max))
+    {
+        // Routes went around the old rectangle and may cross the new one
+        InvalidateLinkRoutes(graph, nodes.RouteRect[node_idx]);
+        InvalidateLinkRoutes(graph, rect);
+        nodes.RouteRect[node_idx] = rect;
+    }
+    for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = graph->Pins.NextPin[ImNodeGraphHandleIndex(pin)])
+        UpdatePinBounds(graph, ImNodeGraphHandleIndex(pin));
+    if (const ImNodeGraphGroupState* group = nodes.GroupState[node_idx])
+        for (int n = 0; n < group->BoundaryLinks.Size; n++)
+            if (graph->Links.Slots.IsAlive(group->BoundaryLinks[n]))
+                UpdateLinkGeometry(graph, ImNodeGraphHandleIndex(group->BoundaryLinks[n]));
+}
+
+// Registered at the stored node position, which a pending drag offset isn't part of. Pins of hidden nodes are not.
+void ImNodeGraph::UpdatePinBounds(ImNodeGraphData* graph, int pin_idx)
+{
+    ImNodeGraphPinPool& pins = graph->Pins;
+    const int node_idx = ImNodeGraphHandleIndex(pins.Node[pin_idx]);
+    const ImVec2 pos = graph->Nodes.Pos[node_idx] + pins.Offset[pin_idx];
+    if (!graph->Nodes.Hidden[node_idx])
+        graph->PinGrid.Update(pin_idx, &pins.GridRange[pin_idx], ImRect(pos, pos));
+    const ImNodeGraphHandle pin = pins.Slots.GetHandle(pin_idx);
+    for (ImNodeGraphHandle link = pins.FirstLink[pin_idx]; link != 0; link = *GetLinkNextAtPin(graph->Links, link, pin))
+        UpdateLinkGeometry(graph, ImNodeGraphHandleIndex(link));
+}
+
+ImVec2 ImNodeGraph::GetPinCanvasPos(ImNodeGraphData* graph, int pin_idx)
+{
+    const int node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[pin_idx]);
+    if (graph->Nodes.Hidden[node_idx])
+        return GetGroupBoundaryPinPos(graph, GetVisibleAncestor(graph, node_idx), graph->Pins.Direction[pin_idx]);
+    return graph->GetNodeDisplayPos(node_idx) + graph->Pins.Offset[pin_idx];
+}
+
+void ImNodeGraph::GetLinkBezier(const ImVec2& start, const ImVec2& end, ImVec2 out_points[4])
+{
+    const float tangent = ImMax(ImFabs(end.x - start.x) * 0.5f, 40.0f);
+    out_points[0] = start;
+    out_points[1] = start + ImVec2(tangent, 0.0f);
+    out_points[2] = end - ImVec2(tangent, 0.0f);
+    out_points[3] = end;
+}
+
+void ImNodeGraph::UpdateLinkGeometry(ImNodeGraphData* graph, int link_idx)
+{
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+    const int start_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.StartPin[link_idx])]);
+    const int end_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.EndPin[link_idx])]);
+    if (graph->Nodes.Hidden[start_node_idx] && graph->Nodes.Hidden[end_node_idx] && GetVisibleAncestor(graph, start_node_idx) == GetVisibleAncestor(graph, end_node_idx))
+    {
+        // Both ends in the same collapsed group: out of the spatial index, built again once the group is expanded
+        graph->LinkGrid.Remove(link_idx, &geom.GridRange);
+        graph->LinkPointsUnused += geom.PointsCapacity;
+        geom.Start = geom.End = ImVec2(FLT_MAX, FLT_MAX);
+        geom.Segments = geom.PointsCapacity = 0;
+        geom.RouteStale = false;
+        geom.RouteVersion++;
+        return;
+    }
+    ImVec2 start = GetPinCanvasPos(graph, ImNodeGraphHandleIndex(links.StartPin[link_idx]));
+    ImVec2 end = GetPinCanvasPos(graph, ImNodeGraphHandleIndex(links.EndPin[link_idx]));
+    if (graph->IsLinkInDragGroup(link_idx))
+    {
+        // Stored where the drag started, the whole link is displayed moved by the offset
+        start -= graph->DragGroupOffset;
+        end -= graph->DragGroupOffset;
+    }
+    if (start == geom.Start && end == geom.End)
+        return;
+
+    geom.Start = start;
+    geom.End = end;
+    geom.Segments = 0;
+    if (graph->Flags & ImNodeGraphFlags_OrthogonalLinks)
+    {
+        // Placeholder bounds around both stubs until the link is routed
+        const float margin = GImNodeGraph->Style.LinkRouteMargin;
+        geom.Bounds = ImRect(ImMin(start, end) - ImVec2(margin, margin), ImMax(start, end) + ImVec2(margin, margin));
+        geom.Length = 0.0f;
+        geom.RouteStale = true;
+        geom.RouteVersion++;
+    }
+    else
+    {
+        ImVec2 p[4];
+        GetLinkBezier(start, end, p);
+        geom.Bounds = ImRect(ImMin(ImMin(p[0], p[1]), ImMin(p[2], p[3])), ImMax(ImMax(p[0], p[1]), ImMax(p[2], p[3])));
+        geom.Length = ImSqrt(ImLengthSqr(p[1] - p[0])) + ImSqrt(ImLengthSqr(p[2] - p[1])) + ImSqrt(ImLengthSqr(p[3] - p[2]));
+    }
+    graph->LinkGrid.Update(link_idx, &geom.GridRange, geom.Bounds);
+}
+
+// Ranges are released lazily, repack every live range once most of the buffer is unused
+static void CompactLinkPoints(ImNodeGraphData* graph)
+{
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImVector<ImVec2> points;
+    points.reserve(graph->LinkPoints.Size - graph->LinkPointsUnused);
+    for (int link_idx = 0; link_idx < links.Slots.GetSize(); link_idx++)
+    {
+        ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+        if (!links.Slots.IsSlotAlive(link_idx) || geom.PointsCapacity == 0)
+            continue;
+        points.resize(points.Size + geom.PointsCapacity);
+        memcpy(&points[points.Size - geom.PointsCapacity], &graph->LinkPoints[geom.PointsOffset], (size_t)geom.PointsCapacity * sizeof(ImVec2));
+        geom.PointsOffset = points.Size - geom.PointsCapacity;
+    }
+    graph->LinkPoints.swap(points);
+    graph->LinkPointsUnused = 0;
+}
+
+ImVec2* ImNodeGraph::AllocLinkPoints(ImNodeGraphData* graph, int link_idx, int count)
+{
+    ImNodeGraphLinkGeometry& geom = graph->Links.Geometry[link_idx];
+    if (count > geom.PointsCapacity)
+    {
+        if (graph->LinkPointsUnused > 4096 && graph->LinkPointsUnused * 2 > graph->LinkPoints.Size)
+            CompactLinkPoints(graph);
+        graph->LinkPointsUnused += geom.PointsCapacity;
+        geom.PointsCapacity = count;
+        geom.PointsOffset = graph->LinkPoints.Size;
+        graph->LinkPoints.resize(graph->LinkPoints.Size + geom.PointsCapacity);
+    }
+    return &graph->LinkPoints[geom.PointsOffset];
+}
+
+void ImNodeGraph::TessellateLink(ImNodeGraphData* graph, int link_idx, int segments)
+{
+    ImNodeGraphLinkGeometry& geom = graph->Links.Geometry[link_idx];
+    ImVec2 p[4];
+    GetLinkBezier(geom.Start, geom.End, p);
+    ImVec2* out = AllocLinkPoints(graph, link_idx, segments + 1);
+    const float t_step = 1.0f / (float)segments;
+    for (int n = 0; n <= segments; n++)
+        out[n] = ImBezierCubicCalc(p[0], p[1], p[2], p[3], t_step * n);
+    geom.Segments = segments;
+}
+
+void ImNodeGraph::AddNode(ImGuiID node_id, const ImVec2& pos)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "AddNode() must be called between BeginGraph() and EndGraph()");
+    if (FindNode(graph, node_id) != 0)
+    {
+        SetNodePos(node_id, pos);
+        return;
+    }
+    CreateNode(graph, node_id, pos);
+    if (graph->Undo.IsRecording())
+    {
+        BeginUndoRecord(graph);
+        graph->Undo.Put(&node_id, sizeof(ImGuiID));
+        graph->Undo.Put(&pos, sizeof(ImVec2));
+        EndUndoRecord(graph, ImNodeGraphUndoType_NodeCreated);
+    }
+}
+
+void ImNodeGraph::RemoveNode(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    const ImNodeGraphHandle node = FindNode(graph, node_id);
+    if (node != 0)
+        CommitDragGroup(graph);
+    if (node != 0 && graph->Undo.IsRecording())
+        RecordNodeDeleted(graph, ImNodeGraphHandleIndex(node));
+    DestroyNode(graph, node);
+}
+
+void ImNodeGraph::SetNodePos(ImGuiID node_id, const ImVec2& pos)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    if (node == 0)
+        return;
+    CommitDragGroup(graph);
+    const int node_idx = ImNodeGraphHandleIndex(node);
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    if (undo.IsRecording() && graph->Nodes.Pos[node_idx] != pos)
+    {
+        if (undo.MergeRecord != ~(ImU64)0 && undo.MergeNodeID == node_id)
+        {
+            // Moved again within the same group: only the destination changes
+            undo.Write(undo.MergeRecord + IMNODEGRAPH_UNDO_HEADER_SIZE + sizeof(ImGuiID) + sizeof(ImVec2), &pos, sizeof(ImVec2));
+        }
+        else
+        {
+            BeginUndoRecord(graph);
+            undo.Put(&node_id, sizeof(ImGuiID));
+            undo.Put(&graph->Nodes.Pos[node_idx], sizeof(ImVec2));
+            undo.Put(&pos, sizeof(ImVec2));
+            EndUndoRecord(graph, ImNodeGraphUndoType_NodeMoved);
+            if (undo.GroupDepth > 0 && undo.End > undo.Begin)
+            {
+                undo.MergeRecord = undo.End - undo.Scratch.Size;
+                undo.MergeNodeID = node_id;
+            }
+        }
+    }
+    graph->Nodes.Pos[node_idx] = pos;
+    UpdateNodeBounds(graph, node_idx);
+}
+
+ImVec2 ImNodeGraph::GetNodePos(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    return node ? graph->GetNodeDisplayPos(ImNodeGraphHandleIndex(node)) : ImVec2(0.0f, 0.0f);
+}
+
+ImVec2 ImNodeGraph::GetNodeSize(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    return node ? graph->Nodes.Size[ImNodeGraphHandleIndex(node)] : ImVec2(0.0f, 0.0f);
+}
+
+void ImNodeGraph::ReserveGraph(int node_count, int pin_count, int link_count)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "ReserveGraph() must be called between BeginGraph() and EndGraph()");
+    DetachMappedColumns(graph, true);
+    graph->Nodes.Reserve(node_count);
+    graph->Pins.Reserve(pin_count);
+    graph->Links.Reserve(link_count);
+    graph->NodeMap.Reserve(node_count);
+    graph->PinMap.Reserve(pin_count);
+    graph->LinkMap.Reserve(link_count);
+}
+
+void ImNodeGraph::AddPin(ImGuiID node_id, ImGuiID pin_id, ImPinDirection direction, ImPinType type)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "AddPin() must be called between BeginGraph() and EndGraph()");
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    IM_ASSERT(node != 0 && "AddPin() target node doesn't exist");
+    if (node == 0 || FindPin(graph, pin_id) != 0)
+        return;
+    CreatePin(graph, node, pin_id, direction, type);
+    if (graph->Undo.IsRecording())
+    {
+        BeginUndoRecord(graph);
+        graph->Undo.Put(&pin_id, sizeof(ImGuiID));
+        graph->Undo.Put(&node_id, sizeof(ImGuiID));
+        graph->Undo.Put(&direction, sizeof(ImPinDirection));
+        graph->Undo.Put(&type, sizeof(ImPinType));
+        EndUndoRecord(graph, ImNodeGraphUndoType_PinCreated);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Graph
+//-----------------------------------------------------------------------------
+
+static int IMGUI_CDECL SortU64Comparer(const void* lhs, const void* rhs)
+{
+    const ImU64 a = *(const ImU64*)lhs;
+    const ImU64 b = *(const ImU64*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+// Elements which may be displayed over 'bb'. While a drag group is pending, the selected nodes, their pins and the
+// links between them are still registered where the drag started, they are looked up around 'bb' moved back as well.
+static void QueryDisplayedItems(ImNodeGraphData* graph, ImNodeGraphSpatialGrid& grid, const ImRect& bb, ImNodeGraphArenaVector<int>* out_items)
+{
+    grid.Query(bb, out_items);
+    if (graph->DragGroupPending)
+        grid.QueryMore(ImRect(bb.Min - graph->DragGroupOffset, bb.Max - graph->DragGroupOffset), out_items);
+}
+
+void ImNodeGraph::DrawGrid(ImNodeGraphData* graph, ImDrawList* draw_list)
+{
+    ImNodeGraphStyle& style = GImNodeGraph->Style;
+    draw_list->AddRectFilled(graph->ScreenRect.Min, graph->ScreenRect.Max, style.Colors[ImNodeGraphCol_GridBg]);
+    if (graph->Flags & ImNodeGraphFlags_NoGrid)
+        return;
+
+    // Skip levels of lines until they are at least a few pixels apart
+    float spacing = style.GridSpacing * graph->Zoom;
+    while (spacing < 8.0f)
+        spacing *= 4.0f;
+    const ImVec2 origin = graph->ScreenRect.Min + graph->Pan;
+    const ImU32 col = style.Colors[ImNodeGraphCol_GridLine];
+    for (float x = fmodf(origin.x - graph->ScreenRect.Min.x, spacing); x < graph->ScreenRect.GetWidth(); x += spacing)
+        draw_list->AddLine(ImVec2(graph->ScreenRect.Min.x + x, graph->ScreenRect.Min.y), ImVec2(graph->ScreenRect.Min.x + x, graph->ScreenRect.Max.y), col);
+    for (float y = fmodf(origin.y - graph->ScreenRect.Min.y, spacing); y < graph->ScreenRect.GetHeight(); y += spacing)
+        draw_list->AddLine(ImVec2(graph->ScreenRect.Min.x, graph->ScreenRect.Min.y + y), ImVec2(graph->ScreenRect.Max.x, graph->ScreenRect.Min.y + y), col);
+}
+
+// Collect the nodes overlapping the canvas view from the spatial index, sorted back to front
+void ImNodeGraph::UpdateVisibleNodes(ImNodeGraphData* graph)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateVisibleNodes");
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    graph->VisibleNodes.resize(0);
+    if (graph->Lod == ImNodeGraphLod_Density)
+    {
+        // Nodes are not visited at all, DrawReducedNodes() shades the occupied cells instead
+        graph->Stats.NodesCulled = nodes.Slots.AliveCount;
+        return;
+    }
+    if (graph->Flags & ImNodeGraphFlags_NoCulling)
+    {
+        for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+            if (nodes.Slots.IsSlotAlive(node_idx) && !nodes.Hidden[node_idx])
+                graph->VisibleNodes.push_back(node_idx);
+    }
+    else
+    {
+        // Pins stick out of the node rectangle, account for them in the view rectangle
+        const float margin = GImNodeGraph->Style.PinHoverRadius;
+        ImRect view(graph->ScreenToCanvas(graph->ScreenRect.Min), graph->ScreenToCanvas(graph->ScreenRect.Max));
+        view.Expand(margin);
+        QueryDisplayedItems(graph, graph->NodeGrid, view, &graph->VisibleNodes);
+
+        // Cells are coarse, keep the nodes which actually overlap the view
+        int visible_count = 0;
+        for (int n = 0; n < graph->VisibleNodes.Size; n++)
+        {
+            const int node_idx = graph->VisibleNodes[n];
+            ImRect bb = graph->GetNodeDisplayRect(node_idx);
+            bb.Max += ImVec2(1.0f, 1.0f); // Nodes which were never measured have no size yet
+            if (bb.Overlaps(view))
+                graph->VisibleNodes[visible_count++] = node_idx;
+        }
+        graph->VisibleNodes.resize(visible_count);
+    }
+
+    graph->SortBuffer.resize(graph->VisibleNodes.Size);
+    for (int n = 0; n < graph->VisibleNodes.Size; n++)
+        graph->SortBuffer[n] = ((ImU64)nodes.Depth[graph->VisibleNodes[n]] << 32) | (ImU32)graph->VisibleNodes[n];
+    if (graph->SortBuffer.Size > 1)
+        ImQsort(graph->SortBuffer.Data, (size_t)graph->SortBuffer.Size, sizeof(ImU64), SortU64Comparer);
+    for (int n = 0; n < graph->SortBuffer.Size; n++)
+    {
+        const int node_idx = (int)(graph->SortBuffer[n] & 0xFFFFFFFF);
+        nodes.VisibleFrame[node_idx] = graph->Frame;
+        nodes.DrawOrder[node_idx] = (graph->Lod == ImNodeGraphLod_Full) ? n : -1;
+        graph->VisibleNodes[n] = node_idx;
+    }
+    graph->Stats.NodesVisible = graph->VisibleNodes.Size;
+    graph->Stats.NodesCulled = nodes.Slots.AliveCount - graph->VisibleNodes.Size;
+}
+
+// Collect the links overlapping the canvas view from the spatial index, re-tessellating the ones whose shape or
+// on-screen length changed. Runs in EndGraph() so pin offsets measured while submitting nodes this frame are in.
+// Routed links keep their points at every zoom level, the stale ones are sent to UpdateLinkRoutes().
+void ImNodeGraph::UpdateVisibleLinks(ImNodeGraphData* graph)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateVisibleLinks");
+    ImNodeGraphStyle& style = GImNodeGraph->Style;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImRect view(graph->ScreenToCanvas(graph->ScreenRect.Min), graph->ScreenToCanvas(graph->ScreenRect.Max));
+    view.Expand(style.LinkThickness / graph->Zoom);
+
+    // Segment count follows the on-screen length of the control polygon
+    const float segments_per_unit = graph->Zoom / ImMax(style.LinkSegmentLength, 1.0f);
+    const bool routed = (graph->Flags & ImNodeGraphFlags_OrthogonalLinks) != 0;
+    graph->VisibleLinks.resize(0);
+    graph->StaleRoutes.resize(0);
+    if (graph->Lod == ImNodeGraphLod_Density)
+        return;
+    if (graph->Flags & ImNodeGraphFlags_NoCulling)
+    {
+        // Links inside a collapsed group are the ones out of the spatial index
+        for (int link_idx = 0; link_idx < links.Slots.GetSize(); link_idx++)
+            if (links.Slots.IsSlotAlive(link_idx) && !links.Geometry[link_idx].GridRange.IsEmpty())
+                graph->VisibleLinks.push_back(link_idx);
+    }
+    else
+    {
+        QueryDisplayedItems(graph, graph->LinkGrid, view, &graph->VisibleLinks);
+    }
+
+    int visible_count = 0;
+    int moved_count = 0;
+    for (int n = 0; n < graph->VisibleLinks.Size; n++)
+    {
+        const int link_idx = graph->VisibleLinks[n];
+        const ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+        ImRect bounds = geom.Bounds;
+        if (graph->IsLinkInDragGroup(link_idx))
+            bounds.Translate(graph->DragGroupOffset);
+        if (!bounds.Overlaps(view) && !(graph->Flags & ImNodeGraphFlags_NoCulling))
+            continue;
+        if (routed)
+        {
+            // Elbow until the route comes in, so the link doesn't disappear meanwhile. Links whose pins moved are the
+            // furthest off, they get routed first.
+            const bool pins_moved = (geom.Segments == 0);
+            if (pins_moved)
+            {
+                ImVec2 elbow[6];
+                SetLinkRoute(graph, link_idx, elbow, BuildElbowRoute(geom.Start, geom.End, style.LinkRouteMargin, elbow));
+            }
+            if (geom.RouteStale)
+            {
+                graph->StaleRoutes.push_back(link_idx);
+                if (pins_moved)
+                    ImSwap(graph->StaleRoutes.back(), graph->StaleRoutes[moved_count++]);
+            }
+        }
+        else
+        {
+            const int segments = ImClamp((int)ceilf(geom.Length * segments_per_unit), 2, IMNODEGRAPH_LINK_MAX_SEGMENTS);
+            if (segments != geom.Segments)
+            {
+                TessellateLink(graph, link_idx, segments);
+                graph->Stats.LinksTessellated++;
+            }
+        }
+        graph->VisibleLinks[visible_count++] = link_idx;
+    }
+    graph->VisibleLinks.resize(visible_count);
+    if (routed)
+        UpdateLinkRoutes(graph);
+    graph->Stats.LinksVisible = visible_count;
+    graph->Stats.LinkCacheHits = ImMax(visible_count - graph->Stats.LinksTessellated, 0);
+}
+
+// Text inside the canvas scales with the zoom. Dear ImGui 1.92 made SetWindowFontScale() obsolete and renders
+// fonts at any size, older versions scale the atlas glyphs.
+static void PushZoomedFont(float zoom)
+{
+#if IMGUI_VERSION_NUM >= 19200
+    ImGui::PushFont(NULL, GImGui->FontSizeBase * zoom);
+#else
+    ImGui::SetWindowFontScale(zoom);
+#endif
+}
+
+static void PopZoomedFont()
+{
+#if IMGUI_VERSION_NUM >= 19200
+    ImGui::PopFont();
+#else
+    ImGui::SetWindowFontScale(1.0f);
+#endif
+}
+
+void ImNodeGraph::BeginGraph(const char* title, const ImVec2& size, ImNodeGraphFlags flags)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    IM_ASSERT(g.CurrentGraph == NULL && "Missing EndGraph() or nested BeginGraph()");
+
+    // Events of the previous frames are complete, stream them out before timing this one
+    if (g.TraceFile != NULL)
+        FlushTraceEvents(&g);
+    IMNODEGRAPH_PROFILE_ZONE("BeginGraph");
+    g.FrameArena.Reset();
+
+    const ImGuiID id = ImGui::GetID(title);
+    ImNodeGraphData* graph = g.Graphs.GetOrAddByKey(id);
+    graph->ID = id;
+    const bool routing_changed = ((graph->Flags ^ flags) & ImNodeGraphFlags_OrthogonalLinks) != 0;
+    graph->Flags = flags;
+    if (routing_changed)
+        ResetLinkRoutes(graph);
+    graph->Frame++;
+    graph->LinkCreated = false;
+    graph->Selection.Changes.resize(0);
+    graph->Selection.ChangesOverflow = false;
+    graph->Stats = ImNodeGraphFrameStats();
+    graph->MemoryUsageAtBegin = CalcGraphMemoryUsage(graph);
+    g.CurrentGraph = g.LastGraph = graph;
+
+    ImGui::BeginChild(title, size, ImGuiChildFlags_None, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoMove);
+    const ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+    graph->ScreenRect = ImRect(ImGui::GetCursorScreenPos(), ImGui::GetCursorScreenPos() + canvas_size);
+
+    // The canvas is a single item behind the nodes, it allows overlap so node widgets keep working
+    ImGui::SetNextItemAllowOverlap();
+    ImGui::InvisibleButton("##canvas", ImMax(canvas_size, ImVec2(1.0f, 1.0f)), ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight | ImGuiButtonFlags_MouseButtonMiddle);
+    graph->CanvasItemID = ImGui::GetItemID();
+    graph->CanvasHovered = ImGui::IsItemHovered();
+    graph->CanvasClicked = graph->CanvasHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left);
+
+    // Pan and zoom before culling so the visible set matches what gets drawn this frame
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsItemActive() && (ImGui::IsMouseDragging(ImGuiMouseButton_Right, 0.0f) || ImGui::IsMouseDragging(ImGuiMouseButton_Middle, 0.0f)))
+        graph->Pan += io.MouseDelta;
+    if (graph->CanvasHovered && io.MouseWheel != 0.0f)
+    {
+        const ImVec2 mouse_canvas = graph->ScreenToCanvas(io.MousePos);
+        graph->Zoom = ImClamp(graph->Zoom * ImPow(1.1f, io.MouseWheel), g.Style.ZoomMin, g.Style.ZoomMax);
+        graph->Pan = io.MousePos - graph->ScreenRect.Min - mouse_canvas * graph->Zoom;
+    }
+    PushZoomedFont(graph->Zoom);
+    UpdateTextCache(graph);
+    UpdateLayout(graph);
+
+    graph->Lod = ImNodeGraphLod_Full;
+    if (!(flags & ImNodeGraphFlags_NoLod))
+    {
+        if (graph->Zoom < g.Style.LodDensityZoom)
+            graph->Lod = ImNodeGraphLod_Density;
+        else if (graph->Zoom < g.Style.LodBoxZoom)
+            graph->Lod = ImNodeGraphLod_Box;
+        else if (graph->Zoom < g.Style.LodSimpleZoom)
+            graph->Lod = ImNodeGraphLod_Simple;
+    }
+    UpdateVisibleNodes(graph);
+    graph->NodeDraws.resize(0);
+    graph->NodeDrawSlots.resize((graph->Lod == ImNodeGraphLod_Full) ? graph->VisibleNodes.Size : 0);
+    if (graph->NodeDrawSlots.Size > 0)
+        memset(graph->NodeDrawSlots.Data, 0xFF, (size_t)graph->NodeDrawSlots.Size * sizeof(int));
+
+    // A fixed number of channels whatever the number of nodes, see ImNodeGraphDrawLayer_
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    graph->VtxCountAtBegin = draw_list->VtxBuffer.Size;
+    graph->IdxCountAtBegin = draw_list->IdxBuffer.Size;
+    graph->CmdCountAtBegin = draw_list->CmdBuffer.Size;
+    graph->Splitter.Split(draw_list, ImNodeGraphDrawLayer_COUNT);
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Links);
+    DrawGrid(graph, draw_list);
+
+    // Spans the application code submitting nodes, up to EndGraph()
+    graph->NodesZone = BeginProfileZone("Nodes");
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Interaction
+//-----------------------------------------------------------------------------
+
+bool ImNodeGraph::ArePinsCompatible(ImNodeGraphData* graph, int pin_a, int pin_b)
+{
+    const ImNodeGraphPinPool& pins = graph->Pins;
+    if (pin_a == pin_b || pins.Node[pin_a] == pins.Node[pin_b] || pins.Direction[pin_a] == pins.Direction[pin_b])
+        return false;
+    const ImPinType from = pins.Type[(pins.Direction[pin_a] == ImPinDirection_Output) ? pin_a : pin_b];
+    const ImPinType to = pins.Type[(pins.Direction[pin_a] == ImPinDirection_Output) ? pin_b : pin_a];
+    const ImVector<ImU64>& rows = GImNodeGraph->PinTypeRows;
+    if ((unsigned)from < (unsigned)rows.Size && (unsigned)to < 64)
+        return ((rows.Data[from] >> to) & 1) != 0;
+    return from == to;
+}
+
+// Hovering many pins of the same node costs a single test, which is O(1) unless the link goes against the order
+bool ImNodeGraph::IsLinkDragCyclic(ImNodeGraphData* graph, int start_pin_idx, int target_pin_idx)
+{
+    const ImNodeGraphPinPool& pins = graph->Pins;
+    const int start_node_idx = ImNodeGraphHandleIndex(pins.Node[start_pin_idx]);
+    const int target_node_idx = ImNodeGraphHandleIndex(pins.Node[target_pin_idx]);
+    if (graph->DragLinkCycleNode != target_node_idx)
+    {
+        if (!graph->EvalActive)
+            ActivateEvaluation(graph);
+        const bool start_is_output = (pins.Direction[start_pin_idx] == ImPinDirection_Output);
+        graph->DragLinkCycleNode = target_node_idx;
+        graph->DragLinkCyclic = start_is_output ? WouldCloseCycle(graph, start_node_idx, target_node_idx) : WouldCloseCycle(graph, target_node_idx, start_node_idx);
+    }
+    return graph->DragLinkCyclic;
+}
+
+ImNodeGraphHandle ImNodeGraph::FindNearestCompatiblePin(ImNodeGraphData* graph, int pin_idx, const ImVec2& pos, float max_dist)
+{
+    ImNodeGraphPinPool& pins = graph->Pins;
+    graph->QueryBuffer.resize(0);
+    QueryDisplayedItems(graph, graph->PinGrid, ImRect(pos - ImVec2(max_dist, max_dist), pos + ImVec2(max_dist, max_dist)), &graph->QueryBuffer);
+    graph->Stats.HitTests += graph->QueryBuffer.Size;
+    ImNodeGraphHandle best = 0;
+    float best_dist_sq = max_dist * max_dist;
+    for (int n = 0; n < graph->QueryBuffer.Size; n++)
+    {
+        const int other_idx = graph->QueryBuffer[n];
+        if (graph->Nodes.VisibleFrame[ImNodeGraphHandleIndex(pins.Node[other_idx])] != graph->Frame || !ArePinsCompatible(graph, pin_idx, other_idx))
+            continue;
+        const float dist_sq = ImLengthSqr(GetPinCanvasPos(graph, other_idx) - pos);
+        if (dist_sq <= best_dist_sq)
+        {
+            best = pins.Slots.GetHandle(other_idx);
+            best_dist_sq = dist_sq;
+        }
+    }
+    return best;
+}
+
+// Every test queries the spatial index around the mouse, the cost doesn't depend on the number of visible elements
+void ImNodeGraph::UpdateHovered(ImNodeGraphData* graph)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateHovered");
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphArenaVector<int>& candidates = graph->QueryBuffer;
+    graph->HoveredNode = graph->HoveredPin = graph->HoveredLink = 0;
+    if (!graph->CanvasHovered && graph->Interaction == ImNodeGraphInteraction_None)
+        return;
+
+    // Pins first as they overlap the node edges, the pin of the topmost node wins
+    const ImVec2 mouse = graph->ScreenToCanvas(ImGui::GetIO().MousePos);
+    const float pin_radius = g.Style.PinHoverRadius / graph->Zoom;
+    candidates.resize(0);
+    QueryDisplayedItems(graph, graph->PinGrid, ImRect(mouse - ImVec2(pin_radius, pin_radius), mouse + ImVec2(pin_radius, pin_radius)), &candidates);
+    graph->Stats.HitTests += candidates.Size;
+    ImU32 best_depth = 0;
+    float best_dist_sq = pin_radius * pin_radius;
+    for (int n = 0; n < candidates.Size; n++)
+    {
+        const int pin_idx = candidates[n];
+        const int node_idx = ImNodeGraphHandleIndex(pins.Node[pin_idx]);
+        const float dist_sq = ImLengthSqr(GetPinCanvasPos(graph, pin_idx) - mouse);
+        if (nodes.VisibleFrame[node_idx] != graph->Frame || dist_sq > pin_radius * pin_radius)
+            continue;
+        if (graph->HoveredPin == 0 || nodes.Depth[node_idx] > best_depth || (nodes.Depth[node_idx] == best_depth && dist_sq < best_dist_sq))
+        {
+            graph->HoveredPin = pins.Slots.GetHandle(pin_idx);
+            best_depth = nodes.Depth[node_idx];
+            best_dist_sq = dist_sq;
+        }
+    }
+    if (graph->HoveredPin != 0)
+        return;
+
+    candidates.resize(0);
+    QueryDisplayedItems(graph, graph->NodeGrid, ImRect(mouse, mouse), &candidates);
+    graph->Stats.HitTests += candidates.Size;
+    for (int n = 0; n < candidates.Size; n++)
+    {
+        const int node_idx = candidates[n];
+        if (nodes.VisibleFrame[node_idx] != graph->Frame || !graph->GetNodeDisplayRect(node_idx).Contains(mouse))
+            continue;
+        if (graph->HoveredNode == 0 || nodes.Depth[node_idx] > best_depth)
+        {
+            graph->HoveredNode = nodes.Slots.GetHandle(node_idx);
+            best_depth = nodes.Depth[node_idx];
+        }
+    }
+    if (graph->HoveredNode != 0 || graph->Lod == ImNodeGraphLod_Density)
+        return;
+
+    // Links are tested against their cached polyline, distance is measured on screen
+    const float hover_dist = g.Style.LinkHoverDistance / graph->Zoom;
+    candidates.resize(0);
+    QueryDisplayedItems(graph, graph->LinkGrid, ImRect(mouse - ImVec2(hover_dist, hover_dist), mouse + ImVec2(hover_dist, hover_dist)), &candidates);
+    best_dist_sq = hover_dist * hover_dist;
+    for (int n = 0; n < candidates.Size; n++)
+    {
+        const ImNodeGraphLinkGeometry& geom = links.Geometry[candidates[n]];
+        const ImVec2 link_mouse = graph->IsLinkInDragGroup(candidates[n]) ? mouse - graph->DragGroupOffset : mouse;
+        ImRect bb = geom.Bounds;
+        bb.Expand(hover_dist);
+        if (geom.Segments == 0 || !bb.Contains(link_mouse))
+            continue;
+        const ImVec2* points = &graph->LinkPoints[geom.PointsOffset];
+        graph->Stats.HitTests += geom.Segments;
+        for (int seg = 0; seg < geom.Segments; seg++)
+        {
+            const float dist_sq = ImLengthSqr(ImLineClosestPoint(points[seg], points[seg + 1], link_mouse) - link_mouse);
+            if (dist_sq <= best_dist_sq)
+            {
+                graph->HoveredLink = links.Slots.GetHandle(candidates[n]);
+                best_dist_sq = dist_sq;
+            }
+        }
+    }
+}
+
+void ImNodeGraph::SetNodeSelected(ImNodeGraphData* graph, int node_idx, bool selected)
+{
+    ImNodeGraphSelection& sel = graph->Selection;
+    IM_ASSERT(graph->Nodes.Slots.IsSlotAlive(node_idx));
+    if (sel.Test(node_idx) == selected)
+        return;
+    CommitDragGroup(graph);
+    sel.Bits[node_idx >> 6] ^= (ImU64)1 << (node_idx & 63);
+    sel.Count += selected ? 1 : -1;
+    sel.AddChange(graph->Nodes.ID[node_idx]);
+}
+
+enum ImNodeGraphSelectOp
+{
+    ImNodeGraphSelectOp_Clear,
+    ImNodeGraphSelectOp_All,
+    ImNodeGraphSelectOp_Invert,
+};
+
+// Whole selection operations work a word at a time. The flipped nodes are only walked when they fit in the change list.
+static void ApplySelectOp(ImNodeGraphData* graph, ImNodeGraphSelectOp op)
+{
+    ImNodeGraphSelection& sel = graph->Selection;
+    const int alive_count = graph->Nodes.Slots.AliveCount - graph->Nodes.HiddenCount; // Hidden nodes are out of the Alive mask
+    const int changed = (op == ImNodeGraphSelectOp_Clear) ? sel.Count : (op == ImNodeGraphSelectOp_All) ? alive_count - sel.Count : alive_count;
+    if (changed == 0)
+        return;
+    CommitDragGroup(graph);
+    const bool list_changes = !sel.ChangesOverflow && sel.Changes.Size + changed <= IMNODEGRAPH_SELECTION_MAX_CHANGES;
+    if (!list_changes)
+    {
+        sel.ChangesOverflow = true;
+        sel.Changes.resize(0);
+    }
+    for (int word = 0; word < sel.Bits.Size; word++)
+    {
+        const ImU64 bits = (op == ImNodeGraphSelectOp_Clear) ? 0 : (op == ImNodeGraphSelectOp_All) ? sel.Alive[word] : (sel.Bits[word] ^ sel.Alive[word]);
+        if (list_changes)
+            for (ImU64 diff = bits ^ sel.Bits[word]; diff != 0; diff &= diff - 1)
+                sel.Changes.push_back(graph->Nodes.ID[(word << 6) + ImNodeGraphFindFirstBit64(diff)]);
+        sel.Bits[word] = bits;
+    }
+    sel.Count = (op == ImNodeGraphSelectOp_Clear) ? 0 : (op == ImNodeGraphSelectOp_All) ? alive_count : alive_count - sel.Count;
+}
+
+void ImNodeGraph::ClearNodeSelection(ImNodeGraphData* graph)
+{
+    ApplySelectOp(graph, ImNodeGraphSelectOp_Clear);
+}
+
+void ImNodeGraph::SelectAllNodes(ImNodeGraphData* graph)
+{
+    ApplySelectOp(graph, ImNodeGraphSelectOp_All);
+}
+
+void ImNodeGraph::InvertNodeSelection(ImNodeGraphData* graph)
+{
+    ApplySelectOp(graph, ImNodeGraphSelectOp_Invert);
+}
+
+// Depth first walk from the selected nodes along output links. The selection bits double as the visited set,
+// so every node and link is looked at once at most.
+void ImNodeGraph::SelectNodesDownstream(ImNodeGraphData* graph)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphArenaVector<int>& stack = graph->SelectionStack;
+    stack.resize(0);
+    for (int node_idx = graph->Selection.FindNext(0); node_idx != -1; node_idx = graph->Selection.FindNext(node_idx + 1))
+        stack.push_back(node_idx);
+    while (!stack.empty())
+    {
+        const int node_idx = stack.back();
+        stack.resize(stack.Size - 1);
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+        {
+            if (pins.Direction[ImNodeGraphHandleIndex(pin)] != ImPinDirection_Output)
+                continue;
+            for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(links, link, pin))
+            {
+                const int next_idx = ImNodeGraphHandleIndex(pins.Node[ImNodeGraphHandleIndex(links.EndPin[ImNodeGraphHandleIndex(link)])]);
+                if (graph->Selection.Test(next_idx) || nodes.Hidden[next_idx])
+                    continue;
+                SetNodeSelected(graph, next_idx, true);
+                stack.push_back(next_idx);
+            }
+        }
+    }
+}
+
+// The links crossing the group boundary are the only ones whose shape changes as the group moves
+void ImNodeGraph::BeginDragGroup(ImNodeGraphData* graph)
+{
+    IM_ASSERT(!graph->DragGroupPending);
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    const ImNodeGraphSelection& sel = graph->Selection;
+    graph->DragGroupPending = true;
+    graph->DragGroupOffset = ImVec2(0.0f, 0.0f);
+    graph->DragBoundaryLinks.resize(0);
+    for (int node_idx = sel.FindNext(0); node_idx != -1; node_idx = sel.FindNext(node_idx + 1))
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+            for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(links, link, pin))
+            {
+                const int link_idx = ImNodeGraphHandleIndex(link);
+                const ImNodeGraphHandle other_pin = (links.StartPin[link_idx] == pin) ? links.EndPin[link_idx] : links.StartPin[link_idx];
+                if (!sel.Test(ImNodeGraphHandleIndex(pins.Node[ImNodeGraphHandleIndex(other_pin)])))
+                    graph->DragBoundaryLinks.push_back(link);
+            }
+
+    // Links leaving a collapsed group are drawn from its edges, they follow it too
+    for (int node_idx = sel.FindNext(0); node_idx != -1; node_idx = sel.FindNext(node_idx + 1))
+        if (const ImNodeGraphGroupState* group = nodes.GroupState[node_idx])
+            for (int n = 0; n < group->BoundaryLinks.Size; n++)
+                graph->DragBoundaryLinks.push_back(group->BoundaryLinks[n]);
+}
+
+// Links within the group are moved along rather than rebuilt, so dropping a large selection only rebuilds the links
+// crossing its boundary. Node positions, cells and routes around the nodes are brought up to date.
+void ImNodeGraph::CommitDragGroup(ImNodeGraphData* graph)
+{
+    if (!graph->DragGroupPending)
+        return;
+    IMNODEGRAPH_PROFILE_ZONE("CommitDragGroup");
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    const ImNodeGraphSelection& sel = graph->Selection;
+    const ImVec2 offset = graph->DragGroupOffset;
+    for (int node_idx = sel.FindNext(0); node_idx != -1; node_idx = sel.FindNext(node_idx + 1))
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+            for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(links, link, pin))
+            {
+                // Visited from both ends, moved from the start one
+                const int link_idx = ImNodeGraphHandleIndex(link);
+                if (links.StartPin[link_idx] != pin || !graph->IsLinkInDragGroup(link_idx))
+                    continue;
+                ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+                geom.Start += offset;
+                geom.End += offset;
+                geom.Bounds.Translate(offset);
+                if (geom.Segments > 0)
+                {
+                    ImVec2* points = &graph->LinkPoints[geom.PointsOffset];
+                    for (int n = 0; n <= geom.Segments; n++)
+                        points[n] += offset;
+                }
+                graph->LinkGrid.Update(link_idx, &geom.GridRange, geom.Bounds);
+            }
+
+    graph->DragGroupPending = false;
+    graph->DragGroupOffset = ImVec2(0.0f, 0.0f);
+    graph->DragBoundaryLinks.resize(0);
+    for (int node_idx = sel.FindNext(0); node_idx != -1; node_idx = sel.FindNext(node_idx + 1))
+        nodes.Pos[node_idx] += offset;
+    for (int node_idx = sel.FindNext(0); node_idx != -1; node_idx = sel.FindNext(node_idx + 1))
+        UpdateNodeBounds(graph, node_idx);
+}
+
+void ImNodeGraph::UpdateInteraction(ImNodeGraphData* graph, ImDrawList* draw_list)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateInteraction");
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (graph->CanvasClicked)
+    {
+        if (graph->HoveredPin != 0)
+        {
+            graph->Interaction = ImNodeGraphInteraction_DragLink;
+            graph->DragLinkPin = graph->HoveredPin;
+            graph->DragLinkCycleNode = -1;
+        }
+        else if (graph->HoveredNode != 0)
+        {
+            const int node_idx = ImNodeGraphHandleIndex(graph->HoveredNode);
+            if (io.KeyCtrl)
+                SetNodeSelected(graph, node_idx, !graph->Selection.Test(node_idx));
+            else if (!graph->Selection.Test(node_idx))
+            {
+                ClearNodeSelection(graph);
+                SetNodeSelected(graph, node_idx, true);
+            }
+            nodes.Depth[node_idx] = ++graph->DepthCounter;
+            StopLayoutAnimation(graph, true);
+            graph->Interaction = graph->Selection.Test(node_idx) ? ImNodeGraphInteraction_DragNodes : ImNodeGraphInteraction_None;
+            graph->DragOffset = ImVec2(0.0f, 0.0f);
+        }
+        else
+        {
+            if (!io.KeyCtrl)
+                ClearNodeSelection(graph);
+            graph->Interaction = ImNodeGraphInteraction_BoxSelect;
+            graph->BoxSelectStart = graph->ScreenToCanvas(io.MousePos);
+        }
+    }
+
+    switch (graph->Interaction)
+    {
+    case ImNodeGraphInteraction_DragNodes:
+    {
+        if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        {
+            // The whole drag is a single delta
+            CommitDragGroup(graph);
+            if (graph->Undo.IsRecording() && (graph->DragOffset.x != 0.0f || graph->DragOffset.y != 0.0f))
+                RecordNodesMoved(graph, graph->DragOffset);
+            graph->Interaction = ImNodeGraphInteraction_None;
+            break;
+        }
+        const ImVec2 delta = io.MouseDelta / graph->Zoom;
+        if (delta.x == 0.0f && delta.y == 0.0f)
+            break;
+        graph->DragOffset += delta;
+        // The selection moves as a group: the nodes are displayed at an offset and only the links crossing the group
+        // boundary follow, everything else is written when the nodes are dropped or something needs their position
+        if (!graph->DragGroupPending)
+            BeginDragGroup(graph);
+        graph->DragGroupOffset += delta;
+        for (int n = 0; n < graph->DragBoundaryLinks.Size; n++)
+            if (graph->Links.Slots.IsAlive(graph->DragBoundaryLinks[n]))
+                UpdateLinkGeometry(graph, ImNodeGraphHandleIndex(graph->DragBoundaryLinks[n]));
+        break;
+    }
+    case ImNodeGraphInteraction_DragLink:
+    {
+        if (!pins.Slots.IsAlive(graph->DragLinkPin))
+        {
+            graph->Interaction = ImNodeGraphInteraction_None;
+            break;
+        }
+        // Snap to the hovered pin, or to the nearest compatible one around the mouse
+        const int start = ImNodeGraphHandleIndex(graph->DragLinkPin);
+        int target = graph->HoveredPin ? ImNodeGraphHandleIndex(graph->HoveredPin) : -1;
+        if (target == -1 || !ArePinsCompatible(graph, start, target))
+        {
+            const ImNodeGraphHandle snap_pin = FindNearestCompatiblePin(graph, start, graph->ScreenToCanvas(io.MousePos), g.Style.LinkSnapDistance / graph->Zoom);
+            target = snap_pin ? ImNodeGraphHandleIndex(snap_pin) : -1;
+        }
+        const bool compatible = target != -1 && ArePinsCompatible(graph, start, target) && !((graph->Flags & ImNodeGraphFlags_NoCycles) && IsLinkDragCyclic(graph, start, target));
+        const bool start_is_output = (pins.Direction[start] == ImPinDirection_Output);
+        if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        {
+            if (compatible)
+            {
+                graph->LinkCreated = true;
+                graph->CreatedLinkStart = start_is_output ? pins.ID[start] : pins.ID[target];
+                graph->CreatedLinkEnd = start_is_output ? pins.ID[target] : pins.ID[start];
+            }
+            graph->Interaction = ImNodeGraphInteraction_None;
+            break;
+        }
+        const ImVec2 start_pos = GetPinCanvasPos(graph, start);
+        const ImVec2 end_pos = compatible ? GetPinCanvasPos(graph, target) : graph->ScreenToCanvas(io.MousePos);
+        ImVec2 p[4];
+        if (start_is_output)
+            GetLinkBezier(start_pos, end_pos, p);
+        else
+            GetLinkBezier(end_pos, start_pos, p);
+        graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Overlay);
+        draw_list->AddBezierCubic(graph->CanvasToScreen(p[0]), graph->CanvasToScreen(p[1]), graph->CanvasToScreen(p[2]), graph->CanvasToScreen(p[3]), g.Style.Colors[ImNodeGraphCol_LinkHovered], g.Style.LinkThickness * graph->Zoom);
+        break;
+    }
+    case ImNodeGraphInteraction_BoxSelect:
+    {
+        const ImRect box(ImMin(graph->BoxSelectStart, graph->ScreenToCanvas(io.MousePos)), ImMax(graph->BoxSelectStart, graph->ScreenToCanvas(io.MousePos)));
+        if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+        {
+            graph->QueryBuffer.resize(0);
+            graph->NodeGrid.Query(box, &graph->QueryBuffer);
+            for (int n = 0; n < graph->QueryBuffer.Size; n++)
+            {
+                const int node_idx = graph->QueryBuffer[n];
+                if (!graph->Selection.Test(node_idx) && box.Overlaps(nodes.GetRect(node_idx)))
+                    SetNodeSelected(graph, node_idx, true);
+            }
+            graph->Interaction = ImNodeGraphInteraction_None;
+            break;
+        }
+        graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Overlay);
+        draw_list->AddRectFilled(graph->CanvasToScreen(box.Min), graph->CanvasToScreen(box.Max), g.Style.Colors[ImNodeGraphCol_BoxSelect]);
+        draw_list->AddRect(graph->CanvasToScreen(box.Min), graph->CanvasToScreen(box.Max), g.Style.Colors[ImNodeGraphCol_BoxSelectOutline]);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void ImNodeGraph::DrawLinks(ImNodeGraphData* graph, ImDrawList* draw_list)
+{
+    IMNODEGRAPH_PROFILE_ZONE("DrawLinks");
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphArenaVector<ImVec2>& screen_points = graph->LinkScreenPoints;
+    const float thickness = g.Style.LinkThickness * graph->Zoom;
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Links);
+    for (int n = 0; n < graph->VisibleLinks.Size; n++)
+    {
+        const int link_idx = graph->VisibleLinks[n];
+        const ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+        const ImVec2* points = &graph->LinkPoints[geom.PointsOffset];
+        const ImVec2 offset = graph->IsLinkInDragGroup(link_idx) ? graph->DragGroupOffset : ImVec2(0.0f, 0.0f);
+        screen_points.resize(geom.Segments + 1);
+        for (int i = 0; i <= geom.Segments; i++)
+            screen_points[i] = graph->CanvasToScreen(points[i] + offset);
+        const bool hovered = (links.Slots.GetHandle(link_idx) == graph->HoveredLink);
+        draw_list->AddPolyline(screen_points.Data, screen_points.Size, g.Style.Colors[hovered ? ImNodeGraphCol_LinkHovered : ImNodeGraphCol_Link], ImDrawFlags_None, thickness);
+    }
+}
+
+// Nodes below ImNodeGraphLod_Full are drawn from their retained geometry, directly in the node layer
+void ImNodeGraph::DrawReducedNodes(ImNodeGraphData* graph, ImDrawList* draw_list)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    if (graph->Lod == ImNodeGraphLod_Full)
+        return;
+    IMNODEGRAPH_PROFILE_ZONE("DrawReducedNodes");
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Nodes);
+
+    if (graph->Lod == ImNodeGraphLod_Density)
+    {
+        // One tile per occupied cell, opacity follows the number of nodes relative to the densest cell
+        const ImRect view(graph->ScreenToCanvas(graph->ScreenRect.Min), graph->ScreenToCanvas(graph->ScreenRect.Max));
+        ImNodeGraphSpatialGrid& grid = graph->NodeGrid;
+        grid.QueryCells(view, &graph->DensityCells);
+        int max_count = 1;
+        for (int n = 0; n < graph->DensityCells.Size; n++)
+        {
+            int count = 0;
+            for (int entry_idx = graph->DensityCells[n].Head; entry_idx != -1; entry_idx = grid.Entries[entry_idx].Next)
+                count++;
+            graph->DensityCells[n].Head = count; // Reused to hold the count from here on
+            max_count = ImMax(max_count, count);
+        }
+        const ImVec4 col = ImGui::ColorConvertU32ToFloat4(g.Style.Colors[ImNodeGraphCol_NodeDensity]);
+        for (int n = 0; n < graph->DensityCells.Size; n++)
+        {
+            const ImNodeGraphGridCell& cell = graph->DensityCells[n];
+            const ImVec2 cell_min((float)cell.X * grid.CellSize, (float)cell.Y * grid.CellSize);
+            const float alpha = col.w * (0.25f + 0.75f * (float)cell.Head / (float)max_count);
+            draw_list->AddRectFilled(graph->CanvasToScreen(cell_min), graph->CanvasToScreen(cell_min + ImVec2(grid.CellSize, grid.CellSize)), ImGui::ColorConvertFloat4ToU32(ImVec4(col.x, col.y, col.z, alpha)));
+        }
+        return;
+    }
+
+    const float rounding = g.Style.NodeRounding * graph->Zoom;
+    const float header_height = ImGui::GetFontSize() + g.Style.NodePadding.y * 2.0f * graph->Zoom;
+    for (int n = 0; n < graph->VisibleNodes.Size; n++)
+    {
+        const int node_idx = graph->VisibleNodes[n];
+        if (nodes.Size[node_idx].x <= 0.0f || nodes.Hidden[node_idx]) // Hidden since the visible set was made
+            continue;
+        const ImVec2 node_pos = graph->GetNodeDisplayPos(node_idx);
+        const ImVec2 node_min = graph->CanvasToScreen(node_pos);
+        const ImVec2 node_max = graph->CanvasToScreen(node_pos + nodes.Size[node_idx]);
+        const bool selected = graph->Selection.Test(node_idx);
+        if (graph->Lod == ImNodeGraphLod_Box)
+        {
+            draw_list->AddRectFilled(node_min, node_max, g.Style.Colors[selected ? ImNodeGraphCol_NodeSelected : ImNodeGraphCol_NodeHeader]);
+            continue;
+        }
+
+        draw_list->AddRectFilled(node_min, node_max, g.Style.Colors[ImNodeGraphCol_NodeBg], rounding);
+        draw_list->AddRectFilled(node_min, ImVec2(node_max.x, ImMin(node_min.y + header_height, node_max.y)), g.Style.Colors[ImNodeGraphCol_NodeHeader], rounding, ImDrawFlags_RoundCornersTop);
+        if (selected)
+            draw_list->AddRect(node_min, node_max, g.Style.Colors[ImNodeGraphCol_NodeSelected], rounding, 0, g.Style.NodeBorderSize * graph->Zoom);
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+        {
+            const int pin_idx = ImNodeGraphHandleIndex(pin);
+            const ImU32 col = g.Style.Colors[pin == graph->HoveredPin ? ImNodeGraphCol_PinHovered : ImNodeGraphCol_Pin];
+            draw_list->AddCircleFilled(graph->CanvasToScreen(node_pos + pins.Offset[pin_idx]), g.Style.PinRadius * graph->Zoom, col, 6);
+        }
+        if (const int boundary_pins = GetGroupBoundaryPins(graph, node_idx))
+            for (int direction = ImPinDirection_Input; direction <= ImPinDirection_Output; direction++)
+                if (boundary_pins & (1 << direction))
+                    draw_list->AddCircleFilled(graph->CanvasToScreen(GetGroupBoundaryPinPos(graph, node_idx, direction)), g.Style.PinRadius * graph->Zoom, g.Style.Colors[ImNodeGraphCol_Pin], 6);
+    }
+}
+
+void ImNodeGraph::EndGraph()
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphData* graph = g.CurrentGraph;
+    IM_ASSERT(graph != NULL && "Mismatched BeginGraph()/EndGraph() calls");
+    IM_ASSERT(g.CurrentNode == 0 && "Missing EndNode()");
+    EndProfileZone(graph->NodesZone);
+    graph->NodesZone = -1;
+    IMNODEGRAPH_PROFILE_ZONE("EndGraph");
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    UpdateVisibleLinks(graph);
+    UpdateHovered(graph);
+    UpdateInteraction(graph, draw_list);
+    DrawLinks(graph, draw_list);
+    DrawReducedNodes(graph, draw_list);
+    ComposeNodeLayer(graph, draw_list);
+    if (graph->Flags & ImNodeGraphFlags_Minimap)
+        UpdateMinimap(graph, draw_list);
+
+    graph->Splitter.Merge(draw_list);
+    ImNodeGraphFrameStats& stats = graph->Stats;
+    stats.VtxCount = draw_list->VtxBuffer.Size - graph->VtxCountAtBegin;
+    stats.IdxCount = draw_list->IdxBuffer.Size - graph->IdxCountAtBegin;
+    stats.DrawCmds = ImMax(draw_list->CmdBuffer.Size - graph->CmdCountAtBegin, 0);
+    stats.MemoryUsage = CalcGraphMemoryUsage(graph);
+    stats.BytesAllocated = (stats.MemoryUsage > graph->MemoryUsageAtBegin) ? stats.MemoryUsage - graph->MemoryUsageAtBegin : 0;
+    PopZoomedFont();
+    ImGui::EndChild();
+    g.CurrentGraph = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Minimap
+//-----------------------------------------------------------------------------
+
+// Spatial index cell coordinates are within +/- 32768, minimap ones are made positive to fit 16-bit each
+static inline ImGuiID MinimapCellKey(const ImNodeGraphGridRange& range)
+{
+    return (ImGuiID)((range.X0 + 32768) / IMNODEGRAPH_MINIMAP_CELL_SCALE) | ((ImGuiID)((range.Y0 + 32768) / IMNODEGRAPH_MINIMAP_CELL_SCALE) << 16);
+}
+
+static ImVec2 GetMinimapCellPos(ImGuiID cell_key, float grid_cell_size)
+{
+    const float cell_size = grid_cell_size * IMNODEGRAPH_MINIMAP_CELL_SCALE;
+    return ImVec2((float)(cell_key & 0xFFFF) * cell_size - 32768.0f * grid_cell_size, (float)(cell_key >> 16) * cell_size - 32768.0f * grid_cell_size);
+}
+
+void ImNodeGraph::UpdateMinimapCell(ImNodeGraphData* graph, const ImNodeGraphGridRange& old_range, const ImNodeGraphGridRange& new_range)
+{
+    ImNodeGraphMinimap& minimap = graph->Minimap;
+    const ImGuiID old_key = old_range.IsEmpty() ? 0 : MinimapCellKey(old_range);
+    const ImGuiID new_key = new_range.IsEmpty() ? 0 : MinimapCellKey(new_range);
+    if (old_range.IsEmpty() == new_range.IsEmpty() && old_key == new_key)
+        return;
+    if (!old_range.IsEmpty())
+    {
+        ImU32* count = minimap.Cells.GetRef(old_key, 0);
+        IM_ASSERT(*count > 0 && "Node missing from its minimap cell");
+        if (--*count == 0)
+            minimap.Cells.Remove(old_key);
+    }
+    if (!new_range.IsEmpty())
+        (*minimap.Cells.GetRef(new_key, 0))++;
+    minimap.Version++;
+}
+
+// One quad per occupied cell, the graph fitted to the minimap keeping its aspect ratio
+static void BuildMinimap(ImNodeGraphData* graph, const ImVec2& size, const ImVec2& uv_white)
+{
+    IMNODEGRAPH_PROFILE_ZONE("BuildMinimap");
+    const ImNodeGraphStyle& style = GImNodeGraph->Style;
+    ImNodeGraphMinimap& minimap = graph->Minimap;
+    const ImNodeGraphIDMap& cells = minimap.Cells;
+    const float grid_cell_size = graph->NodeGrid.CellSize;
+    const float cell_size = grid_cell_size * IMNODEGRAPH_MINIMAP_CELL_SCALE;
+    minimap.BuiltVersion = minimap.Version;
+    minimap.BuiltSize = size;
+    minimap.VtxBuffer.resize(0);
+    minimap.Scale = 0.0f;
+    if (cells.Count == 0)
+        return;
+
+    // The zero key is stored outside of the pairs, visited last
+    ImRect bounds(ImVec2(FLT_MAX, FLT_MAX), ImVec2(-FLT_MAX, -FLT_MAX));
+    ImU32 max_count = 1;
+    for (int pair_n = 0; pair_n < cells.Pairs.Size + 1; pair_n++)
+    {
+        const bool zero_key = (pair_n == cells.Pairs.Size);
+        if (zero_key ? !cells.HasZeroKey : cells.Pairs[pair_n].Key == 0)
+            continue;
+        const ImVec2 cell_min = GetMinimapCellPos(zero_key ? 0 : cells.Pairs[pair_n].Key, grid_cell_size);
+        bounds.Add(ImRect(cell_min, cell_min + ImVec2(cell_size, cell_size)));
+        max_count = ImMax(max_count, zero_key ? cells.ZeroKeyValue : cells.Pairs[pair_n].Value);
+    }
+    const ImVec2 content_size = ImMax(size - style.MinimapPadding * 2.0f, ImVec2(1.0f, 1.0f));
+    minimap.Bounds = bounds;
+    minimap.Scale = ImMin(content_size.x / bounds.GetWidth(), content_size.y / bounds.GetHeight());
+    minimap.Origin = style.MinimapPadding + (content_size - bounds.GetSize() * minimap.Scale) * 0.5f;
+
+    const ImVec4 col = ImGui::ColorConvertU32ToFloat4(style.Colors[ImNodeGraphCol_MinimapDensity]);
+    minimap.VtxBuffer.resize(cells.Count * 4);
+    ImDrawVert* vtx = minimap.VtxBuffer.Data;
+    for (int pair_n = 0; pair_n < cells.Pairs.Size + 1; pair_n++)
+    {
+        const bool zero_key = (pair_n == cells.Pairs.Size);
+        if (zero_key ? !cells.HasZeroKey : cells.Pairs[pair_n].Key == 0)
+            continue;
+        const ImU32 count = zero_key ? cells.ZeroKeyValue : cells.Pairs[pair_n].Value;
+        const ImU32 cell_col = ImGui::ColorConvertFloat4ToU32(ImVec4(col.x, col.y, col.z, col.w * (0.25f + 0.75f * (float)count / (float)max_count)));
+        const ImVec2 p0 = minimap.Origin + (GetMinimapCellPos(zero_key ? 0 : cells.Pairs[pair_n].Key, grid_cell_size) - bounds.Min) * minimap.Scale;
+        const ImVec2 p1 = ImMax(p0 + ImVec2(cell_size, cell_size) * minimap.Scale, p0 + ImVec2(1.0f, 1.0f));
+        const ImVec2 corners[4] = { p0, ImVec2(p1.x, p0.y), p1, ImVec2(p0.x, p1.y) };
+        for (int n = 0; n < 4; n++)
+        {
+            vtx[n].pos = corners[n];
+            vtx[n].uv = uv_white;
+            vtx[n].col = cell_col;
+        }
+        vtx += 4;
+    }
+}
+
+// Submitted after everything else so it takes the mouse over the canvas and the nodes under it. Clicking centers the
+// view on that point, grabbing the viewport rectangle drags it from where it was grabbed.
+void ImNodeGraph::UpdateMinimap(ImNodeGraphData* graph, ImDrawList* draw_list)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateMinimap");
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphMinimap& minimap = graph->Minimap;
+    const ImVec2 size = ImMin(g.Style.MinimapSize, graph->ScreenRect.GetSize() - g.Style.MinimapOffset * 2.0f);
+    if (size.x < 1.0f || size.y < 1.0f)
+        return;
+    const ImRect rect(graph->ScreenRect.Max - g.Style.MinimapOffset - size, graph->ScreenRect.Max - g.Style.MinimapOffset);
+    if (minimap.BuiltVersion != minimap.Version || minimap.BuiltSize.x != size.x || minimap.BuiltSize.y != size.y)
+        BuildMinimap(graph, size, draw_list->_Data->TexUvWhitePixel);
+
+    ImGui::SetCursorScreenPos(rect.Min);
+    ImGui::InvisibleButton("##minimap", size, ImGuiButtonFlags_MouseButtonLeft);
+    if (minimap.Scale > 0.0f)
+    {
+        const ImVec2 mouse = minimap.Bounds.Min + (ImGui::GetIO().MousePos - rect.Min - minimap.Origin) / minimap.Scale;
+        if (ImGui::IsItemActivated())
+        {
+            const ImRect view(graph->ScreenToCanvas(graph->ScreenRect.Min), graph->ScreenToCanvas(graph->ScreenRect.Max));
+            minimap.GrabOffset = view.Contains(mouse) ? mouse - view.GetCenter() : ImVec2(0.0f, 0.0f);
+        }
+        if (ImGui::IsItemActive())
+            graph->Pan = graph->ScreenRect.GetSize() * 0.5f - (mouse - minimap.GrabOffset) * graph->Zoom;
+    }
+
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Overlay);
+    draw_list->PushClipRect(rect.Min, rect.Max, true);
+    draw_list->AddRectFilled(rect.Min, rect.Max, g.Style.Colors[ImNodeGraphCol_MinimapBg]);
+
+    // Batches keep within the range of 16-bit indices
+    const int quad_count = minimap.VtxBuffer.Size / 4;
+    for (int first_quad = 0; first_quad < quad_count; first_quad += 4096)
+    {
+        const int batch_quads = ImMin(quad_count - first_quad, 4096);
+        draw_list->PrimReserve(batch_quads * 6, batch_quads * 4);
+        const ImDrawIdx vtx_base = (ImDrawIdx)draw_list->_VtxCurrentIdx;
+        for (int n = 0; n < batch_quads; n++)
+        {
+            ImDrawIdx* idx = draw_list->_IdxWritePtr + n * 6;
+            const ImDrawIdx quad_base = (ImDrawIdx)(vtx_base + n * 4);
+            idx[0] = quad_base; idx[1] = (ImDrawIdx)(quad_base + 1); idx[2] = (ImDrawIdx)(quad_base + 2);
+            idx[3] = quad_base; idx[4] = (ImDrawIdx)(quad_base + 2); idx[5] = (ImDrawIdx)(quad_base + 3);
+        }
+        for (int n = 0; n < batch_quads * 4; n++)
+        {
+            draw_list->_VtxWritePtr[n] = minimap.VtxBuffer[first_quad * 4 + n];
+            draw_list->_VtxWritePtr[n].pos += rect.Min;
+        }
+        draw_list->_IdxWritePtr += batch_quads * 6;
+        draw_list->_VtxWritePtr += batch_quads * 4;
+        draw_list->_VtxCurrentIdx += batch_quads * 4;
+    }
+
+    if (minimap.Scale > 0.0f)
+    {
+        const ImVec2 view_min = rect.Min + minimap.Origin + (graph->ScreenToCanvas(graph->ScreenRect.Min) - minimap.Bounds.Min) * minimap.Scale;
+        const ImVec2 view_max = rect.Min + minimap.Origin + (graph->ScreenToCanvas(graph->ScreenRect.Max) - minimap.Bounds.Min) * minimap.Scale;
+        draw_list->AddRectFilled(view_min, view_max, g.Style.Colors[ImNodeGraphCol_MinimapViewport]);
+        draw_list->AddRect(view_min, view_max, g.Style.Colors[ImNodeGraphCol_MinimapViewportOutline]);
+    }
+    draw_list->PopClipRect();
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Nodes and pins
+//-----------------------------------------------------------------------------
+
+// Quarter octave buckets: text is measured at the bucket size and scaled to the actual one, so zooming smoothly only
+// measures again when crossing into the next bucket
+static int CalcTextSizeBucket(float size)
+{
+    return (int)ImFloor(ImLog(size) / ImLog(2.0f) * 4.0f + 0.5f);
+}
+
+// Widths measured in other zoom buckets won't be asked for again until the zoom comes back, drop them
+void ImNodeGraph::UpdateTextCache(ImNodeGraphData* graph)
+{
+    const int zoom_bucket = CalcTextSizeBucket(graph->Zoom);
+    if (graph->TextZoomBucket == zoom_bucket)
+        return;
+    graph->TextWidths.Clear();
+    graph->TextZoomBucket = zoom_bucket;
+}
+
+// Nodes may push their own font, the key is seeded with the font and size bucket current when the text is drawn
+float ImNodeGraph::CalcTextWidth(ImNodeGraphData* graph, const char* text, const char* text_end)
+{
+    if (text == text_end)
+        return 0.0f;
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    if (graph->TextFont != font || graph->TextFontSize != font_size)
+    {
+        const int bucket = CalcTextSizeBucket(font_size);
+        graph->TextFont = font;
+        graph->TextFontSize = font_size;
+        graph->TextBucketSize = ImPow(2.0f, (float)bucket / 4.0f);
+        graph->TextSeed = ImHashData(&bucket, sizeof(bucket), ImHashData(&font, sizeof(font)));
+    }
+
+    // All bits set is a NaN, never a measured width
+    ImU32* value = graph->TextWidths.GetRef(ImHashStr(text, (size_t)(text_end - text), graph->TextSeed), 0xFFFFFFFF);
+    float width;
+    if (*value == 0xFFFFFFFF)
+    {
+        width = font->CalcTextSizeA(graph->TextBucketSize, FLT_MAX, 0.0f, text, text_end).x;
+        memcpy(value, &width, sizeof(width));
+    }
+    else
+    {
+        memcpy(&width, value, sizeof(width));
+    }
+    return width * font_size / graph->TextBucketSize;
+}
+
+// Texture of draw commands, an identifier before Dear ImGui 1.92 and a reference since
+#if IMGUI_VERSION_NUM >= 19200
+static inline ImNodeGraphTexture GetDrawCmdTexture(const ImDrawCmd& cmd)           { return cmd.TexRef; }
+static inline void PushDrawListTexture(ImDrawList* draw_list, ImNodeGraphTexture tex) { draw_list->PushTexture(tex); }
+static inline void PopDrawListTexture(ImDrawList* draw_list)                       { draw_list->PopTexture(); }
+#else
+static inline ImNodeGraphTexture GetDrawCmdTexture(const ImDrawCmd& cmd)           { return cmd.TextureId; }
+static inline void PushDrawListTexture(ImDrawList* draw_list, ImNodeGraphTexture tex) { draw_list->PushTextureID(tex); }
+static inline void PopDrawListTexture(ImDrawList* draw_list)                       { draw_list->PopTextureID(); }
+#endif
+
+// Clip rectangle, texture and vertex offset lead ImDrawCmd whichever the version, compared at once as ImDrawList does
+static inline bool CompareDrawCmdHeader(const ImDrawCmd& a, const ImDrawCmd& b)
+{
+    return memcmp(&a, &b, offsetof(ImDrawCmd, VtxOffset) + sizeof(unsigned int)) == 0;
+}
+
+// First command of a channel holding index 'idx' or any after it. Commands are in index order, empty ones (callbacks)
+// at 'idx' come first.
+static int FindDrawCmd(const ImVector<ImDrawCmd>& cmd_buffer, int idx)
+{
+    int lo = 0, hi = cmd_buffer.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        const ImDrawCmd& cmd = cmd_buffer[mid];
+        const bool before = (cmd.ElemCount == 0) ? (int)cmd.IdxOffset < idx : (int)(cmd.IdxOffset + cmd.ElemCount) <= idx;
+        if (before)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Ranges of a node in the order they are composed: background, then title and widgets, then pins
+static void GetNodeDrawRanges(const ImNodeGraphNodeDraw& node_draw, int out_ranges[3][2])
+{
+    out_ranges[0][0] = node_draw.BackgroundBegin; out_ranges[0][1] = node_draw.PinsBegin;
+    out_ranges[1][0] = node_draw.ContentBegin;    out_ranges[1][1] = node_draw.BackgroundBegin;
+    out_ranges[2][0] = node_draw.PinsBegin;       out_ranges[2][1] = node_draw.End;
+}
+
+// Start the ranges of a node in the scratch channel, which must be the current one
+static void BeginNodeDraw(ImNodeGraphData* graph, int node_idx, ImDrawList* draw_list)
+{
+    ImNodeGraphNodeDraw node_draw;
+    node_draw.NodeIdx = node_idx;
+    node_draw.ContentBegin = node_draw.BackgroundBegin = node_draw.PinsBegin = node_draw.End = draw_list->IdxBuffer.Size;
+    const int draw_order = graph->Nodes.DrawOrder[node_idx];
+    if (draw_order != -1)
+        graph->NodeDrawSlots[draw_order] = graph->NodeDraws.Size;
+    graph->NodeDraws.push_back(node_draw);
+}
+
+bool ImNodeGraph::BeginNode(ImGuiID node_id, const char* title, ImU32 content_version)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphData* graph = g.CurrentGraph;
+    IM_ASSERT(graph != NULL && "BeginNode() must be called between BeginGraph() and EndGraph()");
+    IM_ASSERT(g.CurrentNode == 0 && "Nested BeginNode()");
+
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    if (node == 0)
+    {
+        // New nodes were not part of the visible set, draw them on top until next frame
+        node = CreateNode(graph, node_id, ImVec2(0.0f, 0.0f));
+        nodes.VisibleFrame[ImNodeGraphHandleIndex(node)] = graph->Frame;
+        nodes.DrawOrder[ImNodeGraphHandleIndex(node)] = -1;
+    }
+    else if (nodes.VisibleFrame[ImNodeGraphHandleIndex(node)] != graph->Frame)
+    {
+        return false;
+    }
+    else if (graph->Lod != ImNodeGraphLod_Full && nodes.Size[ImNodeGraphHandleIndex(node)].x > 0.0f)
+    {
+        // Drawn by DrawReducedNodes(), nodes which were never measured are still submitted once
+        return false;
+    }
+    const int node_idx = ImNodeGraphHandleIndex(node);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    // Draw data can only be reused while nothing inside the node reacts to the mouse or keyboard
+    g.CurrentNodeCacheable = false;
+    if (content_version != 0 && nodes.DrawOrder[node_idx] != -1)
+    {
+        const ImGuiID active_id = ImGui::GetActiveID();
+        ImRect hot_rect = graph->GetNodeDisplayRect(node_idx);
+        hot_rect.Expand(g.Style.PinHoverRadius / graph->Zoom);
+        g.CurrentNodeCacheable = (active_id == 0 || active_id == graph->CanvasItemID) && !hot_rect.Contains(graph->ScreenToCanvas(ImGui::GetIO().MousePos));
+        g.CurrentNodeCacheable &= (nodes.GroupState[node_idx] == NULL); // Boundary pins of collapsed groups come and go with links
+        const ImNodeGraphNodeDrawCache* cache = nodes.DrawCache[node_idx];
+        const ImVec2 tex_uv_white_pixel = ImGui::GetDrawListSharedData()->TexUvWhitePixel;
+        if (g.CurrentNodeCacheable && cache != NULL && cache->Version == content_version && cache->Zoom == graph->Zoom && cache->Selected == graph->Selection.Test(node_idx)
+            && cache->TexUvWhitePixel.x == tex_uv_white_pixel.x && cache->TexUvWhitePixel.y == tex_uv_white_pixel.y)
+        {
+            ReplayNodeDrawData(graph, node_idx, draw_list);
+            graph->Stats.NodeCacheHits++;
+            return false;
+        }
+        graph->Stats.NodeCacheMisses++;
+    }
+    graph->Stats.NodesSubmitted++;
+    g.CurrentNode = node;
+    g.CurrentNodeVersion = content_version;
+
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_NodeScratch);
+    BeginNodeDraw(graph, node_idx, draw_list);
+
+    const ImVec2 padding = g.Style.NodePadding * graph->Zoom;
+    const ImVec2 node_pos = graph->CanvasToScreen(graph->GetNodeDisplayPos(node_idx));
+    const char* title_end = ImGui::FindRenderedTextEnd(title);
+    draw_list->AddText(ImGui::GetFont(), ImGui::GetFontSize(), node_pos + padding, g.Style.Colors[ImNodeGraphCol_NodeTitle], title, title_end);
+    g.CurrentNodeTitleWidth = CalcTextWidth(graph, title, title_end);
+
+    ImGui::PushID((int)node_id);
+    ImGui::SetCursorScreenPos(node_pos + ImVec2(padding.x, ImGui::GetFontSize() + padding.y * 3.0f));
+    ImGui::BeginGroup();
+    return true;
+}
+
+void ImNodeGraph::EndNode()
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphData* graph = g.CurrentGraph;
+    IM_ASSERT(g.CurrentNode != 0 && "EndNode() called without a matching successful BeginNode()");
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    const int node_idx = ImNodeGraphHandleIndex(g.CurrentNode);
+
+    ImGui::EndGroup();
+    ImGui::PopID();
+
+    // Measure in screen space, store in canvas space
+    const ImVec2 padding = g.Style.NodePadding * graph->Zoom;
+    const float header_height = ImGui::GetFontSize() + padding.y * 2.0f;
+    const ImVec2 node_min = graph->CanvasToScreen(graph->GetNodeDisplayPos(node_idx));
+    ImVec2 node_max = ImGui::GetItemRectMax() + padding;
+    node_max.x = ImMax(node_max.x, node_min.x + g.CurrentNodeTitleWidth + padding.x * 2.0f);
+    node_max.y = ImMax(node_max.y, node_min.y + header_height);
+    nodes.Size[node_idx] = (node_max - node_min) / graph->Zoom;
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImNodeGraphNodeDraw& node_draw = graph->NodeDraws.back();
+    const float rounding = g.Style.NodeRounding * graph->Zoom;
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_NodeScratch);
+    node_draw.BackgroundBegin = draw_list->IdxBuffer.Size;
+    draw_list->AddRectFilled(node_min, node_max, g.Style.Colors[ImNodeGraphCol_NodeBg], rounding);
+    draw_list->AddRectFilled(node_min, ImVec2(node_max.x, node_min.y + header_height), g.Style.Colors[ImNodeGraphCol_NodeHeader], rounding, ImDrawFlags_RoundCornersTop);
+    draw_list->AddRect(node_min, node_max, g.Style.Colors[graph->Selection.Test(node_idx) ? ImNodeGraphCol_NodeSelected : ImNodeGraphCol_NodeOutline], rounding, 0, g.Style.NodeBorderSize * graph->Zoom);
+
+    // Pins sit on the node edges, which are only known now
+    node_draw.PinsBegin = draw_list->IdxBuffer.Size;
+    for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+    {
+        const int pin_idx = ImNodeGraphHandleIndex(pin);
+        pins.Offset[pin_idx].x = (pins.Direction[pin_idx] == ImPinDirection_Output) ? nodes.Size[node_idx].x : 0.0f;
+        const ImU32 col = g.Style.Colors[pin == graph->HoveredPin ? ImNodeGraphCol_PinHovered : ImNodeGraphCol_Pin];
+        draw_list->AddCircleFilled(node_min + pins.Offset[pin_idx] * graph->Zoom, g.Style.PinRadius * graph->Zoom, col);
+    }
+    if (const int boundary_pins = GetGroupBoundaryPins(graph, node_idx))
+        for (int direction = ImPinDirection_Input; direction <= ImPinDirection_Output; direction++)
+            if (boundary_pins & (1 << direction))
+                draw_list->AddCircleFilled(graph->CanvasToScreen(GetGroupBoundaryPinPos(graph, node_idx, direction)), g.Style.PinRadius * graph->Zoom, g.Style.Colors[ImNodeGraphCol_Pin]);
+    node_draw.End = draw_list->IdxBuffer.Size;
+    UpdateNodeBounds(graph, node_idx);
+
+    // Text and widgets are clipped on the CPU, only nodes drawn entirely are recorded
+    if (g.CurrentNodeCacheable && graph->ScreenRect.Contains(ImRect(node_min, node_max)))
+        RecordNodeDrawData(graph, node_idx, draw_list);
+    else if (g.CurrentNodeVersion == 0)
+        nodes.FreeDrawCache(node_idx);
+    g.CurrentNode = 0;
+}
+
+// The scratch channel is the current one, the node is at the end of it
+void ImNodeGraph::RecordNodeDrawData(ImNodeGraphData* graph, int node_idx, ImDrawList* draw_list)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphNodeDrawCache* cache = nodes.DrawCache[node_idx];
+    if (cache == NULL)
+        cache = nodes.DrawCache[node_idx] = IM_NEW(ImNodeGraphNodeDrawCache)();
+    else
+        nodes.DrawCacheBytes -= cache->CalcMemoryUsage();
+    cache->Version = g.CurrentNodeVersion;
+    cache->Zoom = graph->Zoom;
+    cache->Selected = graph->Selection.Test(node_idx);
+    cache->TexUvWhitePixel = ImGui::GetDrawListSharedData()->TexUvWhitePixel;
+    const ImRect rect = graph->GetNodeDisplayRect(node_idx);
+    cache->ScreenRect = ImRect(graph->CanvasToScreen(rect.Min), graph->CanvasToScreen(rect.Max));
+    cache->CmdBuffer.resize(0);
+    cache->VtxBuffer.resize(0);
+    cache->IdxBuffer.resize(0);
+
+    int ranges[3][2];
+    GetNodeDrawRanges(graph->NodeDraws.back(), ranges);
+    const ImVector<ImDrawCmd>& cmd_buffer = draw_list->CmdBuffer;
+    for (int range_n = 0; range_n < 3; range_n++)
+    {
+        const int range_begin = ranges[range_n][0];
+        const int range_end = ranges[range_n][1];
+        for (int cmd_n = FindDrawCmd(cmd_buffer, range_begin); cmd_n < cmd_buffer.Size && (int)cmd_buffer[cmd_n].IdxOffset < range_end; cmd_n++)
+        {
+            const ImDrawCmd& cmd = cmd_buffer[cmd_n];
+            if (cmd.UserCallback != NULL)
+            {
+                // Callbacks can't be replayed, drop the recording altogether
+                cache->Version = 0;
+                nodes.DrawCacheBytes += cache->CalcMemoryUsage();
+                return;
+            }
+            const int idx_begin = ImMax((int)cmd.IdxOffset, range_begin);
+            const int idx_end = ImMin((int)(cmd.IdxOffset + cmd.ElemCount), range_end);
+            if (idx_begin >= idx_end)
+                continue;
+
+            // Vertices of a command are contiguous in practice, copy the range its indices span
+            const ImDrawIdx* idx = &draw_list->IdxBuffer[idx_begin];
+            int vtx_min = idx[0], vtx_max = idx[0];
+            for (int n = 1; n < idx_end - idx_begin; n++)
+            {
+                vtx_min = ImMin(vtx_min, (int)idx[n]);
+                vtx_max = ImMax(vtx_max, (int)idx[n]);
+            }
+            ImNodeGraphNodeDrawCmd rec;
+            rec.ClipRect = cmd.ClipRect;
+            rec.Texture = GetDrawCmdTexture(cmd);
+            rec.VtxOffset = cache->VtxBuffer.Size;
+            rec.VtxCount = vtx_max - vtx_min + 1;
+            rec.IdxOffset = cache->IdxBuffer.Size;
+            rec.IdxCount = idx_end - idx_begin;
+            cache->VtxBuffer.resize(rec.VtxOffset + rec.VtxCount);
+            memcpy(&cache->VtxBuffer[rec.VtxOffset], &draw_list->VtxBuffer[cmd.VtxOffset + vtx_min], (size_t)rec.VtxCount * sizeof(ImDrawVert));
+            cache->IdxBuffer.resize(rec.IdxOffset + rec.IdxCount);
+            for (int n = 0; n < rec.IdxCount; n++)
+                cache->IdxBuffer[rec.IdxOffset + n] = (ImDrawIdx)(idx[n] - vtx_min);
+            cache->CmdBuffer.push_back(rec);
+        }
+    }
+    nodes.DrawCacheBytes += cache->CalcMemoryUsage();
+}
+
+// Recorded back to front already, the whole replay is a single range
+void ImNodeGraph::ReplayNodeDrawData(ImNodeGraphData* graph, int node_idx, ImDrawList* draw_list)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    const ImNodeGraphNodeDrawCache* cache = nodes.DrawCache[node_idx];
+    graph->Splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_NodeScratch);
+    BeginNodeDraw(graph, node_idx, draw_list);
+
+    // Whole pixels keep the recorded text crisp
+    const ImVec2 delta = ImFloor(graph->CanvasToScreen(graph->GetNodeDisplayPos(node_idx)) - cache->ScreenRect.Min + ImVec2(0.5f, 0.5f));
+    for (int cmd_n = 0; cmd_n < cache->CmdBuffer.Size; cmd_n++)
+    {
+        const ImNodeGraphNodeDrawCmd& rec = cache->CmdBuffer[cmd_n];
+
+        // Clip rectangles enclosing the node were the canvas one, others belong to widgets and move with the node
+        ImRect clip_rect(rec.ClipRect);
+        if (clip_rect.Contains(cache->ScreenRect))
+            clip_rect = ImRect(draw_list->GetClipRectMin(), draw_list->GetClipRectMax());
+        else
+            clip_rect.Translate(delta);
+        draw_list->PushClipRect(clip_rect.Min, clip_rect.Max, true);
+        PushDrawListTexture(draw_list, rec.Texture);
+
+        draw_list->PrimReserve(rec.IdxCount, rec.VtxCount);
+        const ImDrawIdx vtx_base = (ImDrawIdx)draw_list->_VtxCurrentIdx;
+        for (int n = 0; n < rec.IdxCount; n++)
+            draw_list->_IdxWritePtr[n] = (ImDrawIdx)(vtx_base + cache->IdxBuffer[rec.IdxOffset + n]);
+        for (int n = 0; n < rec.VtxCount; n++)
+        {
+            draw_list->_VtxWritePtr[n] = cache->VtxBuffer[rec.VtxOffset + n];
+            draw_list->_VtxWritePtr[n].pos += delta;
+        }
+        draw_list->_IdxWritePtr += rec.IdxCount;
+        draw_list->_VtxWritePtr += rec.VtxCount;
+        draw_list->_VtxCurrentIdx += rec.VtxCount;
+
+        PopDrawListTexture(draw_list);
+        draw_list->PopClipRect();
+    }
+    graph->NodeDraws.back().End = draw_list->IdxBuffer.Size;
+}
+
+// Append indices of the scratch channel to the node layer, extending its last command when the state matches. Nodes
+// mostly share the canvas clip rectangle and the font texture, so the layer ends up with a handful of commands.
+static void AppendDrawRange(const ImDrawChannel& src, ImDrawChannel* dst, int range_begin, int range_end)
+{
+    for (int cmd_n = FindDrawCmd(src._CmdBuffer, range_begin); cmd_n < src._CmdBuffer.Size && (int)src._CmdBuffer[cmd_n].IdxOffset < range_end; cmd_n++)
+    {
+        const ImDrawCmd& cmd = src._CmdBuffer[cmd_n];
+        const int idx_begin = ImMax((int)cmd.IdxOffset, range_begin);
+        const int idx_end = ImMin((int)(cmd.IdxOffset + cmd.ElemCount), range_end);
+        if (idx_begin >= idx_end && cmd.UserCallback == NULL)
+            continue;
+        ImDrawCmd* last = (dst->_CmdBuffer.Size > 0) ? &dst->_CmdBuffer.back() : NULL;
+        const bool same_state = last != NULL && last->UserCallback == NULL && cmd.UserCallback == NULL && CompareDrawCmdHeader(*last, cmd);
+        if (last != NULL && last->ElemCount == 0 && last->UserCallback == NULL && cmd.UserCallback == NULL)
+        {
+            // Left by SetCurrentChannel() or a clip rectangle change, take it over
+            const unsigned int idx_offset = last->IdxOffset;
+            *last = cmd;
+            last->IdxOffset = idx_offset;
+            last->ElemCount = 0;
+        }
+        else if (!same_state)
+        {
+            ImDrawCmd new_cmd = cmd;
+            new_cmd.IdxOffset = (unsigned int)dst->_IdxBuffer.Size;
+            new_cmd.ElemCount = 0;
+            dst->_CmdBuffer.push_back(new_cmd);
+        }
+        const int idx_count = idx_end - idx_begin;
+        if (idx_count <= 0)
+            continue;
+        dst->_CmdBuffer.back().ElemCount += (unsigned int)idx_count;
+        dst->_IdxBuffer.resize(dst->_IdxBuffer.Size + idx_count);
+        memcpy(dst->_IdxBuffer.Data + dst->_IdxBuffer.Size - idx_count, src._IdxBuffer.Data + idx_begin, (size_t)idx_count * sizeof(ImDrawIdx));
+    }
+}
+
+// Nodes are submitted in the application order, the node layer is built from their ranges once per frame, in the
+// draw order set by UpdateVisibleNodes() and then the nodes drawn on top of it. Only indices are copied, vertices are
+// shared by all the channels.
+void ImNodeGraph::ComposeNodeLayer(ImNodeGraphData* graph, ImDrawList* draw_list)
+{
+    IMNODEGRAPH_PROFILE_ZONE("ComposeNodeLayer");
+    ImDrawListSplitter& splitter = graph->Splitter;
+    splitter.SetCurrentChannel(draw_list, ImNodeGraphDrawLayer_Links);
+    ImDrawChannel& scratch = splitter._Channels[ImNodeGraphDrawLayer_NodeScratch];
+    ImDrawChannel& layer = splitter._Channels[ImNodeGraphDrawLayer_Nodes];
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const int count = (pass == 0) ? graph->NodeDrawSlots.Size : graph->NodeDraws.Size;
+        for (int n = 0; n < count; n++)
+        {
+            const int draw_n = (pass == 0) ? graph->NodeDrawSlots[n] : n;
+            if (draw_n == -1 || (pass == 1 && graph->Nodes.DrawOrder[graph->NodeDraws[n].NodeIdx] != -1))
+                continue;
+            int ranges[3][2];
+            GetNodeDrawRanges(graph->NodeDraws[draw_n], ranges);
+            for (int range_n = 0; range_n < 3; range_n++)
+                AppendDrawRange(scratch, &layer, ranges[range_n][0], ranges[range_n][1]);
+        }
+    }
+    scratch._CmdBuffer.resize(0);
+    scratch._IdxBuffer.resize(0);
+}
+
+void ImNodeGraph::SetPinTypeTable(const ImU64* rows, int type_count)
+{
+    IM_ASSERT(GImNodeGraph != NULL && type_count >= 0 && type_count <= 64);
+    ImVector<ImU64>& pin_type_rows = GImNodeGraph->PinTypeRows;
+    pin_type_rows.resize(rows ? type_count : 0);
+    if (rows)
+        memcpy(pin_type_rows.Data, rows, (size_t)type_count * sizeof(ImU64));
+}
+
+void ImNodeGraph::Pin(ImGuiID pin_id, const char* label, ImPinDirection direction, ImPinType type)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphData* graph = g.CurrentGraph;
+    IM_ASSERT(g.CurrentNode != 0 && "Pin() must be called between BeginNode() and EndNode()");
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    const int node_idx = ImNodeGraphHandleIndex(g.CurrentNode);
+
+    ImNodeGraphHandle pin = FindPin(graph, pin_id);
+    if (pin == 0)
+        pin = CreatePin(graph, g.CurrentNode, pin_id, direction, type);
+    IM_ASSERT(pins.Node[ImNodeGraphHandleIndex(pin)] == g.CurrentNode && "Pin ID used by two different nodes");
+    const int pin_idx = ImNodeGraphHandleIndex(pin);
+    pins.Direction[pin_idx] = direction;
+    pins.Type[pin_idx] = type;
+
+    // Outputs are right aligned against the width measured last frame
+    const char* label_end = ImGui::FindRenderedTextEnd(label);
+    const float label_width = CalcTextWidth(graph, label, label_end);
+    const float row_height = ImGui::GetFontSize();
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    if (direction == ImPinDirection_Output)
+    {
+        const float right = graph->CanvasToScreen(graph->GetNodeDisplayPos(node_idx)).x + (nodes.Size[node_idx].x - g.Style.NodePadding.x) * graph->Zoom;
+        pos.x = ImMax(pos.x, right - label_width);
+    }
+    ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(), ImGui::GetFontSize(), pos, g.Style.Colors[ImNodeGraphCol_PinLabel], label, label_end);
+    ImGui::ItemSize(ImVec2(label_width, row_height));
+    pins.Offset[pin_idx].y = graph->ScreenToCanvas(ImVec2(pos.x, pos.y + row_height * 0.5f)).y - graph->GetNodeDisplayPos(node_idx).y;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Links
+//-----------------------------------------------------------------------------
+
+void ImNodeGraph::Link(ImGuiID link_id, ImGuiID start_pin_id, ImGuiID end_pin_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "Link() must be called between BeginGraph() and EndGraph()");
+    const ImNodeGraphHandle start_pin = FindPin(graph, start_pin_id);
+    const ImNodeGraphHandle end_pin = FindPin(graph, end_pin_id);
+    const ImNodeGraphHandle link = FindLink(graph, link_id);
+    if (link != 0)
+    {
+        const int link_idx = ImNodeGraphHandleIndex(link);
+        if (graph->Links.StartPin[link_idx] == start_pin && graph->Links.EndPin[link_idx] == end_pin)
+            return;
+    }
+
+    // Both pins must exist, links to pins which were never submitted nor added are ignored until they do
+    const bool create = (start_pin != 0 && end_pin != 0 && start_pin != end_pin);
+    if (link == 0 && !create)
+        return;
+    BeginUndoGroup();
+    if (link != 0)
+        RemoveLink(link_id);
+    if (create)
+    {
+        CreateLink(graph, link_id, start_pin, end_pin);
+        if (graph->Undo.IsRecording())
+        {
+            BeginUndoRecord(graph);
+            graph->Undo.Put(&link_id, sizeof(ImGuiID));
+            graph->Undo.Put(&start_pin_id, sizeof(ImGuiID));
+            graph->Undo.Put(&end_pin_id, sizeof(ImGuiID));
+            EndUndoRecord(graph, ImNodeGraphUndoType_LinkAdded);
+        }
+    }
+    EndUndoGroup();
+}
+
+void ImNodeGraph::RemoveLink(ImGuiID link_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    const ImNodeGraphHandle link = FindLink(graph, link_id);
+    if (link == 0)
+        return;
+    if (graph->Undo.IsRecording())
+    {
+        const int link_idx = ImNodeGraphHandleIndex(link);
+        BeginUndoRecord(graph);
+        graph->Undo.Put(&link_id, sizeof(ImGuiID));
+        graph->Undo.Put(&graph->Pins.ID[ImNodeGraphHandleIndex(graph->Links.StartPin[link_idx])], sizeof(ImGuiID));
+        graph->Undo.Put(&graph->Pins.ID[ImNodeGraphHandleIndex(graph->Links.EndPin[link_idx])], sizeof(ImGuiID));
+        EndUndoRecord(graph, ImNodeGraphUndoType_LinkRemoved);
+    }
+    DestroyLink(graph, link);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Groups
+//-----------------------------------------------------------------------------
+
+int ImNodeGraph::GetVisibleAncestor(ImNodeGraphData* graph, int node_idx)
+{
+    const ImNodeGraphNodePool& nodes = graph->Nodes;
+    while (nodes.Hidden[node_idx])
+        node_idx = ImNodeGraphHandleIndex(nodes.Parent[node_idx]);
+    return node_idx;
+}
+
+void ImNodeGraph::UnlinkFromGroup(ImNodeGraphData* graph, int node_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    if (nodes.Parent[node_idx] == 0)
+        return;
+    const ImNodeGraphHandle node = nodes.Slots.GetHandle(node_idx);
+    ImNodeGraphHandle* next = &nodes.FirstChild[ImNodeGraphHandleIndex(nodes.Parent[node_idx])];
+    while (*next != 0 && *next != node)
+        next = &nodes.NextSibling[ImNodeGraphHandleIndex(*next)];
+    IM_ASSERT(*next == node);
+    *next = nodes.NextSibling[node_idx];
+    nodes.Parent[node_idx] = nodes.NextSibling[node_idx] = 0;
+}
+
+void ImNodeGraph::AddGroupBoundaryLink(ImNodeGraphData* graph, int group_idx, ImNodeGraphHandle link)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphGroupState* group = nodes.GroupState[group_idx];
+    nodes.GroupStateBytes -= group->CalcMemoryUsage();
+    group->BoundaryLinks.push_back(link);
+    nodes.GroupStateBytes += group->CalcMemoryUsage();
+}
+
+// Links leaving the group come in on its left edge and out of its right edge, halfway down
+ImVec2 ImNodeGraph::GetGroupBoundaryPinPos(ImNodeGraphData* graph, int group_idx, ImPinDirection direction)
+{
+    const ImRect rect = graph->GetNodeDisplayRect(group_idx);
+    return ImVec2((direction == ImPinDirection_Output) ? rect.Max.x : rect.Min.x, rect.GetCenter().y);
+}
+
+// Directions of the boundary pins drawn on a collapsed group, as 1 << ImPinDirection_. Drops the destroyed links.
+int ImNodeGraph::GetGroupBoundaryPins(ImNodeGraphData* graph, int group_idx)
+{
+    ImNodeGraphGroupState* group = graph->Nodes.GroupState[group_idx];
+    if (group == NULL)
+        return 0;
+    ImNodeGraphLinkPool& links = graph->Links;
+    int directions = 0;
+    int alive_count = 0;
+    for (int n = 0; n < group->BoundaryLinks.Size; n++)
+    {
+        const ImNodeGraphHandle link = group->BoundaryLinks[n];
+        if (!links.Slots.IsAlive(link))
+            continue;
+        group->BoundaryLinks[alive_count++] = link;
+        const int start_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.StartPin[ImNodeGraphHandleIndex(link)])]);
+        directions |= 1 << ((GetVisibleAncestor(graph, start_node_idx) == group_idx) ? ImPinDirection_Output : ImPinDirection_Input);
+    }
+    group->BoundaryLinks.resize(alive_count);
+    return directions;
+}
+
+void ImNodeGraph::UpdateGroupBoundary(ImNodeGraphData* graph, int group_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphGroupState* group = nodes.GroupState[group_idx];
+    IM_ASSERT(group != NULL && !nodes.Hidden[group_idx]);
+    nodes.GroupStateBytes -= group->CalcMemoryUsage();
+    group->BoundaryLinks.resize(0);
+
+    // A link is seen from both ends when they are both inside, where it isn't a boundary link
+    ImNodeGraphArenaVector<int>& stack = graph->GroupStack;
+    stack.resize(0);
+    for (ImNodeGraphHandle child = nodes.FirstChild[group_idx]; child != 0; child = nodes.NextSibling[ImNodeGraphHandleIndex(child)])
+        stack.push_back(ImNodeGraphHandleIndex(child));
+    while (!stack.empty())
+    {
+        const int node_idx = stack.back();
+        stack.resize(stack.Size - 1);
+        for (ImNodeGraphHandle child = nodes.FirstChild[node_idx]; child != 0; child = nodes.NextSibling[ImNodeGraphHandleIndex(child)])
+            stack.push_back(ImNodeGraphHandleIndex(child));
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+            for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(links, link, pin))
+            {
+                const int link_idx = ImNodeGraphHandleIndex(link);
+                const ImNodeGraphHandle other_pin = (links.StartPin[link_idx] == pin) ? links.EndPin[link_idx] : links.StartPin[link_idx];
+                if (GetVisibleAncestor(graph, ImNodeGraphHandleIndex(pins.Node[ImNodeGraphHandleIndex(other_pin)])) != group_idx)
+                    group->BoundaryLinks.push_back(link);
+            }
+    }
+    nodes.GroupStateBytes += group->CalcMemoryUsage();
+}
+
+// Take a node and its pins out of the spatial index and the selectable nodes, or put them back. Links are left to the caller.
+static void SetNodeHidden(ImNodeGraphData* graph, int node_idx, bool hidden)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    nodes.Hidden[node_idx] = hidden;
+    nodes.HiddenCount += hidden ? 1 : -1;
+    if (hidden)
+    {
+        ImNodeGraph::SetNodeSelected(graph, node_idx, false);
+        graph->Selection.RemoveSlot(node_idx);
+        ImNodeGraph::UpdateMinimapCell(graph, nodes.GridRange[node_idx], ImNodeGraphGridRange());
+        graph->NodeGrid.Remove(node_idx, &nodes.GridRange[node_idx]);
+        if (graph->Flags & ImNodeGraphFlags_OrthogonalLinks)
+            ImNodeGraph::InvalidateLinkRoutes(graph, nodes.RouteRect[node_idx]);
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+            graph->PinGrid.Remove(ImNodeGraphHandleIndex(pin), &pins.GridRange[ImNodeGraphHandleIndex(pin)]);
+        nodes.VisibleFrame[node_idx] = -1; // Not submitted for the rest of the frame either
+        nodes.FreeDrawCache(node_idx);
+    }
+    else
+    {
+        graph->Selection.AddSlot(node_idx);
+        const ImRect rect = nodes.GetRect(node_idx);
+        graph->NodeGrid.Update(node_idx, &nodes.GridRange[node_idx], rect);
+        ImNodeGraph::UpdateMinimapCell(graph, ImNodeGraphGridRange(), nodes.GridRange[node_idx]);
+        if (graph->Flags & ImNodeGraphFlags_OrthogonalLinks)
+        {
+            ImNodeGraph::InvalidateLinkRoutes(graph, rect);
+            nodes.RouteRect[node_idx] = rect;
+        }
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+        {
+            const int pin_idx = ImNodeGraphHandleIndex(pin);
+            const ImVec2 pos = nodes.Pos[node_idx] + pins.Offset[pin_idx];
+            graph->PinGrid.Update(pin_idx, &pins.GridRange[pin_idx], ImRect(pos, pos));
+        }
+    }
+}
+
+// Hide or show 'root_idx' and the nodes below it to match their ancestors, then refresh the links attached to them and
+// the boundary of the collapsed groups displayed among them. Only the subtree is visited, whatever the size of the graph.
+static void UpdateSubtreeVisibility(ImNodeGraphData* graph, int root_idx)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateGroupVisibility");
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphArenaVector<int>& subtree = graph->GroupNodes;
+    subtree.resize(0);
+    subtree.push_back(root_idx);
+    for (int n = 0; n < subtree.Size; n++)
+    {
+        // Breadth first, groups are visited before their nodes
+        const int node_idx = subtree[n];
+        const int parent_idx = nodes.Parent[node_idx] ? ImNodeGraphHandleIndex(nodes.Parent[node_idx]) : -1;
+        const bool hidden = (parent_idx != -1) && (nodes.Hidden[parent_idx] || nodes.Collapsed[parent_idx]);
+        if (hidden != nodes.Hidden[node_idx])
+            SetNodeHidden(graph, node_idx, hidden);
+        for (ImNodeGraphHandle child = nodes.FirstChild[node_idx]; child != 0; child = nodes.NextSibling[ImNodeGraphHandleIndex(child)])
+            subtree.push_back(ImNodeGraphHandleIndex(child));
+    }
+
+    // Links once every node is where it belongs
+    for (int n = 0; n < subtree.Size; n++)
+        for (ImNodeGraphHandle pin = nodes.FirstPin[subtree[n]]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+            for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(graph->Links, link, pin))
+                ImNodeGraph::UpdateLinkGeometry(graph, ImNodeGraphHandleIndex(link));
+    for (int n = 0; n < subtree.Size; n++)
+    {
+        const int node_idx = subtree[n];
+        ImNodeGraphGroupState* group = nodes.GroupState[node_idx];
+        if (group == NULL)
+            continue;
+        if (!nodes.Hidden[node_idx])
+            ImNodeGraph::UpdateGroupBoundary(graph, node_idx);
+        else
+            group->BoundaryLinks.resize(0);
+    }
+}
+
+void ImNodeGraph::MoveNodeToGroup(ImNodeGraphData* graph, int node_idx, int group_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    const ImNodeGraphHandle parent = (group_idx != -1) ? nodes.Slots.GetHandle(group_idx) : 0;
+    if (nodes.Parent[node_idx] == parent)
+        return;
+    for (int idx = group_idx; idx != -1; idx = nodes.Parent[idx] ? ImNodeGraphHandleIndex(nodes.Parent[idx]) : -1)
+        if (idx == node_idx)
+        {
+            IM_ASSERT(0 && "A node can't be moved into a group it holds");
+            return;
+        }
+    CommitDragGroup(graph);
+    const int old_boundary_idx = GetVisibleAncestor(graph, node_idx);
+    UnlinkFromGroup(graph, node_idx);
+    if (parent != 0)
+    {
+        nodes.NextSibling[node_idx] = nodes.FirstChild[group_idx];
+        nodes.FirstChild[group_idx] = nodes.Slots.GetHandle(node_idx);
+    }
+    nodes.Parent[node_idx] = parent;
+
+    // Nothing changes on screen when the node stays displayed, or stays hidden in the same collapsed group
+    const bool hidden = (parent != 0) && (nodes.Hidden[group_idx] || nodes.Collapsed[group_idx]);
+    if (hidden == nodes.Hidden[node_idx] && (!hidden || GetVisibleAncestor(graph, group_idx) == old_boundary_idx))
+        return;
+    UpdateSubtreeVisibility(graph, node_idx);
+    const int new_boundary_idx = GetVisibleAncestor(graph, node_idx);
+    if (old_boundary_idx != node_idx)
+        UpdateGroupBoundary(graph, old_boundary_idx);
+    if (new_boundary_idx != node_idx && new_boundary_idx != old_boundary_idx)
+        UpdateGroupBoundary(graph, new_boundary_idx);
+}
+
+void ImNodeGraph::CollapseGroup(ImNodeGraphData* graph, int group_idx, bool collapsed)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    if (nodes.Collapsed[group_idx] == collapsed)
+        return;
+    IMNODEGRAPH_PROFILE_ZONE("CollapseGroup");
+    CommitDragGroup(graph);
+    nodes.Collapsed[group_idx] = collapsed;
+    if (collapsed)
+    {
+        ImNodeGraphGroupState* group = nodes.GroupState[group_idx] = IM_NEW(ImNodeGraphGroupState)();
+        group->CollapsedPos = nodes.Pos[group_idx];
+        nodes.GroupStateBytes += group->CalcMemoryUsage();
+    }
+    else
+    {
+        // Inner nodes follow the group if it moved while collapsed, nested collapsed groups included
+        const ImVec2 offset = nodes.Pos[group_idx] - nodes.GroupState[group_idx]->CollapsedPos;
+        nodes.FreeGroupState(group_idx);
+        if (offset.x != 0.0f || offset.y != 0.0f)
+        {
+            ImNodeGraphArenaVector<int>& stack = graph->GroupStack;
+            stack.resize(0);
+            stack.push_back(group_idx);
+            while (!stack.empty())
+            {
+                const int node_idx = stack.back();
+                stack.resize(stack.Size - 1);
+                for (ImNodeGraphHandle child = nodes.FirstChild[node_idx]; child != 0; child = nodes.NextSibling[ImNodeGraphHandleIndex(child)])
+                {
+                    const int child_idx = ImNodeGraphHandleIndex(child);
+                    nodes.Pos[child_idx] += offset;
+                    if (nodes.GroupState[child_idx] != NULL)
+                        nodes.GroupState[child_idx]->CollapsedPos += offset;
+                    stack.push_back(child_idx);
+                }
+            }
+        }
+    }
+
+    // Nodes of a hidden group stay hidden either way
+    if (!nodes.Hidden[group_idx])
+        UpdateSubtreeVisibility(graph, group_idx);
+}
+
+void ImNodeGraph::SetNodeGroup(ImGuiID node_id, ImGuiID group_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SetNodeGroup() must be called between BeginGraph() and EndGraph()");
+    const ImNodeGraphHandle node = FindNode(graph, node_id);
+    const ImNodeGraphHandle group = (group_id != 0) ? FindNode(graph, group_id) : 0;
+    IM_ASSERT(node != 0 && (group_id == 0 || group != 0) && "SetNodeGroup() node or group doesn't exist");
+    if (node == 0 || (group_id != 0 && group == 0))
+        return;
+    MoveNodeToGroup(graph, ImNodeGraphHandleIndex(node), group ? ImNodeGraphHandleIndex(group) : -1);
+}
+
+ImGuiID ImNodeGraph::GetNodeGroup(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    const ImNodeGraphHandle node = FindNode(graph, node_id);
+    const ImNodeGraphHandle parent = node ? graph->Nodes.Parent[ImNodeGraphHandleIndex(node)] : 0;
+    return parent ? graph->Nodes.ID[ImNodeGraphHandleIndex(parent)] : 0;
+}
+
+void ImNodeGraph::SetGroupCollapsed(ImGuiID group_id, bool collapsed)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SetGroupCollapsed() must be called between BeginGraph() and EndGraph()");
+    const ImNodeGraphHandle group = FindNode(graph, group_id);
+    if (group != 0)
+        CollapseGroup(graph, ImNodeGraphHandleIndex(group), collapsed);
+}
+
+bool ImNodeGraph::IsGroupCollapsed(ImGuiID group_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    const ImNodeGraphHandle group = FindNode(graph, group_id);
+    return group != 0 && graph->Nodes.Collapsed[ImNodeGraphHandleIndex(group)];
+}
+
+bool ImNodeGraph::IsNodeHidden(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    const ImNodeGraphHandle node = FindNode(graph, node_id);
+    return node != 0 && graph->Nodes.Hidden[ImNodeGraphHandleIndex(node)];
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Link routing
+//-----------------------------------------------------------------------------
+
+// Buffers of RouteOrthogonalLink(), one set per thread routing links, the route job worker included
+struct ImNodeGraphRouteScratch
+{
+    ImNodeGraphWorkerVector<ImRect> Obstacles;      // Node rectangles to go around, inflated
+    ImNodeGraphWorkerVector<float> LinesX;          // Grid lines through the obstacle edges and the pin stubs
+    ImNodeGraphWorkerVector<float> LinesY;
+    ImNodeGraphWorkerVector<int> BlockedX;          // Obstacles covering each horizontal grid edge, (LinesX.Size + 1) per row
+    ImNodeGraphWorkerVector<int> BlockedY;          // Same for vertical edges
+    ImNodeGraphWorkerVector<float> Cost;            // Per grid point and direction of arrival
+    ImNodeGraphWorkerVector<int> Parent;
+    ImNodeGraphWorkerVector<ImU64> Open;            // Binary heap of (estimated cost bits << 32) | state
+    ImNodeGraphWorkerVector<ImVec2> Points;         // Result, from the output pin to the input pin
+
+    size_t CalcMemoryUsage() const
+    {
+        return ImNodeGraphVectorBytes(Obstacles) + ImNodeGraphVectorBytes(LinesX) + ImNodeGraphVectorBytes(LinesY) + ImNodeGraphVectorBytes(BlockedX) + ImNodeGraphVectorBytes(BlockedY)
+            + ImNodeGraphVectorBytes(Cost) + ImNodeGraphVectorBytes(Parent) + ImNodeGraphVectorBytes(Open) + ImNodeGraphVectorBytes(Points);
+    }
+};
+
+struct ImNodeGraphRouteTask
+{
+    ImNodeGraphHandle           Link;
+    ImU32                       RouteVersion;       // Result is dropped if the route went stale again meanwhile
+    ImVec2                      Start;
+    ImVec2                      End;
+    int                         ObstaclesOffset;
+    int                         ObstaclesCount;
+    int                         PointsOffset;
+    int                         PointsCount;
+};
+
+// Snapshot taken by UpdateLinkRoutes(). Only the worker thread touches it until Done is set.
+struct ImNodeGraphRouteJob
+{
+    float                       Margin;
+    ImVector<ImNodeGraphRouteTask> Tasks;
+    ImNodeGraphWorkerVector<ImRect> Obstacles;
+    ImNodeGraphWorkerVector<ImVec2> Points;         // Grown by the worker thread
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    std::thread*                Thread;
+    std::atomic<bool>           Cancel;
+    std::atomic<bool>           Done;
+#else
+    bool                        Cancel;
+    bool                        Done;
+#endif
+
+    ImNodeGraphRouteJob()
+    {
+        Margin = 0.0f;
+        Cancel = Done = false;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+        Thread = NULL;
+#endif
+    }
+};
+
+static int IMGUI_CDECL SortFloatComparer(const void* lhs, const void* rhs)
+{
+    const float a = *(const float*)lhs;
+    const float b = *(const float*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+static void SortRouteLines(ImNodeGraphWorkerVector<float>* lines)
+{
+    ImQsort(lines->Data, (size_t)lines->Size, sizeof(float), SortFloatComparer);
+    int count = 0;
+    for (int n = 0; n < lines->Size; n++)
+        if (count == 0 || (*lines)[n] != (*lines)[count - 1])
+            (*lines)[count++] = (*lines)[n];
+    lines->resize(count);
+}
+
+static int FindRouteLine(const ImNodeGraphWorkerVector<float>& lines, float v)
+{
+    int lo = 0, hi = lines.Size - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (lines[mid] < v)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Adds one over the inclusive range of grid edges, in a difference array summed once every obstacle is in
+static void AddRouteBlock(ImNodeGraphWorkerVector<int>* blocked, int stride, int x0, int y0, int x1, int y1)
+{
+    if (x0 > x1 || y0 > y1)
+        return;
+    (*blocked)[y0 * stride + x0]++;
+    (*blocked)[y0 * stride + x1 + 1]--;
+    (*blocked)[(y1 + 1) * stride + x0]--;
+    (*blocked)[(y1 + 1) * stride + x1 + 1]++;
+}
+
+static void SumRouteBlocks(ImNodeGraphWorkerVector<int>* blocked, int stride)
+{
+    const int rows = blocked->Size / stride;
+    for (int y = 0; y < rows; y++)
+        for (int x = 1; x < stride; x++)
+            (*blocked)[y * stride + x] += (*blocked)[y * stride + x - 1];
+    for (int y = 1; y < rows; y++)
+        for (int x = 0; x < stride; x++)
+            (*blocked)[y * stride + x] += (*blocked)[(y - 1) * stride + x];
+}
+
+// Costs are positive, their bits sort like the values
+static void PushRouteOpen(ImNodeGraphWorkerVector<ImU64>* heap, float cost, int state)
+{
+    ImU32 cost_bits;
+    memcpy(&cost_bits, &cost, sizeof(ImU32));
+    int n = heap->Size;
+    heap->push_back(((ImU64)cost_bits << 32) | (ImU32)state);
+    const ImU64 v = (*heap)[n];
+    for (; n > 0 && (*heap)[(n - 1) / 2] > v; n = (n - 1) / 2)
+        (*heap)[n] = (*heap)[(n - 1) / 2];
+    (*heap)[n] = v;
+}
+
+static ImU64 PopRouteOpen(ImNodeGraphWorkerVector<ImU64>* heap)
+{
+    const ImU64 top = (*heap)[0];
+    const ImU64 v = heap->back();
+    heap->pop_back();
+    const int size = heap->Size;
+    int n = 0;
+    while (n * 2 + 1 < size)
+    {
+        int child = n * 2 + 1;
+        if (child + 1 < size && (*heap)[child + 1] < (*heap)[child])
+            child++;
+        if (v <= (*heap)[child])
+            break;
+        (*heap)[n] = (*heap)[child];
+        n = child;
+    }
+    if (size > 0)
+        (*heap)[n] = v;
+    return top;
+}
+
+// Drops repeated points and the middle of straight runs. A link always keeps a segment, even between overlapping pins.
+static int CollapseRoutePoints(ImVec2* points, int count)
+{
+    int out_count = 1;
+    for (int n = 1; n < count; n++)
+    {
+        const ImVec2 p = points[n];
+        if (p == points[out_count - 1])
+            continue;
+        if (out_count >= 2)
+        {
+            const ImVec2 a = points[out_count - 2];
+            const ImVec2 b = points[out_count - 1];
+            if ((a.x == b.x && b.x == p.x) || (a.y == b.y && b.y == p.y))
+                out_count--;
+        }
+        points[out_count++] = p;
+    }
+    if (out_count == 1)
+        points[out_count++] = points[0];
+    return out_count;
+}
+
+// Stubs leave the output pin to the right and enter the input pin from the left, then meet halfway. Inputs on the left
+// of their output are reached with a horizontal run halfway between the two pins.
+int ImNodeGraph::BuildElbowRoute(const ImVec2& start, const ImVec2& end, float margin, ImVec2 out_points[6])
+{
+    const ImVec2 a(start.x + margin, start.y);
+    const ImVec2 b(end.x - margin, end.y);
+    int count = 0;
+    out_points[count++] = start;
+    if (b.x >= a.x)
+    {
+        const float mid_x = (a.x + b.x) * 0.5f;
+        out_points[count++] = ImVec2(mid_x, start.y);
+        out_points[count++] = ImVec2(mid_x, end.y);
+    }
+    else
+    {
+        const float mid_y = (a.y + b.y) * 0.5f;
+        out_points[count++] = a;
+        out_points[count++] = ImVec2(a.x, mid_y);
+        out_points[count++] = ImVec2(b.x, mid_y);
+        out_points[count++] = b;
+    }
+    out_points[count++] = end;
+    return CollapseRoutePoints(out_points, count);
+}
+
+// A* over the sparse grid made of the lines through every obstacle edge and both pin stubs: shortest paths made of
+// horizontal and vertical runs always exist on it. States are grid points along with the direction they were entered
+// from, so bends are charged for. Edges running inside an obstacle are blocked, the ones along its border are not.
+// Touches nothing but 'scratch', safe to call from any thread. Falls back to an elbow when no path exists.
+static void RouteOrthogonalLink(const ImVec2& start, const ImVec2& end, float margin, ImNodeGraphRouteScratch* scratch)
+{
+    const ImVec2 a(start.x + margin, start.y);
+    const ImVec2 b(end.x - margin, end.y);
+    ImNodeGraphWorkerVector<float>& xs = scratch->LinesX;
+    ImNodeGraphWorkerVector<float>& ys = scratch->LinesY;
+    xs.resize(0);
+    ys.resize(0);
+    xs.push_back(a.x);
+    xs.push_back(b.x);
+    xs.push_back((a.x + b.x) * 0.5f);
+    ys.push_back(a.y);
+    ys.push_back(b.y);
+    ys.push_back((a.y + b.y) * 0.5f);
+    for (int n = 0; n < scratch->Obstacles.Size; n++)
+    {
+        const ImRect& rect = scratch->Obstacles[n];
+        xs.push_back(rect.Min.x);
+        xs.push_back(rect.Max.x);
+        ys.push_back(rect.Min.y);
+        ys.push_back(rect.Max.y);
+    }
+    SortRouteLines(&xs);
+    SortRouteLines(&ys);
+    const int nx = xs.Size;
+    const int ny = ys.Size;
+
+    const int stride = nx + 1;
+    scratch->BlockedX.resize(stride * (ny + 1));
+    scratch->BlockedY.resize(stride * (ny + 1));
+    memset(scratch->BlockedX.Data, 0, (size_t)scratch->BlockedX.Size * sizeof(int));
+    memset(scratch->BlockedY.Data, 0, (size_t)scratch->BlockedY.Size * sizeof(int));
+    for (int n = 0; n < scratch->Obstacles.Size; n++)
+    {
+        const ImRect& rect = scratch->Obstacles[n];
+        const int x0 = FindRouteLine(xs, rect.Min.x), x1 = FindRouteLine(xs, rect.Max.x);
+        const int y0 = FindRouteLine(ys, rect.Min.y), y1 = FindRouteLine(ys, rect.Max.y);
+        AddRouteBlock(&scratch->BlockedX, stride, x0, y0 + 1, x1 - 1, y1 - 1);
+        AddRouteBlock(&scratch->BlockedY, stride, x0 + 1, y0, x1 - 1, y1 - 1);
+    }
+    SumRouteBlocks(&scratch->BlockedX, stride);
+    SumRouteBlocks(&scratch->BlockedY, stride);
+
+    // Directions: 0 = +x, 1 = -x, 2 = +y, 3 = -y. The path leaves the start stub going right and should enter the end
+    // stub going right as well.
+    static const int dir_x[4] = { 1, -1, 0, 0 };
+    static const int dir_y[4] = { 0, 0, 1, -1 };
+    const float bend_cost = ImMax(margin, 1.0f) * 2.0f;
+    const int goal_x = FindRouteLine(xs, b.x), goal_y = FindRouteLine(ys, b.y);
+    const int start_state = (FindRouteLine(ys, a.y) * nx + FindRouteLine(xs, a.x)) * 4;
+    scratch->Cost.resize(nx * ny * 4);
+    scratch->Parent.resize(nx * ny * 4);
+    for (int n = 0; n < scratch->Cost.Size; n++)
+        scratch->Cost[n] = FLT_MAX;
+    scratch->Open.resize(0);
+    scratch->Cost[start_state] = 0.0f;
+    scratch->Parent[start_state] = -1;
+    PushRouteOpen(&scratch->Open, ImFabs(a.x - b.x) + ImFabs(a.y - b.y), start_state);
+    int goal_state = -1;
+    while (scratch->Open.Size > 0)
+    {
+        const ImU64 top = PopRouteOpen(&scratch->Open);
+        const int state = (int)(ImU32)top;
+        const int point = state >> 2, dir = state & 3;
+        const int x = point % nx, y = point / nx;
+        const float cost = scratch->Cost[state];
+        const float estimate = cost + ImFabs(xs[x] - b.x) + ImFabs(ys[y] - b.y);
+        ImU32 estimate_bits;
+        memcpy(&estimate_bits, &estimate, sizeof(ImU32));
+        if ((ImU32)(top >> 32) > estimate_bits)
+            continue; // Reached again for less since pushed
+        if (x == goal_x && y == goal_y)
+        {
+            goal_state = state;
+            break;
+        }
+        for (int d = 0; d < 4; d++)
+        {
+            if (d == (dir ^ 1))
+                continue;
+            const int next_x = x + dir_x[d], next_y = y + dir_y[d];
+            if (next_x < 0 || next_x >= nx || next_y < 0 || next_y >= ny)
+                continue;
+            const bool blocked = (d < 2) ? scratch->BlockedX[y * stride + ImMin(x, next_x)] > 0 : scratch->BlockedY[ImMin(y, next_y) * stride + x] > 0;
+            if (blocked)
+                continue;
+            float next_cost = cost + ImFabs(xs[next_x] - xs[x]) + ImFabs(ys[next_y] - ys[y]);
+            if (d != dir)
+                next_cost += bend_cost;
+            if (next_x == goal_x && next_y == goal_y && d != 0)
+                next_cost += bend_cost;
+            const int next_state = ((next_y * nx + next_x) << 2) | d;
+            if (next_cost >= scratch->Cost[next_state])
+                continue;
+            scratch->Cost[next_state] = next_cost;
+            scratch->Parent[next_state] = state;
+            PushRouteOpen(&scratch->Open, next_cost + ImFabs(xs[next_x] - b.x) + ImFabs(ys[next_y] - b.y), next_state);
+        }
+    }
+
+    ImNodeGraphWorkerVector<ImVec2>& points = scratch->Points;
+    points.resize(0);
+    if (goal_state < 0)
+    {
+        ImVec2 elbow[6];
+        const int count = ImNodeGraph::BuildElbowRoute(start, end, margin, elbow);
+        points.resize(count);
+        memcpy(points.Data, elbow, (size_t)count * sizeof(ImVec2));
+        return;
+    }
+    points.push_back(end);
+    for (int state = goal_state; state >= 0; state = scratch->Parent[state])
+        points.push_back(ImVec2(xs[(state >> 2) % nx], ys[(state >> 2) / nx]));
+    points.push_back(start);
+    for (int n = 0; n < points.Size / 2; n++)
+        ImSwap(points[n], points[points.Size - 1 - n]);
+    points.resize(CollapseRoutePoints(points.Data, points.Size));
+}
+
+// Nodes around both stubs, inflated by half the margin so routes keep clear of them while the stubs stay outside.
+// Past IMNODEGRAPH_ROUTE_MAX_OBSTACLES only the closest to the stubs are kept.
+static void GatherRouteObstacles(ImNodeGraphData* graph, const ImVec2& start, const ImVec2& end, ImNodeGraphWorkerVector<ImRect>* out_obstacles)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    const float margin = GImNodeGraph->Style.LinkRouteMargin;
+    const ImVec2 a(start.x + margin, start.y);
+    const ImVec2 b(end.x - margin, end.y);
+    ImRect area(ImMin(a, b), ImMax(a, b));
+    area.Expand(margin * 8.0f);
+    graph->RouteQuery.resize(0);
+    graph->NodeGrid.Query(area, &graph->RouteQuery);
+
+    const int first = out_obstacles->Size;
+    for (int n = 0; n < graph->RouteQuery.Size; n++)
+    {
+        ImRect rect = nodes.GetRect(graph->RouteQuery[n]);
+        if (!rect.Overlaps(area))
+            continue;
+        rect.Expand(margin * 0.5f);
+        const bool contains_a = (a.x > rect.Min.x && a.x < rect.Max.x && a.y > rect.Min.y && a.y < rect.Max.y);
+        const bool contains_b = (b.x > rect.Min.x && b.x < rect.Max.x && b.y > rect.Min.y && b.y < rect.Max.y);
+        if (!contains_a && !contains_b)
+            out_obstacles->push_back(rect);
+    }
+    const int count = out_obstacles->Size - first;
+    if (count <= IMNODEGRAPH_ROUTE_MAX_OBSTACLES)
+        return;
+
+    // Distance from the obstacle center to the box spanned by the stubs, with the obstacle index in the low bits
+    ImVector<ImU64> sort_buffer;
+    sort_buffer.resize(count);
+    const ImRect stubs(ImMin(a, b), ImMax(a, b));
+    for (int n = 0; n < count; n++)
+    {
+        const ImVec2 center = (*out_obstacles)[first + n].GetCenter();
+        const ImVec2 delta = center - ImClamp(center, stubs.Min, stubs.Max);
+        const float dist = ImFabs(delta.x) + ImFabs(delta.y);
+        ImU32 dist_bits;
+        memcpy(&dist_bits, &dist, sizeof(ImU32));
+        sort_buffer[n] = ((ImU64)dist_bits << 32) | (ImU32)n;
+    }
+    ImQsort(sort_buffer.Data, (size_t)count, sizeof(ImU64), SortU64Comparer);
+    ImVector<ImRect> kept;
+    kept.resize(IMNODEGRAPH_ROUTE_MAX_OBSTACLES);
+    for (int n = 0; n < IMNODEGRAPH_ROUTE_MAX_OBSTACLES; n++)
+        kept[n] = (*out_obstacles)[first + (int)(ImU32)sort_buffer[n]];
+    memcpy(&(*out_obstacles)[first], kept.Data, (size_t)kept.Size * sizeof(ImRect));
+    out_obstacles->resize(first + IMNODEGRAPH_ROUTE_MAX_OBSTACLES);
+}
+
+static void RunRouteJob(ImNodeGraphRouteJob* job)
+{
+    ImNodeGraphRouteScratch scratch;
+    for (int n = 0; n < job->Tasks.Size && !job->Cancel; n++)
+    {
+        ImNodeGraphRouteTask& task = job->Tasks[n];
+        scratch.Obstacles.resize(task.ObstaclesCount);
+        if (task.ObstaclesCount > 0)
+            memcpy(scratch.Obstacles.Data, &job->Obstacles[task.ObstaclesOffset], (size_t)task.ObstaclesCount * sizeof(ImRect));
+        RouteOrthogonalLink(task.Start, task.End, job->Margin, &scratch);
+        task.PointsOffset = job->Points.Size;
+        task.PointsCount = scratch.Points.Size;
+        job->Points.resize(job->Points.Size + scratch.Points.Size);
+        memcpy(&job->Points[task.PointsOffset], scratch.Points.Data, (size_t)scratch.Points.Size * sizeof(ImVec2));
+    }
+    job->Done = true;
+}
+
+// Routed links keep their points at every zoom level. Bounds follow the route so culling and hovering stay exact.
+void ImNodeGraph::SetLinkRoute(ImNodeGraphData* graph, int link_idx, const ImVec2* points, int count)
+{
+    ImNodeGraphLinkGeometry& geom = graph->Links.Geometry[link_idx];
+    memcpy(AllocLinkPoints(graph, link_idx, count), points, (size_t)count * sizeof(ImVec2));
+    ImRect bounds(points[0], points[0]);
+    for (int n = 1; n < count; n++)
+        bounds.Add(points[n]);
+    geom.Segments = count - 1;
+    geom.Bounds = bounds;
+    graph->LinkGrid.Update(link_idx, &geom.GridRange, geom.Bounds);
+}
+
+// The old route stays displayed until the new one comes in
+void ImNodeGraph::InvalidateLinkRoutes(ImNodeGraphData* graph, const ImRect& rect)
+{
+    if (rect.Min.x > rect.Max.x)
+        return;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImRect area = rect;
+    area.Expand(GImNodeGraph->Style.LinkRouteMargin);
+    graph->RouteQuery.resize(0);
+    graph->LinkGrid.Query(area, &graph->RouteQuery);
+    for (int n = 0; n < graph->RouteQuery.Size; n++)
+    {
+        ImNodeGraphLinkGeometry& geom = links.Geometry[graph->RouteQuery[n]];
+        if (!geom.Bounds.Overlaps(area))
+            continue;
+        geom.RouteStale = true;
+        geom.RouteVersion++;
+    }
+}
+
+void ImNodeGraph::UpdateLinkRoutes(ImNodeGraphData* graph)
+{
+    IMNODEGRAPH_PROFILE_ZONE("UpdateLinkRoutes");
+    ImNodeGraphLinkPool& links = graph->Links;
+    const float margin = GImNodeGraph->Style.LinkRouteMargin;
+
+    // Results of the worker thread, for the links which didn't go stale again since
+    ImNodeGraphRouteJob* job = graph->RouteJob;
+    if (job != NULL && job->Done)
+    {
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+        job->Thread->join();
+        IM_DELETE(job->Thread);
+#endif
+        for (int n = 0; n < job->Tasks.Size; n++)
+        {
+            const ImNodeGraphRouteTask& task = job->Tasks[n];
+            if (!links.Slots.IsAlive(task.Link))
+                continue;
+            const int link_idx = ImNodeGraphHandleIndex(task.Link);
+            if (links.Geometry[link_idx].RouteVersion != task.RouteVersion)
+                continue;
+            SetLinkRoute(graph, link_idx, &job->Points[task.PointsOffset], task.PointsCount);
+            links.Geometry[link_idx].RouteStale = false;
+            graph->Stats.LinksTessellated++;
+        }
+        IM_DELETE(job);
+        graph->RouteJob = job = NULL;
+    }
+
+    // A few routes are computed right away, so the links of a dragged node follow it without lagging behind
+    if (graph->RouteScratch == NULL)
+        graph->RouteScratch = IM_NEW(ImNodeGraphRouteScratch)();
+    ImNodeGraphRouteScratch* scratch = graph->RouteScratch;
+    int routed_count = 0;
+    int pending_count = 0;
+    for (int n = 0; n < graph->StaleRoutes.Size; n++)
+    {
+        const int link_idx = graph->StaleRoutes[n];
+        ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+        if (!geom.RouteStale)
+            continue;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+        if (routed_count >= IMNODEGRAPH_ROUTE_SYNC_LIMIT)
+        {
+            graph->StaleRoutes[pending_count++] = link_idx;
+            continue;
+        }
+#endif
+        scratch->Obstacles.resize(0);
+        GatherRouteObstacles(graph, geom.Start, geom.End, &scratch->Obstacles);
+        RouteOrthogonalLink(geom.Start, geom.End, margin, scratch);
+        SetLinkRoute(graph, link_idx, scratch->Points.Data, scratch->Points.Size);
+        geom.RouteStale = false;
+        graph->Stats.LinksTessellated++;
+        routed_count++;
+    }
+    graph->StaleRoutes.resize(pending_count);
+
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    // The rest goes to the worker thread, what goes stale while it runs waits for the next one
+    if (pending_count == 0 || graph->RouteJob != NULL)
+        return;
+    job = IM_NEW(ImNodeGraphRouteJob)();
+    job->Margin = margin;
+    job->Tasks.resize(pending_count);
+    for (int n = 0; n < pending_count; n++)
+    {
+        const int link_idx = graph->StaleRoutes[n];
+        const ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+        ImNodeGraphRouteTask& task = job->Tasks[n];
+        task.Link = links.Slots.GetHandle(link_idx);
+        task.RouteVersion = geom.RouteVersion;
+        task.Start = geom.Start;
+        task.End = geom.End;
+        task.ObstaclesOffset = job->Obstacles.Size;
+        GatherRouteObstacles(graph, geom.Start, geom.End, &job->Obstacles);
+        task.ObstaclesCount = job->Obstacles.Size - task.ObstaclesOffset;
+        task.PointsOffset = task.PointsCount = 0;
+    }
+    job->Thread = IM_NEW(std::thread)(RunRouteJob, job);
+    graph->RouteJob = job;
+#endif
+}
+
+void ImNodeGraph::CancelRouteJob(ImNodeGraphData* graph)
+{
+    ImNodeGraphRouteJob* job = graph->RouteJob;
+    if (job == NULL)
+        return;
+    job->Cancel = true;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    job->Thread->join();
+    IM_DELETE(job->Thread);
+#endif
+    IM_DELETE(job);
+    graph->RouteJob = NULL;
+}
+
+// Links switched between curves and routes: every geometry is built again, routes start tracking node rectangles
+void ImNodeGraph::ResetLinkRoutes(ImNodeGraphData* graph)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphLinkPool& links = graph->Links;
+    CancelRouteJob(graph);
+    for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+        if (nodes.Slots.IsSlotAlive(node_idx))
+            nodes.RouteRect[node_idx] = nodes.GetRect(node_idx);
+    for (int link_idx = 0; link_idx < links.Slots.GetSize(); link_idx++)
+    {
+        if (!links.Slots.IsSlotAlive(link_idx))
+            continue;
+        ImNodeGraphLinkGeometry& geom = links.Geometry[link_idx];
+        geom.Start = geom.End = ImVec2(FLT_MAX, FLT_MAX);
+        geom.RouteStale = false;
+        UpdateLinkGeometry(graph, link_idx);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Undo history
+//-----------------------------------------------------------------------------
+
+void ImNodeGraphUndoHistory::Write(ImU64 pos, const void* src, int size)
+{
+    const int offset = (int)(pos % (ImU64)Buffer.Size);
+    const int first = ImMin(size, Buffer.Size - offset);
+    memcpy(Buffer.Data + offset, src, (size_t)first);
+    memcpy(Buffer.Data, (const ImU8*)src + first, (size_t)(size - first));
+}
+
+void ImNodeGraphUndoHistory::Read(ImU64 pos, void* dst, int size) const
+{
+    const int offset = (int)(pos % (ImU64)Buffer.Size);
+    const int first = ImMin(size, Buffer.Size - offset);
+    memcpy(dst, Buffer.Data + offset, (size_t)first);
+    memcpy((ImU8*)dst + first, Buffer.Data, (size_t)(size - first));
+}
+
+void ImNodeGraph::BeginUndoRecord(ImNodeGraphData* graph)
+{
+    // Header is filled by EndUndoRecord()
+    graph->Undo.Scratch.resize(IMNODEGRAPH_UNDO_HEADER_SIZE);
+}
+
+// Drop the oldest step, a step truncated by an earlier drop goes as a whole too
+static void DropOldestUndoStep(ImNodeGraphUndoHistory& undo)
+{
+    do
+    {
+        ImU32 size;
+        undo.Read(undo.Begin, &size, sizeof(ImU32));
+        undo.Begin += size;
+        if (undo.Begin == undo.End)
+            break;
+        ImU8 flags;
+        undo.Read(undo.Begin + 5, &flags, 1);
+        if (flags & ImNodeGraphUndoRecordFlags_StepBegin)
+            break;
+    }
+    while (true);
+    undo.Cursor = ImMax(undo.Cursor, undo.Begin);
+}
+
+void ImNodeGraph::EndUndoRecord(ImNodeGraphData* graph, ImNodeGraphUndoType type)
+{
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    undo.MergeRecord = ~(ImU64)0;
+    const ImU32 size = (ImU32)(undo.Scratch.Size + IMNODEGRAPH_UNDO_TRAILER_SIZE);
+    if (size > (ImU32)undo.Buffer.Size)
+    {
+        // Doesn't fit the budget: this edit can't be undone, and neither can the ones before it
+        undo.Clear();
+        return;
+    }
+    const ImU8 flags = (undo.GroupDepth == 0 || !undo.GroupHasRecord) ? ImNodeGraphUndoRecordFlags_StepBegin : ImNodeGraphUndoRecordFlags_None;
+    undo.GroupHasRecord = (undo.GroupDepth > 0);
+    undo.Put(&size, sizeof(ImU32));
+    memcpy(undo.Scratch.Data, &size, sizeof(ImU32));
+    undo.Scratch[4] = (ImU8)type;
+    undo.Scratch[5] = flags;
+
+    // A new edit discards what could be redone
+    undo.End = undo.Cursor;
+    while (undo.End + size - undo.Begin > (ImU64)undo.Buffer.Size)
+        DropOldestUndoStep(undo);
+    undo.Write(undo.End, undo.Scratch.Data, (int)size);
+    undo.End += size;
+    undo.Cursor = undo.End;
+}
+
+void ImNodeGraph::RecordNodeDeleted(ImNodeGraphData* graph, int node_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    BeginUndoRecord(graph);
+    undo.Put(&nodes.ID[node_idx], sizeof(ImGuiID));
+    undo.Put(&nodes.Pos[node_idx], sizeof(ImVec2));
+    undo.Put(&nodes.Size[node_idx], sizeof(ImVec2));
+    const int counts_offset = undo.Scratch.Size;
+    int pin_count = 0, link_count = 0;
+    undo.Put(&pin_count, sizeof(int));
+    undo.Put(&link_count, sizeof(int));
+    for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)], pin_count++)
+    {
+        const int pin_idx = ImNodeGraphHandleIndex(pin);
+        undo.Put(&pins.ID[pin_idx], sizeof(ImGuiID));
+        undo.Put(&pins.Direction[pin_idx], sizeof(ImPinDirection));
+        undo.Put(&pins.Type[pin_idx], sizeof(ImPinType));
+        undo.Put(&pins.Offset[pin_idx], sizeof(ImVec2));
+    }
+
+    // Links between two pins of the node are seen twice, keep them from their end pin
+    const ImNodeGraphHandle node = nodes.Slots.GetHandle(node_idx);
+    for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+        for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(links, link, pin))
+        {
+            const int link_idx = ImNodeGraphHandleIndex(link);
+            if (links.StartPin[link_idx] == pin && pins.Node[ImNodeGraphHandleIndex(links.EndPin[link_idx])] == node)
+                continue;
+            undo.Put(&links.ID[link_idx], sizeof(ImGuiID));
+            undo.Put(&pins.ID[ImNodeGraphHandleIndex(links.StartPin[link_idx])], sizeof(ImGuiID));
+            undo.Put(&pins.ID[ImNodeGraphHandleIndex(links.EndPin[link_idx])], sizeof(ImGuiID));
+            link_count++;
+        }
+    memcpy(undo.Scratch.Data + counts_offset, &pin_count, sizeof(int));
+    memcpy(undo.Scratch.Data + counts_offset + sizeof(int), &link_count, sizeof(int));
+    EndUndoRecord(graph, ImNodeGraphUndoType_NodeDeleted);
+}
+
+void ImNodeGraph::RecordNodesMoved(ImNodeGraphData* graph, const ImVec2& offset)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    BeginUndoRecord(graph);
+    undo.Put(&offset, sizeof(ImVec2));
+    const int count_offset = undo.Scratch.Size;
+    int count = 0;
+    undo.Put(&count, sizeof(int));
+    const ImNodeGraphSelection& sel = graph->Selection;
+    for (int node_idx = sel.FindNext(0); node_idx != -1; node_idx = sel.FindNext(node_idx + 1))
+    {
+        undo.Put(&nodes.ID[node_idx], sizeof(ImGuiID));
+        count++;
+    }
+    memcpy(undo.Scratch.Data + count_offset, &count, sizeof(int));
+    EndUndoRecord(graph, ImNodeGraphUndoType_NodesMoved);
+}
+
+static void MoveNodeTo(ImNodeGraphData* graph, ImGuiID node_id, const ImVec2& pos)
+{
+    if (ImNodeGraphHandle node = ImNodeGraph::FindNode(graph, node_id))
+    {
+        graph->Nodes.Pos[ImNodeGraphHandleIndex(node)] = pos;
+        ImNodeGraph::UpdateNodeBounds(graph, ImNodeGraphHandleIndex(node));
+    }
+}
+
+static void CreateLinkByIDs(ImNodeGraphData* graph, ImGuiID link_id, ImGuiID start_pin_id, ImGuiID end_pin_id)
+{
+    const ImNodeGraphHandle start_pin = ImNodeGraph::FindPin(graph, start_pin_id);
+    const ImNodeGraphHandle end_pin = ImNodeGraph::FindPin(graph, end_pin_id);
+    if (start_pin != 0 && end_pin != 0 && start_pin != end_pin && ImNodeGraph::FindLink(graph, link_id) == 0)
+        ImNodeGraph::CreateLink(graph, link_id, start_pin, end_pin);
+}
+
+// Elements which are already in the target state are left alone, so the history survives edits made behind its back
+void ImNodeGraph::ApplyUndoRecord(ImNodeGraphData* graph, bool undo_it)
+{
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    int offset = 4;
+    ImU8 type;
+    undo.Get(&offset, &type, 1);
+    offset = IMNODEGRAPH_UNDO_HEADER_SIZE;
+    ImGuiID id, other_id, third_id;
+    ImVec2 pos, other_pos;
+    switch (type)
+    {
+    case ImNodeGraphUndoType_NodeCreated:
+    case ImNodeGraphUndoType_NodeDeleted:
+    {
+        undo.Get(&offset, &id, sizeof(ImGuiID));
+        undo.Get(&offset, &pos, sizeof(ImVec2));
+        const bool create = (type == ImNodeGraphUndoType_NodeCreated) != undo_it;
+        if (!create)
+        {
+            DestroyNode(graph, FindNode(graph, id));
+            break;
+        }
+        if (FindNode(graph, id) != 0)
+            break;
+        const ImNodeGraphHandle node = CreateNode(graph, id, pos);
+        if (type == ImNodeGraphUndoType_NodeCreated)
+            break;
+        const int node_idx = ImNodeGraphHandleIndex(node);
+        int pin_count, link_count;
+        undo.Get(&offset, &graph->Nodes.Size[node_idx], sizeof(ImVec2));
+        undo.Get(&offset, &pin_count, sizeof(int));
+        undo.Get(&offset, &link_count, sizeof(int));
+        for (int n = 0; n < pin_count; n++)
+        {
+            ImPinDirection direction;
+            ImPinType pin_type;
+            undo.Get(&offset, &other_id, sizeof(ImGuiID));
+            undo.Get(&offset, &direction, sizeof(ImPinDirection));
+            undo.Get(&offset, &pin_type, sizeof(ImPinType));
+            undo.Get(&offset, &other_pos, sizeof(ImVec2));
+            if (FindPin(graph, other_id) != 0)
+                continue;
+            const ImNodeGraphHandle pin = CreatePin(graph, node, other_id, direction, pin_type);
+            graph->Pins.Offset[ImNodeGraphHandleIndex(pin)] = other_pos;
+        }
+        UpdateNodeBounds(graph, node_idx);
+        for (int n = 0; n < link_count; n++)
+        {
+            undo.Get(&offset, &id, sizeof(ImGuiID));
+            undo.Get(&offset, &other_id, sizeof(ImGuiID));
+            undo.Get(&offset, &third_id, sizeof(ImGuiID));
+            CreateLinkByIDs(graph, id, other_id, third_id);
+        }
+        break;
+    }
+    case ImNodeGraphUndoType_NodeMoved:
+        undo.Get(&offset, &id, sizeof(ImGuiID));
+        undo.Get(&offset, &pos, sizeof(ImVec2));
+        undo.Get(&offset, &other_pos, sizeof(ImVec2));
+        MoveNodeTo(graph, id, undo_it ? pos : other_pos);
+        break;
+    case ImNodeGraphUndoType_NodesMoved:
+    {
+        int count;
+        undo.Get(&offset, &pos, sizeof(ImVec2));
+        undo.Get(&offset, &count, sizeof(int));
+        const ImVec2 delta = undo_it ? -pos : pos;
+        for (int n = 0; n < count; n++)
+        {
+            undo.Get(&offset, &id, sizeof(ImGuiID));
+            if (ImNodeGraphHandle node = FindNode(graph, id))
+                MoveNodeTo(graph, id, graph->Nodes.Pos[ImNodeGraphHandleIndex(node)] + delta);
+        }
+        break;
+    }
+    case ImNodeGraphUndoType_PinCreated:
+    {
+        ImPinDirection direction;
+        ImPinType pin_type;
+        undo.Get(&offset, &id, sizeof(ImGuiID));
+        undo.Get(&offset, &other_id, sizeof(ImGuiID));
+        undo.Get(&offset, &direction, sizeof(ImPinDirection));
+        undo.Get(&offset, &pin_type, sizeof(ImPinType));
+        if (undo_it)
+            DestroyPin(graph, FindPin(graph, id));
+        else if (ImNodeGraphHandle node = FindNode(graph, other_id))
+            if (FindPin(graph, id) == 0)
+                CreatePin(graph, node, id, direction, pin_type);
+        break;
+    }
+    case ImNodeGraphUndoType_LinkAdded:
+    case ImNodeGraphUndoType_LinkRemoved:
+        undo.Get(&offset, &id, sizeof(ImGuiID));
+        undo.Get(&offset, &other_id, sizeof(ImGuiID));
+        undo.Get(&offset, &third_id, sizeof(ImGuiID));
+        if ((type == ImNodeGraphUndoType_LinkAdded) != undo_it)
+            CreateLinkByIDs(graph, id, other_id, third_id);
+        else
+            DestroyLink(graph, FindLink(graph, id));
+        break;
+    case ImNodeGraphUndoType_PropertyChanged:
+    {
+        int size;
+        undo.Get(&offset, &id, sizeof(ImGuiID));
+        undo.Get(&offset, &other_id, sizeof(ImGuiID));
+        undo.Get(&offset, &size, sizeof(int));
+        if (undo.PropertyCallback != NULL)
+            undo.PropertyCallback(id, other_id, undo.Scratch.Data + offset + (undo_it ? 0 : size), size, undo.PropertyUserData);
+        break;
+    }
+    default:
+        IM_ASSERT(0);
+        break;
+    }
+}
+
+void ImNodeGraph::SetUndoBudget(int bytes)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SetUndoBudget() must be called between BeginGraph() and EndGraph()");
+    IM_ASSERT(bytes >= 0);
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    if (bytes == undo.Buffer.Size)
+        return;
+
+    // Keep the most recent steps which fit the new budget
+    ImVector<ImU8> records;
+    while (undo.End - undo.Begin > (ImU64)bytes)
+        DropOldestUndoStep(undo);
+    const int size = (int)(undo.End - undo.Begin);
+    records.resize(size);
+    if (size > 0)
+        undo.Read(undo.Begin, records.Data, size);
+    const ImU64 cursor = undo.Cursor - undo.Begin;
+    undo.Buffer.resize(bytes);
+    undo.Buffer.shrink(bytes);
+    undo.Clear();
+    if (size > 0)
+        undo.Write(0, records.Data, size);
+    undo.End = (ImU64)size;
+    undo.Cursor = cursor;
+}
+
+void ImNodeGraph::SetUndoPropertyCallback(ImNodeGraphPropertyCallback callback, void* user_data)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    graph->Undo.PropertyCallback = callback;
+    graph->Undo.PropertyUserData = user_data;
+}
+
+void ImNodeGraph::RecordPropertyChange(ImGuiID node_id, ImGuiID property_id, const void* old_data, const void* new_data, int size)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    if (!undo.IsRecording())
+        return;
+    BeginUndoRecord(graph);
+    undo.Put(&node_id, sizeof(ImGuiID));
+    undo.Put(&property_id, sizeof(ImGuiID));
+    undo.Put(&size, sizeof(int));
+    undo.Put(old_data, size);
+    undo.Put(new_data, size);
+    EndUndoRecord(graph, ImNodeGraphUndoType_PropertyChanged);
+}
+
+void ImNodeGraph::BeginUndoGroup()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    if (graph->Undo.GroupDepth++ == 0)
+        graph->Undo.GroupHasRecord = false;
+}
+
+void ImNodeGraph::EndUndoGroup()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && graph->Undo.GroupDepth > 0 && "Mismatched BeginUndoGroup()/EndUndoGroup() calls");
+    if (--graph->Undo.GroupDepth == 0)
+        graph->Undo.MergeRecord = ~(ImU64)0;
+}
+
+bool ImNodeGraph::Undo()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    IM_ASSERT(undo.GroupDepth == 0 && "Undo() called within an undo group");
+    if (undo.Cursor == undo.Begin)
+        return false;
+    StopLayoutAnimation(graph, false);
+    CommitDragGroup(graph);
+
+    // Walk back, applying the inverse of each record, up to the first record of the step
+    undo.MergeRecord = ~(ImU64)0;
+    do
+    {
+        ImU32 size;
+        undo.Read(undo.Cursor - IMNODEGRAPH_UNDO_TRAILER_SIZE, &size, sizeof(ImU32));
+        undo.Cursor -= size;
+        undo.Scratch.resize((int)size);
+        undo.Read(undo.Cursor, undo.Scratch.Data, (int)size);
+        ApplyUndoRecord(graph, true);
+    }
+    while (undo.Cursor > undo.Begin && !(undo.Scratch[5] & ImNodeGraphUndoRecordFlags_StepBegin));
+    return true;
+}
+
+bool ImNodeGraph::Redo()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    IM_ASSERT(undo.GroupDepth == 0 && "Redo() called within an undo group");
+    if (undo.Cursor == undo.End)
+        return false;
+    StopLayoutAnimation(graph, false);
+    CommitDragGroup(graph);
+
+    undo.MergeRecord = ~(ImU64)0;
+    do
+    {
+        ImU32 size;
+        undo.Read(undo.Cursor, &size, sizeof(ImU32));
+        undo.Scratch.resize((int)size);
+        undo.Read(undo.Cursor, undo.Scratch.Data, (int)size);
+        ApplyUndoRecord(graph, false);
+        undo.Cursor += size;
+        if (undo.Cursor == undo.End)
+            break;
+        ImU8 flags;
+        undo.Read(undo.Cursor + 5, &flags, 1);
+        if (flags & ImNodeGraphUndoRecordFlags_StepBegin)
+            break;
+    }
+    while (true);
+    return true;
+}
+
+bool ImNodeGraph::CanUndo()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    return graph->Undo.Cursor != graph->Undo.Begin;
+}
+
+bool ImNodeGraph::CanRedo()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    return graph->Undo.Cursor != graph->Undo.End;
+}
+
+void ImNodeGraph::ClearUndoHistory()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    graph->Undo.Clear();
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Evaluation
+//-----------------------------------------------------------------------------
+
+// Nodes on the other side of the links attached to the pins of one direction: successors for outputs,
+// predecessors for inputs. Links closing a cycle are skipped.
+static void CollectLinkedNodes(ImNodeGraphData* graph, int node_idx, ImPinDirection direction, ImVector<int>* out_nodes)
+{
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    for (ImNodeGraphHandle pin = graph->Nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+    {
+        if (pins.Direction[ImNodeGraphHandleIndex(pin)] != direction)
+            continue;
+        for (ImNodeGraphHandle link = pins.FirstLink[ImNodeGraphHandleIndex(pin)]; link != 0; link = *GetLinkNextAtPin(links, link, pin))
+        {
+            const int link_idx = ImNodeGraphHandleIndex(link);
+            if (links.Cyclic[link_idx])
+                continue;
+            const ImNodeGraphHandle other_pin = (direction == ImPinDirection_Output) ? links.EndPin[link_idx] : links.StartPin[link_idx];
+            out_nodes->push_back(ImNodeGraphHandleIndex(pins.Node[ImNodeGraphHandleIndex(other_pin)]));
+        }
+    }
+}
+
+// Kahn's algorithm over the whole graph. Nodes left over sit on cycles: they are appended and the links going
+// backward among them are flagged as cyclic, so the order is valid for every remaining link.
+void ImNodeGraph::ActivateEvaluation(ImNodeGraphData* graph)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImVector<int>& in_degree = graph->TopoSlots;
+    ImVector<int>& queue = graph->TopoStack;
+    in_degree.resize(nodes.Slots.GetSize());
+    memset(in_degree.Data, 0, (size_t)in_degree.Size * sizeof(int));
+    for (int link_idx = 0; link_idx < links.Slots.GetSize(); link_idx++)
+    {
+        links.Cyclic[link_idx] = false;
+        if (links.Slots.IsSlotAlive(link_idx))
+            in_degree[ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.EndPin[link_idx])])]++;
+    }
+
+    graph->EvalActive = true;
+    graph->TopoNodes.resize(0);
+    graph->TopoHoles = 0;
+    queue.resize(0);
+    for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+    {
+        nodes.TopoOrder[node_idx] = -1;
+        if (nodes.Slots.IsSlotAlive(node_idx) && in_degree[node_idx] == 0)
+            queue.push_back(node_idx);
+    }
+    for (int head = 0; head < queue.Size; head++)
+    {
+        const int node_idx = queue[head];
+        nodes.TopoOrder[node_idx] = graph->TopoNodes.Size;
+        graph->TopoNodes.push_back(node_idx);
+        graph->TopoLinked.resize(0);
+        CollectLinkedNodes(graph, node_idx, ImPinDirection_Output, &graph->TopoLinked);
+        for (int n = 0; n < graph->TopoLinked.Size; n++)
+            if (--in_degree[graph->TopoLinked[n]] == 0)
+                queue.push_back(graph->TopoLinked[n]);
+    }
+    for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+        if (nodes.Slots.IsSlotAlive(node_idx) && nodes.TopoOrder[node_idx] == -1)
+        {
+            nodes.TopoOrder[node_idx] = graph->TopoNodes.Size;
+            graph->TopoNodes.push_back(node_idx);
+        }
+
+    graph->CyclicLinks.resize(0);
+    for (int link_idx = 0; link_idx < links.Slots.GetSize(); link_idx++)
+    {
+        if (!links.Slots.IsSlotAlive(link_idx))
+            continue;
+        const int start_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.StartPin[link_idx])]);
+        const int end_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(links.EndPin[link_idx])]);
+        links.Cyclic[link_idx] = (nodes.TopoOrder[start_node_idx] >= nodes.TopoOrder[end_node_idx]);
+        if (links.Cyclic[link_idx])
+            graph->CyclicLinks.push_back(link_idx);
+    }
+
+    // Everything needs a first evaluation
+    graph->DirtyNodes.resize(0);
+    for (int n = 0; n < graph->TopoNodes.Size; n++)
+    {
+        nodes.Dirty[graph->TopoNodes[n]] = true;
+        graph->DirtyNodes.push_back(graph->TopoNodes[n]);
+    }
+}
+
+static int IMGUI_CDECL SortIntComparer(const void* lhs, const void* rhs)
+{
+    return *(const int*)lhs - *(const int*)rhs;
+}
+
+// Pearce-Kelly: when the new edge goes against the order, only the nodes between both endpoints in the order which
+// are reachable forward from the target or backward from the source are reordered. Their order positions are pooled
+// and handed back to the backward set first, then to the forward set.
+bool ImNodeGraph::AddTopologicalEdge(ImNodeGraphData* graph, int from_node_idx, int to_node_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    const int lower = nodes.TopoOrder[to_node_idx];
+    const int upper = nodes.TopoOrder[from_node_idx];
+    if (from_node_idx == to_node_idx)
+        return false;
+    if (upper < lower)
+        return true;
+
+    ImVector<int>& stack = graph->TopoStack;
+    ImVector<int>& linked = graph->TopoLinked;
+    ImVector<int>& forward = graph->TopoForward;
+    ImVector<int>& backward = graph->TopoBackward;
+    const int stamp = ++graph->TopoVisitStamp;
+    bool cycle = false;
+
+    forward.resize(0);
+    stack.resize(0);
+    stack.push_back(to_node_idx);
+    nodes.TopoVisit[to_node_idx] = stamp;
+    while (stack.Size > 0 && !cycle)
+    {
+        const int node_idx = stack.back();
+        stack.pop_back();
+        forward.push_back(node_idx);
+        linked.resize(0);
+        CollectLinkedNodes(graph, node_idx, ImPinDirection_Output, &linked);
+        for (int n = 0; n < linked.Size; n++)
+        {
+            const int next_idx = linked[n];
+            if (next_idx == from_node_idx)
+                cycle = true;
+            else if (nodes.TopoVisit[next_idx] != stamp && nodes.TopoOrder[next_idx] < upper)
+            {
+                nodes.TopoVisit[next_idx] = stamp;
+                stack.push_back(next_idx);
+            }
+        }
+    }
+    if (cycle)
+        return false;
+
+    backward.resize(0);
+    stack.resize(0);
+    stack.push_back(from_node_idx);
+    nodes.TopoVisit[from_node_idx] = stamp;
+    while (stack.Size > 0)
+    {
+        const int node_idx = stack.back();
+        stack.pop_back();
+        backward.push_back(node_idx);
+        linked.resize(0);
+        CollectLinkedNodes(graph, node_idx, ImPinDirection_Input, &linked);
+        for (int n = 0; n < linked.Size; n++)
+        {
+            const int prev_idx = linked[n];
+            if (nodes.TopoVisit[prev_idx] != stamp && nodes.TopoOrder[prev_idx] > lower)
+            {
+                nodes.TopoVisit[prev_idx] = stamp;
+                stack.push_back(prev_idx);
+            }
+        }
+    }
+
+    // Sort both sets by their current position, then redistribute the pooled positions
+    ImVector<int>& slots = graph->TopoSlots;
+    slots.resize(0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        ImVector<int>& set = (pass == 0) ? backward : forward;
+        for (int n = 0; n < set.Size; n++)
+        {
+            set[n] = nodes.TopoOrder[set[n]];
+            slots.push_back(set[n]);
+        }
+        ImQsort(set.Data, (size_t)set.Size, sizeof(int), SortIntComparer);
+        for (int n = 0; n < set.Size; n++)
+            set[n] = graph->TopoNodes[set[n]];
+    }
+    ImQsort(slots.Data, (size_t)slots.Size, sizeof(int), SortIntComparer);
+    int slot_n = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const ImVector<int>& set = (pass == 0) ? backward : forward;
+        for (int n = 0; n < set.Size; n++, slot_n++)
+        {
+            nodes.TopoOrder[set[n]] = slots[slot_n];
+            graph->TopoNodes[slots[slot_n]] = set[n];
+        }
+    }
+    return true;
+}
+
+// Every link goes forward in the order, so a path from 'to_node_idx' back to 'from_node_idx' can only exist when
+// the new edge goes backward, and only through the nodes between them. Same forward search as AddTopologicalEdge().
+bool ImNodeGraph::WouldCloseCycle(ImNodeGraphData* graph, int from_node_idx, int to_node_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    const int upper = nodes.TopoOrder[from_node_idx];
+    if (from_node_idx == to_node_idx)
+        return true;
+    if (upper < nodes.TopoOrder[to_node_idx])
+        return false;
+
+    ImVector<int>& stack = graph->TopoStack;
+    ImVector<int>& linked = graph->TopoLinked;
+    const int stamp = ++graph->TopoVisitStamp;
+    stack.resize(0);
+    stack.push_back(to_node_idx);
+    nodes.TopoVisit[to_node_idx] = stamp;
+    while (stack.Size > 0)
+    {
+        const int node_idx = stack.back();
+        stack.pop_back();
+        linked.resize(0);
+        CollectLinkedNodes(graph, node_idx, ImPinDirection_Output, &linked);
+        for (int n = 0; n < linked.Size; n++)
+        {
+            const int next_idx = linked[n];
+            if (next_idx == from_node_idx)
+                return true;
+            if (nodes.TopoVisit[next_idx] != stamp && nodes.TopoOrder[next_idx] < upper)
+            {
+                nodes.TopoVisit[next_idx] = stamp;
+                stack.push_back(next_idx);
+            }
+        }
+    }
+    return false;
+}
+
+// Dirty nodes only ever have dirty successors, the walk stops at nodes which already are
+void ImNodeGraph::MarkDirtyDownstream(ImNodeGraphData* graph, int node_idx)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImVector<int>& stack = graph->TopoStack;
+    if (nodes.Dirty[node_idx])
+        return;
+    stack.resize(0);
+    stack.push_back(node_idx);
+    nodes.Dirty[node_idx] = true;
+    while (stack.Size > 0)
+    {
+        const int dirty_idx = stack.back();
+        stack.pop_back();
+        graph->DirtyNodes.push_back(dirty_idx);
+        graph->TopoLinked.resize(0);
+        CollectLinkedNodes(graph, dirty_idx, ImPinDirection_Output, &graph->TopoLinked);
+        for (int n = 0; n < graph->TopoLinked.Size; n++)
+        {
+            const int next_idx = graph->TopoLinked[n];
+            if (!nodes.Dirty[next_idx])
+            {
+                nodes.Dirty[next_idx] = true;
+                stack.push_back(next_idx);
+            }
+        }
+    }
+}
+
+static ImNodeGraphData* GetEvaluationGraph()
+{
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "Evaluation functions must be called between BeginGraph() and EndGraph()");
+    if (!graph->EvalActive)
+        ImNodeGraph::ActivateEvaluation(graph);
+    return graph;
+}
+
+void ImNodeGraph::SetNodeCompute(ImGuiID node_id, ImNodeGraphComputeCallback callback, void* user_data)
+{
+    ImNodeGraphData* graph = GetEvaluationGraph();
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    IM_ASSERT(node != 0 && "SetNodeCompute() target node doesn't exist");
+    if (node == 0)
+        return;
+    const int node_idx = ImNodeGraphHandleIndex(node);
+    if (graph->Nodes.ComputeCallback[node_idx] == callback && graph->Nodes.ComputeUserData[node_idx] == user_data)
+        return;
+    graph->Nodes.ComputeCallback[node_idx] = callback;
+    graph->Nodes.ComputeUserData[node_idx] = user_data;
+    MarkDirtyDownstream(graph, node_idx);
+}
+
+void ImNodeGraph::MarkNodeDirty(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetEvaluationGraph();
+    if (ImNodeGraphHandle node = FindNode(graph, node_id))
+        MarkDirtyDownstream(graph, ImNodeGraphHandleIndex(node));
+}
+
+bool ImNodeGraph::IsNodeDirty(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GetEvaluationGraph();
+    ImNodeGraphHandle node = FindNode(graph, node_id);
+    return node != 0 && graph->Nodes.Dirty[ImNodeGraphHandleIndex(node)];
+}
+
+bool ImNodeGraph::WouldLinkCloseCycle(ImGuiID start_pin_id, ImGuiID end_pin_id)
+{
+    ImNodeGraphData* graph = GetEvaluationGraph();
+    ImNodeGraphHandle start_pin = FindPin(graph, start_pin_id);
+    ImNodeGraphHandle end_pin = FindPin(graph, end_pin_id);
+    if (start_pin == 0 || end_pin == 0)
+        return false;
+    const int start_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(start_pin)]);
+    const int end_node_idx = ImNodeGraphHandleIndex(graph->Pins.Node[ImNodeGraphHandleIndex(end_pin)]);
+    return WouldCloseCycle(graph, start_node_idx, end_node_idx);
+}
+
+// Dirty node slots in topological order. Clears the list of marked nodes.
+static void CollectDirtyNodes(ImNodeGraphData* graph, ImVector<int>* out_nodes)
+{
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+
+    // Holes left by removed nodes are squeezed out once they make up half of the order
+    if (graph->TopoHoles > 0 && graph->TopoHoles * 2 >= graph->TopoNodes.Size)
+    {
+        int count = 0;
+        for (int n = 0; n < graph->TopoNodes.Size; n++)
+            if (graph->TopoNodes[n] != -1)
+            {
+                nodes.TopoOrder[graph->TopoNodes[n]] = count;
+                graph->TopoNodes[count++] = graph->TopoNodes[n];
+            }
+        graph->TopoNodes.resize(count);
+        graph->TopoHoles = 0;
+    }
+
+    // Drop stale entries, sort the rest by position in the topological order
+    const int stamp = ++graph->TopoVisitStamp;
+    out_nodes->resize(0);
+    for (int n = 0; n < graph->DirtyNodes.Size; n++)
+    {
+        // A slot can be listed twice when its node was removed and the slot reused
+        const int node_idx = graph->DirtyNodes[n];
+        if (nodes.Slots.IsSlotAlive(node_idx) && nodes.Dirty[node_idx] && nodes.TopoVisit[node_idx] != stamp)
+        {
+            nodes.TopoVisit[node_idx] = stamp;
+            out_nodes->push_back(nodes.TopoOrder[node_idx]);
+        }
+    }
+    graph->DirtyNodes.resize(0);
+    ImQsort(out_nodes->Data, (size_t)out_nodes->Size, sizeof(int), SortIntComparer);
+    for (int n = 0; n < out_nodes->Size; n++)
+        (*out_nodes)[n] = graph->TopoNodes[(*out_nodes)[n]];
+}
+
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+
+// Each worker owns a queue: it pushes and pops at the back, idle workers steal from the front of the others.
+// Nodes become ready when the last of their dirty inputs completes, counted down atomically.
+struct ImNodeGraphWorkQueue
+{
+    std::mutex                  Mutex;
+    ImVector<int>               Items;
+    int                         Head;
+
+    ImNodeGraphWorkQueue()      { Head = 0; }
+};
+
+struct ImNodeGraphExecutor
+{
+    ImVector<std::thread*>      Threads;            // Worker 0 is the thread calling EvaluateGraph()
+    ImNodeGraphWorkQueue*       Queues;
+    int                         WorkerCount;
+    std::mutex                  Mutex;
+    std::condition_variable     WakeCond;
+    std::condition_variable     DoneCond;
+    int                         Generation;
+    int                         Busy;
+    bool                        Quit;
+
+    // Current evaluation
+    ImNodeGraphData*            Graph;
+    bool                        Deterministic;
+    const int*                  Nodes;              // Local index -> node slot
+    const int*                  SuccStart;
+    const int*                  Succ;
+    std::atomic<int>*           Pending;            // Dirty inputs left, per local index
+    int                         PendingCapacity;
+    std::atomic<int>            Remaining;
+    std::atomic<int>            Evaluated;
+    std::atomic<int>            Queued;             // Ready nodes in all queues
+    std::atomic<int>            Sleepers;           // Workers waiting on IdleCond
+    std::mutex                  IdleMutex;
+    std::condition_variable     IdleCond;
+
+    ImNodeGraphExecutor()       { Queues = NULL; WorkerCount = 0; Generation = Busy = 0; Quit = false; Graph = NULL; Deterministic = false; Nodes = SuccStart = Succ = NULL; Pending = NULL; PendingCapacity = 0; Queued = Sleepers = 0; }
+};
+
+static void ExecutorPush(ImNodeGraphExecutor* ex, int worker_idx, int local_idx)
+{
+    ImNodeGraphWorkQueue& queue = ex->Queues[worker_idx];
+    {
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        IM_ASSERT(queue.Items.Size < queue.Items.Capacity && "Queues are sized by ExecuteParallel(), growing them would allocate through ImGui");
+        queue.Items.push_back(local_idx);
+    }
+    ex->Queued.fetch_add(1);
+    if (ex->Sleepers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(ex->IdleMutex);
+        ex->IdleCond.notify_one();
+    }
+}
+
+static bool ExecutorPop(ImNodeGraphExecutor* ex, int worker_idx, int* out_local_idx)
+{
+    // Own queue first, most recent work is the most likely to be hot in cache. Deterministic runs are plain FIFO.
+    for (int n = 0; n < ex->WorkerCount; n++)
+    {
+        const int victim_idx = (worker_idx + n) % ex->WorkerCount;
+        ImNodeGraphWorkQueue& queue = ex->Queues[victim_idx];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        if (queue.Head == queue.Items.Size)
+            continue;
+        if (victim_idx == worker_idx && !ex->Deterministic)
+        {
+            *out_local_idx = queue.Items.back();
+            queue.Items.pop_back();
+        }
+        else
+        {
+            *out_local_idx = queue.Items[queue.Head++];
+        }
+        if (queue.Head == queue.Items.Size)
+        {
+            queue.Items.resize(0);
+            queue.Head = 0;
+        }
+        ex->Queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+static void ExecutorRun(ImNodeGraphExecutor* ex, int worker_idx)
+{
+    const ImNodeGraphNodePool& nodes = ex->Graph->Nodes;
+    int spin_count = 0;
+    while (ex->Remaining.load(std::memory_order_acquire) > 0)
+    {
+        int local_idx;
+        if (!ExecutorPop(ex, worker_idx, &local_idx))
+        {
+            // Spin briefly, nodes are often short, then sleep until ExecutorPush() or the last node wakes us. Sleepers
+            // is raised before checking for work so a push either sees it or is seen.
+            if (++spin_count < IMNODEGRAPH_EVAL_SPIN_COUNT)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(ex->IdleMutex);
+            ex->Sleepers.fetch_add(1);
+            while (ex->Queued.load() == 0 && ex->Remaining.load() > 0)
+                ex->IdleCond.wait(lock);
+            ex->Sleepers.fetch_sub(1);
+            spin_count = 0;
+            continue;
+        }
+        spin_count = 0;
+        const int node_idx = ex->Nodes[local_idx];
+        if (nodes.ComputeCallback[node_idx] != NULL)
+        {
+            nodes.ComputeCallback[node_idx](nodes.ID[node_idx], nodes.ComputeUserData[node_idx]);
+            ex->Evaluated.fetch_add(1, std::memory_order_relaxed);
+        }
+        for (int n = ex->SuccStart[local_idx]; n < ex->SuccStart[local_idx + 1]; n++)
+            if (ex->Pending[ex->Succ[n]].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ExecutorPush(ex, worker_idx, ex->Succ[n]);
+        if (ex->Remaining.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(ex->IdleMutex);
+            ex->IdleCond.notify_all();
+        }
+    }
+}
+
+static void ExecutorWorkerMain(ImNodeGraphExecutor* ex, int worker_idx)
+{
+    int generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(ex->Mutex);
+            while (!ex->Quit && ex->Generation == generation)
+                ex->WakeCond.wait(lock);
+            if (ex->Quit)
+                return;
+            generation = ex->Generation;
+        }
+        ExecutorRun(ex, worker_idx);
+        std::lock_guard<std::mutex> lock(ex->Mutex);
+        if (--ex->Busy == 0)
+            ex->DoneCond.notify_all();
+    }
+}
+
+static ImNodeGraphExecutor* GetExecutor(ImNodeGraphContext* ctx)
+{
+    int worker_count = ctx->EvalThreadCount > 0 ? ctx->EvalThreadCount : (int)std::thread::hardware_concurrency();
+    worker_count = ImMax(worker_count, 1);
+    if (ctx->Executor != NULL && ctx->Executor->WorkerCount == worker_count)
+        return ctx->Executor;
+
+    ImNodeGraph::DestroyExecutor(ctx);
+    ImNodeGraphExecutor* ex = ctx->Executor = IM_NEW(ImNodeGraphExecutor)();
+    ex->WorkerCount = worker_count;
+    ex->Queues = (ImNodeGraphWorkQueue*)IM_ALLOC(sizeof(ImNodeGraphWorkQueue) * worker_count);
+    for (int n = 0; n < worker_count; n++)
+        IM_PLACEMENT_NEW(&ex->Queues[n]) ImNodeGraphWorkQueue();
+    for (int n = 1; n < worker_count; n++)
+        ex->Threads.push_back(IM_NEW(std::thread)(ExecutorWorkerMain, ex, n));
+    return ex;
+}
+
+void ImNodeGraph::DestroyExecutor(ImNodeGraphContext* ctx)
+{
+    ImNodeGraphExecutor* ex = ctx->Executor;
+    if (ex == NULL)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(ex->Mutex);
+        ex->Quit = true;
+    }
+    ex->WakeCond.notify_all();
+    for (int n = 0; n < ex->Threads.Size; n++)
+    {
+        ex->Threads[n]->join();
+        IM_DELETE(ex->Threads[n]);
+    }
+    for (int n = 0; n < ex->WorkerCount; n++)
+        ex->Queues[n].~ImNodeGraphWorkQueue();
+    IM_FREE(ex->Queues);
+    if (ex->Pending != NULL)
+        IM_FREE(ex->Pending);
+    IM_DELETE(ex);
+    ctx->Executor = NULL;
+}
+
+// Runs the dirty subgraph, 'dirty_nodes' being in topological order
+static int ExecuteParallel(ImNodeGraphData* graph, const ImVector<int>& dirty_nodes, bool deterministic)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphExecutor* ex = GetExecutor(&g);
+
+    // Successors in compressed rows. The dirty set is closed downstream so every successor is part of it.
+    graph->ExecLocal.resize(nodes.Slots.GetSize());
+    for (int n = 0; n < dirty_nodes.Size; n++)
+        graph->ExecLocal[dirty_nodes[n]] = n;
+    if (ex->PendingCapacity < dirty_nodes.Size)
+    {
+        if (ex->Pending != NULL)
+            IM_FREE(ex->Pending);
+        ex->PendingCapacity = ImMax(dirty_nodes.Size, ex->PendingCapacity * 2);
+        ex->Pending = (std::atomic<int>*)IM_ALLOC(sizeof(std::atomic<int>) * ex->PendingCapacity);
+    }
+    for (int n = 0; n < dirty_nodes.Size; n++)
+        IM_PLACEMENT_NEW(&ex->Pending[n]) std::atomic<int>(0);
+    graph->ExecSuccStart.resize(dirty_nodes.Size + 1);
+    graph->ExecSucc.resize(0);
+    for (int n = 0; n < dirty_nodes.Size; n++)
+    {
+        graph->ExecSuccStart[n] = graph->ExecSucc.Size;
+        graph->TopoLinked.resize(0);
+        CollectLinkedNodes(graph, dirty_nodes[n], ImPinDirection_Output, &graph->TopoLinked);
+        for (int succ_n = 0; succ_n < graph->TopoLinked.Size; succ_n++)
+        {
+            IM_ASSERT(nodes.Dirty[graph->TopoLinked[succ_n]]);
+            const int succ_local_idx = graph->ExecLocal[graph->TopoLinked[succ_n]];
+            graph->ExecSucc.push_back(succ_local_idx);
+            ex->Pending[succ_local_idx].store(ex->Pending[succ_local_idx].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+    graph->ExecSuccStart[dirty_nodes.Size] = graph->ExecSucc.Size;
+    for (int n = 0; n < dirty_nodes.Size; n++)
+        nodes.Dirty[dirty_nodes[n]] = false;
+
+    ex->Graph = graph;
+    ex->Deterministic = deterministic;
+    ex->Nodes = dirty_nodes.Data;
+    ex->SuccStart = graph->ExecSuccStart.Data;
+    ex->Succ = graph->ExecSucc.Data;
+    ex->Remaining.store(dirty_nodes.Size, std::memory_order_relaxed);
+    ex->Evaluated.store(0, std::memory_order_relaxed);
+    ex->Queued.store(0, std::memory_order_relaxed);
+
+    // A node is queued once per run, the queues are sized for all of them so workers never allocate: ImGui::MemAlloc()
+    // updates the counters of the ImGui context, which belongs to the calling thread
+    for (int n = 0; n < ex->WorkerCount; n++)
+        ex->Queues[n].Items.reserve(dirty_nodes.Size);
+
+    // Roots are dealt round-robin, deterministic runs keep everything on the calling thread
+    int seed_worker = 0;
+    for (int n = 0; n < dirty_nodes.Size; n++)
+        if (ex->Pending[n].load(std::memory_order_relaxed) == 0)
+        {
+            ex->Queues[seed_worker].Items.push_back(n);
+            ex->Queued.store(ex->Queued.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (!deterministic)
+                seed_worker = (seed_worker + 1) % ex->WorkerCount;
+        }
+
+    if (deterministic || ex->WorkerCount == 1 || dirty_nodes.Size == 1)
+    {
+        const int worker_count = ex->WorkerCount;
+        ex->WorkerCount = 1;
+        ExecutorRun(ex, 0);
+        ex->WorkerCount = worker_count;
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(ex->Mutex);
+            ex->Busy = ex->Threads.Size;
+            ex->Generation++;
+        }
+        ex->WakeCond.notify_all();
+        ExecutorRun(ex, 0);
+        std::unique_lock<std::mutex> lock(ex->Mutex);
+        while (ex->Busy > 0)
+            ex->DoneCond.wait(lock);
+    }
+    ex->Graph = NULL;
+    return ex->Evaluated.load(std::memory_order_relaxed);
+}
+
+#else
+
+void ImNodeGraph::DestroyExecutor(ImNodeGraphContext*)
+{
+}
+
+#endif // #ifndef IMNODEGRAPH_DISABLE_THREADS
+
+int ImNodeGraph::EvaluateGraph(ImNodeGraphEvalFlags flags)
+{
+    IMNODEGRAPH_PROFILE_ZONE("EvaluateGraph");
+    ImNodeGraphData* graph = GetEvaluationGraph();
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImVector<int>& dirty_nodes = graph->TopoSlots;
+    CollectDirtyNodes(graph, &dirty_nodes);
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    if ((flags & ImNodeGraphEvalFlags_Parallel) && dirty_nodes.Size > 0)
+        return ExecuteParallel(graph, dirty_nodes, (flags & ImNodeGraphEvalFlags_Deterministic) != 0);
+#else
+    IM_UNUSED(flags);
+#endif
+
+    int evaluated = 0;
+    for (int n = 0; n < dirty_nodes.Size; n++)
+    {
+        const int node_idx = dirty_nodes[n];
+        nodes.Dirty[node_idx] = false;
+        if (nodes.ComputeCallback[node_idx] != NULL)
+        {
+            nodes.ComputeCallback[node_idx](nodes.ID[node_idx], nodes.ComputeUserData[node_idx]);
+            evaluated++;
+        }
+    }
+    return evaluated;
+}
+
+void ImNodeGraph::SetEvaluationThreadCount(int count)
+{
+    IM_ASSERT(GImNodeGraph != NULL && count >= 0);
+    GImNodeGraph->EvalThreadCount = count;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Auto layout
+//-----------------------------------------------------------------------------
+
+// Snapshot taken by StartLayout(). Only the worker thread touches it until Done is set, nodes are referred to by
+// their index in the snapshot.
+struct ImNodeGraphLayoutJob
+{
+    ImNodeGraphLayout           Layout;
+    bool                        Incremental;
+    bool                        Animate;
+    ImVec2                      Spacing;
+    ImVector<ImGuiID>           NodeIDs;
+    ImVector<ImVec2>            Pos;                // Top-left corners, replaced by the computed ones
+    ImVector<ImVec2>            Size;
+    ImVector<bool>              Fixed;              // Left in place by incremental layouts
+    ImVector<int>               EdgeFrom;           // Output side of each link
+    ImVector<int>               EdgeTo;
+    ImNodeGraphSpatialGrid      PlacedGrid;         // Incremental layered layouts, sized by StartLayout() so the worker thread never grows it
+    ImVector<ImNodeGraphGridRange> PlacedRanges;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    std::thread*                Thread;
+    std::atomic<bool>           Cancel;
+    std::atomic<bool>           Done;
+#else
+    bool                        Cancel;
+    bool                        Done;
+#endif
+
+    ImNodeGraphLayoutJob()
+    {
+        Layout = ImNodeGraphLayout_Layered;
+        Incremental = Animate = false;
+        Cancel = Done = false;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+        Thread = NULL;
+#endif
+    }
+};
+
+// Square cell of the Barnes-Hut quadtree
+struct ImNodeGraphLayoutQuadCell
+{
+    ImVec2                      Min;
+    float                       Size;
+    ImVec2                      MassCenter;         // Sum of the points while building, their average once done
+    int                         Count;
+    int                         Child;              // First of the 4 children, -1 for leaves
+    int                         Point;              // Node of a leaf holding a single one, -1 otherwise
+};
+
+// Edges grouped by one of their ends, in compressed rows: the edges of node n are out_edges[out_start[n]..out_start[n+1]]
+static void BuildLayoutAdjacency(const ImNodeGraphLayoutJob* job, const ImVector<int>& edge_node, ImNodeGraphWorkerVector<int>* out_start, ImNodeGraphWorkerVector<int>* out_edges)
+{
+    const int node_count = job->Pos.Size;
+    out_start->resize(node_count + 1);
+    memset(out_start->Data, 0, (size_t)out_start->Size * sizeof(int));
+    for (int e = 0; e < edge_node.Size; e++)
+        (*out_start)[edge_node[e] + 1]++;
+    for (int n = 0; n < node_count; n++)
+        (*out_start)[n + 1] += (*out_start)[n];
+    out_edges->resize(edge_node.Size);
+    ImNodeGraphWorkerVector<int> cursor = *out_start;
+    for (int e = 0; e < edge_node.Size; e++)
+        (*out_edges)[cursor[edge_node[e]]++] = e;
+}
+
+// Reverse the edges closing a cycle (depth-first back edges) so the graph can be layered
+static void RemoveLayoutCycles(ImNodeGraphLayoutJob* job)
+{
+    const int node_count = job->Pos.Size;
+    ImNodeGraphWorkerVector<int> out_start, out_edges;
+    BuildLayoutAdjacency(job, job->EdgeFrom, &out_start, &out_edges);
+    ImNodeGraphWorkerVector<ImU8> state;                // 0 = unvisited, 1 = on the stack, 2 = done
+    state.resize(node_count);
+    memset(state.Data, 0, (size_t)state.Size);
+    ImNodeGraphWorkerVector<int> stack;                 // Pairs of node, next edge to follow
+    for (int root = 0; root < node_count; root++)
+    {
+        if (state[root] != 0)
+            continue;
+        state[root] = 1;
+        stack.push_back(root);
+        stack.push_back(out_start[root]);
+        while (stack.Size > 0)
+        {
+            const int node = stack[stack.Size - 2];
+            const int cursor = stack[stack.Size - 1];
+            if (cursor == out_start[node + 1])
+            {
+                state[node] = 2;
+                stack.resize(stack.Size - 2);
+                continue;
+            }
+            stack[stack.Size - 1]++;
+            const int e = out_edges[cursor];
+            const int next = job->EdgeTo[e];
+            if (state[next] == 1)
+            {
+                ImSwap(job->EdgeFrom[e], job->EdgeTo[e]);
+            }
+            else if (state[next] == 0)
+            {
+                state[next] = 1;
+                stack.push_back(next);
+                stack.push_back(out_start[next]);
+            }
+        }
+    }
+}
+
+// Translate the computed positions so the layout stays where the graph was
+static void AnchorLayout(ImNodeGraphLayoutJob* job, const ImVec2& anchor)
+{
+    ImVec2 min(FLT_MAX, FLT_MAX);
+    for (int n = 0; n < job->Pos.Size; n++)
+        min = ImMin(min, job->Pos[n]);
+    for (int n = 0; n < job->Pos.Size; n++)
+        job->Pos[n] += anchor - min;
+}
+
+// Nodes of a layer sorted top to bottom get the desired top coordinates which keep them in order and apart. Pushing
+// down from the first node and up from the last one both do, their average does as well and splits the difference.
+static void ResolveLayerOverlaps(ImNodeGraphLayoutJob* job, const int* layer_nodes, int count, const float* desired_top, ImNodeGraphWorkerVector<float>* scratch)
+{
+    scratch->resize(count);
+    float* down = scratch->Data;
+    for (int n = 0; n < count; n++)
+    {
+        down[n] = desired_top[n];
+        if (n > 0)
+            down[n] = ImMax(down[n], down[n - 1] + job->Size[layer_nodes[n - 1]].y + job->Spacing.y);
+    }
+    float up = FLT_MAX;
+    for (int n = count - 1; n >= 0; n--)
+    {
+        const int node = layer_nodes[n];
+        up = ImMin(desired_top[n], up - job->Size[node].y - job->Spacing.y);
+        job->Pos[node].y = (down[n] + up) * 0.5f;
+    }
+}
+
+// First placed node, by index, closer than the spacing to 'node' at 'pos'. The cells are walked directly: Query()
+// collects into the frame arena, which belongs to the main thread.
+static int FindLayoutOverlap(const ImNodeGraphSpatialGrid& grid, const ImNodeGraphLayoutJob* job, int node, const ImVec2& pos)
+{
+    const ImVec2 spacing = job->Spacing;
+    const ImVec2 size = job->Size[node];
+    const ImNodeGraphGridRange range = grid.GetRange(ImRect(pos - ImVec2(spacing.x * 0.5f, spacing.y), pos + size + ImVec2(spacing.x * 0.5f, spacing.y)));
+    int hit = -1;
+    for (int y = range.Y0; y <= range.Y1; y++)
+        for (int x = range.X0; x <= range.X1; x++)
+            for (int entry_idx = (int)grid.Cells.Get(GridCellKey(x, y), (ImU32)-1); entry_idx != -1; entry_idx = grid.Entries[entry_idx].Next)
+            {
+                const int other = grid.Entries[entry_idx].Item;
+                if ((hit == -1 || other < hit) && pos.x < job->Pos[other].x + job->Size[other].x + spacing.x * 0.5f && job->Pos[other].x < pos.x + size.x + spacing.x * 0.5f &&
+                    pos.y < job->Pos[other].y + job->Size[other].y + spacing.y && job->Pos[other].y < pos.y + size.y + spacing.y)
+                    hit = other;
+            }
+    return hit;
+}
+
+// Incremental: nodes which are not fixed are placed in topological order, right of the neighbors feeding them (or left
+// of the ones they feed), at the height of their neighbors, then pushed down until they overlap nothing placed.
+static void ComputeLayeredIncremental(ImNodeGraphLayoutJob* job, const ImNodeGraphWorkerVector<int>& topo, const ImNodeGraphWorkerVector<int>& out_start, const ImNodeGraphWorkerVector<int>& out_edges, const ImNodeGraphWorkerVector<int>& in_start, const ImNodeGraphWorkerVector<int>& in_edges)
+{
+    const int node_count = job->Pos.Size;
+    const ImVec2 spacing = job->Spacing;
+    ImNodeGraphWorkerVector<bool> placed;
+    placed.resize(node_count);
+    memcpy(placed.Data, job->Fixed.Data, (size_t)node_count * sizeof(bool));
+
+    // Placed nodes in a uniform grid, overlap tests only look at the cells around the node being placed
+    ImNodeGraphSpatialGrid& grid = job->PlacedGrid;
+    ImVector<ImNodeGraphGridRange>& grid_ranges = job->PlacedRanges;
+    for (int node = 0; node < node_count; node++)
+        if (placed[node])
+            grid.Update(node, &grid_ranges[node], ImRect(job->Pos[node], job->Pos[node] + job->Size[node]));
+    for (int n = 0; n < topo.Size; n++)
+    {
+        const int node = topo[n];
+        if (placed[node])
+            continue;
+        if (job->Cancel)
+            return;
+        ImVec2 pos = job->Pos[node];
+        float x_min = -FLT_MAX, x_max = FLT_MAX, center_sum = 0.0f;
+        int center_count = 0;
+        for (int i = in_start[node]; i < in_start[node + 1]; i++)
+        {
+            const int other = job->EdgeFrom[in_edges[i]];
+            if (!placed[other])
+                continue;
+            x_min = ImMax(x_min, job->Pos[other].x + job->Size[other].x + spacing.x);
+            center_sum += job->Pos[other].y + job->Size[other].y * 0.5f;
+            center_count++;
+        }
+        for (int i = out_start[node]; i < out_start[node + 1]; i++)
+        {
+            const int other = job->EdgeTo[out_edges[i]];
+            if (!placed[other])
+                continue;
+            x_max = ImMin(x_max, job->Pos[other].x - spacing.x - job->Size[node].x);
+            center_sum += job->Pos[other].y + job->Size[other].y * 0.5f;
+            center_count++;
+        }
+        if (x_min != -FLT_MAX)
+            pos.x = x_min;
+        else if (x_max != FLT_MAX)
+            pos.x = x_max;
+        if (center_count > 0)
+            pos.y = center_sum / center_count - job->Size[node].y * 0.5f;
+
+        // Each step goes past the node hit, which can't be hit again: at most one step per node
+        for (int hit = FindLayoutOverlap(grid, job, node, pos); hit != -1; hit = FindLayoutOverlap(grid, job, node, pos))
+            pos.y = job->Pos[hit].y + job->Size[hit].y + spacing.y;
+        job->Pos[node] = pos;
+        placed[node] = true;
+        grid.Update(node, &grid_ranges[node], ImRect(pos, pos + job->Size[node]));
+    }
+}
+
+// Sugiyama style: cycles broken, longest path layering, layers ordered by barycenter sweeps, then each node pulled
+// toward the height of its neighbors. Links spanning several layers get no dummy nodes, barycenters take every
+// neighbor into account instead: memory stays linear in the size of the graph.
+static void ComputeLayeredLayout(ImNodeGraphLayoutJob* job)
+{
+    const int node_count = job->Pos.Size;
+    ImVec2 anchor(FLT_MAX, FLT_MAX);
+    for (int n = 0; n < node_count; n++)
+        anchor = ImMin(anchor, job->Pos[n]);
+
+    RemoveLayoutCycles(job);
+    ImNodeGraphWorkerVector<int> out_start, out_edges, in_start, in_edges;
+    BuildLayoutAdjacency(job, job->EdgeFrom, &out_start, &out_edges);
+    BuildLayoutAdjacency(job, job->EdgeTo, &in_start, &in_edges);
+
+    // Topological order, each node one layer past its deepest input
+    ImNodeGraphWorkerVector<int> layer, topo, in_degree;
+    layer.resize(node_count);
+    in_degree.resize(node_count);
+    topo.reserve(node_count);
+    for (int n = 0; n < node_count; n++)
+    {
+        layer[n] = 0;
+        in_degree[n] = in_start[n + 1] - in_start[n];
+        if (in_degree[n] == 0)
+            topo.push_back(n);
+    }
+    for (int n = 0; n < topo.Size; n++)
+    {
+        const int node = topo[n];
+        for (int i = out_start[node]; i < out_start[node + 1]; i++)
+        {
+            const int next = job->EdgeTo[out_edges[i]];
+            layer[next] = ImMax(layer[next], layer[node] + 1);
+            if (--in_degree[next] == 0)
+                topo.push_back(next);
+        }
+    }
+    IM_ASSERT(topo.Size == node_count);
+    if (job->Incremental)
+    {
+        ComputeLayeredIncremental(job, topo, out_start, out_edges, in_start, in_edges);
+        return;
+    }
+
+    // Nodes of each layer in compressed rows, starting in topological order
+    int layer_count = 0;
+    for (int n = 0; n < node_count; n++)
+        layer_count = ImMax(layer_count, layer[n] + 1);
+    ImNodeGraphWorkerVector<int> layer_start, layer_nodes, rank;
+    layer_start.resize(layer_count + 1);
+    memset(layer_start.Data, 0, (size_t)layer_start.Size * sizeof(int));
+    for (int n = 0; n < node_count; n++)
+        layer_start[layer[n] + 1]++;
+    for (int l = 0; l < layer_count; l++)
+        layer_start[l + 1] += layer_start[l];
+    layer_nodes.resize(node_count);
+    rank.resize(node_count);
+    {
+        ImNodeGraphWorkerVector<int> cursor = layer_start;
+        for (int n = 0; n < topo.Size; n++)
+        {
+            const int node = topo[n];
+            rank[node] = cursor[layer[node]] - layer_start[layer[node]];
+            layer_nodes[cursor[layer[node]]++] = node;
+        }
+    }
+
+    // Crossing reduction: alternately sweep down and up, sorting each layer by the mean relative rank of the
+    // neighbors on the side the sweep comes from. Ties keep the current order.
+    ImNodeGraphWorkerVector<ImU64> sort_buffer;
+    for (int sweep = 0; sweep < IMNODEGRAPH_LAYOUT_ORDER_SWEEPS && layer_count > 1; sweep++)
+    {
+        if (job->Cancel)
+            return;
+        const bool down = (sweep & 1) == 0;
+        for (int i = 1; i < layer_count; i++)
+        {
+            const int l = down ? i : layer_count - 1 - i;
+            const int count = layer_start[l + 1] - layer_start[l];
+            int* nodes = &layer_nodes[layer_start[l]];
+            sort_buffer.resize(count);
+            for (int n = 0; n < count; n++)
+            {
+                const int node = nodes[n];
+                const ImNodeGraphWorkerVector<int>& start = down ? in_start : out_start;
+                const ImNodeGraphWorkerVector<int>& edges = down ? in_edges : out_edges;
+                float sum = 0.0f;
+                for (int j = start[node]; j < start[node + 1]; j++)
+                {
+                    const int other = down ? job->EdgeFrom[edges[j]] : job->EdgeTo[edges[j]];
+                    sum += (rank[other] + 0.5f) / (layer_start[layer[other] + 1] - layer_start[layer[other]]);
+                }
+                const int degree = start[node + 1] - start[node];
+                const float key = degree > 0 ? sum / degree : (n + 0.5f) / count;
+                ImU32 key_bits;
+                memcpy(&key_bits, &key, sizeof(key_bits)); // Positive floats sort like their bits
+                sort_buffer[n] = ((ImU64)key_bits << 32) | (ImU32)n;
+            }
+            ImQsort(sort_buffer.Data, (size_t)count, sizeof(ImU64), SortU64Comparer);
+            for (int n = 0; n < count; n++)
+                sort_buffer[n] = (ImU64)nodes[sort_buffer[n] & 0xFFFFFFFF];
+            for (int n = 0; n < count; n++)
+            {
+                nodes[n] = (int)sort_buffer[n];
+                rank[nodes[n]] = n;
+            }
+        }
+    }
+
+    // Layers are columns as wide as their widest node, nodes start stacked around the same height
+    float x = 0.0f;
+    for (int l = 0; l < layer_count; l++)
+    {
+        float width = 0.0f, height = 0.0f;
+        for (int n = layer_start[l]; n < layer_start[l + 1]; n++)
+        {
+            const int node = layer_nodes[n];
+            width = ImMax(width, job->Size[node].x);
+            height += job->Size[node].y + job->Spacing.y;
+        }
+        float y = -height * 0.5f;
+        for (int n = layer_start[l]; n < layer_start[l + 1]; n++)
+        {
+            const int node = layer_nodes[n];
+            job->Pos[node] = ImVec2(x, y);
+            y += job->Size[node].y + job->Spacing.y;
+        }
+        x += width + job->Spacing.x;
+    }
+
+    // Straighten links: sweeps moving each node toward the mean height of its neighbors on one side
+    ImNodeGraphWorkerVector<float> desired_top, scratch;
+    for (int sweep = 0; sweep < IMNODEGRAPH_LAYOUT_ORDER_SWEEPS; sweep++)
+    {
+        if (job->Cancel)
+            return;
+        const bool down = (sweep & 1) == 0;
+        for (int i = 0; i < layer_count; i++)
+        {
+            const int l = down ? i : layer_count - 1 - i;
+            const int count = layer_start[l + 1] - layer_start[l];
+            const int* nodes = &layer_nodes[layer_start[l]];
+            desired_top.resize(count);
+            for (int n = 0; n < count; n++)
+            {
+                const int node = nodes[n];
+                const ImNodeGraphWorkerVector<int>& start = down ? in_start : out_start;
+                const ImNodeGraphWorkerVector<int>& edges = down ? in_edges : out_edges;
+                float sum = 0.0f;
+                for (int j = start[node]; j < start[node + 1]; j++)
+                {
+                    const int other = down ? job->EdgeFrom[edges[j]] : job->EdgeTo[edges[j]];
+                    sum += job->Pos[other].y + job->Size[other].y * 0.5f;
+                }
+                const int degree = start[node + 1] - start[node];
+                desired_top[n] = degree > 0 ? sum / degree - job->Size[node].y * 0.5f : job->Pos[node].y;
+            }
+            ResolveLayerOverlaps(job, nodes, count, desired_top.Data, &scratch);
+        }
+    }
+    AnchorLayout(job, anchor);
+}
+
+static inline int GetLayoutQuadrant(const ImNodeGraphLayoutQuadCell& cell, const ImVec2& p)
+{
+    const float half = cell.Size * 0.5f;
+    return (p.x >= cell.Min.x + half ? 1 : 0) | (p.y >= cell.Min.y + half ? 2 : 0);
+}
+
+static void BuildLayoutQuadtree(const ImNodeGraphWorkerVector<ImVec2>& points, ImNodeGraphWorkerVector<ImNodeGraphLayoutQuadCell>* cells)
+{
+    ImVec2 min(FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX);
+    for (int n = 0; n < points.Size; n++)
+    {
+        min = ImMin(min, points[n]);
+        max = ImMax(max, points[n]);
+    }
+    ImNodeGraphLayoutQuadCell root;
+    root.Min = min;
+    root.Size = ImMax(max.x - min.x, max.y - min.y) + 1.0f;
+    root.MassCenter = ImVec2(0.0f, 0.0f);
+    root.Count = 0;
+    root.Child = root.Point = -1;
+    cells->resize(0);
+    cells->push_back(root);
+
+    for (int point_idx = 0; point_idx < points.Size; point_idx++)
+    {
+        const ImVec2 p = points[point_idx];
+        int cell_idx = 0;
+        for (int depth = 0; ; depth++)
+        {
+            if ((*cells)[cell_idx].Child == -1)
+            {
+                ImNodeGraphLayoutQuadCell* cell = &(*cells)[cell_idx];
+                if (cell->Count == 0 || depth >= 24)
+                {
+                    // Empty leaf, or coincident points piling up at the bottom
+                    cell->Point = (cell->Count == 0) ? point_idx : -1;
+                    cell->Count++;
+                    cell->MassCenter += p;
+                    break;
+                }
+
+                // Split, moving the point already there one level down
+                const int child = cells->Size;
+                cells->resize(child + 4);
+                cell = &(*cells)[cell_idx];
+                const float half = cell->Size * 0.5f;
+                for (int q = 0; q < 4; q++)
+                {
+                    ImNodeGraphLayoutQuadCell& c = (*cells)[child + q];
+                    c.Min = cell->Min + ImVec2((q & 1) ? half : 0.0f, (q & 2) ? half : 0.0f);
+                    c.Size = half;
+                    c.MassCenter = ImVec2(0.0f, 0.0f);
+                    c.Count = 0;
+                    c.Child = c.Point = -1;
+                }
+                cell->Child = child;
+                ImNodeGraphLayoutQuadCell& moved = (*cells)[child + GetLayoutQuadrant(*cell, points[cell->Point])];
+                moved.Point = cell->Point;
+                moved.Count = 1;
+                moved.MassCenter = points[cell->Point];
+                cell->Point = -1;
+            }
+            ImNodeGraphLayoutQuadCell& cell = (*cells)[cell_idx];
+            cell.Count++;
+            cell.MassCenter += p;
+            cell_idx = cell.Child + GetLayoutQuadrant(cell, p);
+        }
+    }
+    for (int n = 0; n < cells->Size; n++)
+        if ((*cells)[n].Count > 0)
+            (*cells)[n].MassCenter /= (float)(*cells)[n].Count;
+}
+
+// Fruchterman-Reingold forces: links pull with dist^2 / k, nodes push with k^2 / dist. Repulsion goes through a quadtree
+// rebuilt every iteration, distant cells acting as a single mass (Barnes-Hut), so an iteration is O(n log n).
+static void ComputeForceLayout(ImNodeGraphLayoutJob* job)
+{
+    const int node_count = job->Pos.Size;
+    if (node_count == 0)
+        return;
+    ImVec2 anchor(FLT_MAX, FLT_MAX);
+    float mean_size = 0.0f;
+    for (int n = 0; n < node_count; n++)
+    {
+        anchor = ImMin(anchor, job->Pos[n]);
+        mean_size += ImMax(job->Size[n].x, job->Size[n].y);
+    }
+    const float k = job->Spacing.x + mean_size / node_count;
+    const float theta_sqr = 0.8f * 0.8f;
+
+    // Nodes start from their current position, nudged apart so the ones created at the same place can separate
+    ImNodeGraphWorkerVector<ImVec2> centers, disp;
+    centers.resize(node_count);
+    disp.resize(node_count);
+    for (int n = 0; n < node_count; n++)
+    {
+        centers[n] = job->Pos[n] + job->Size[n] * 0.5f;
+        if (!job->Fixed[n])
+        {
+            const ImU32 h = ImHashData(&n, sizeof(n));
+            centers[n] += ImVec2((float)(h & 0xFFFF) / 0xFFFF - 0.5f, (float)(h >> 16) / 0xFFFF - 0.5f) * (k * 0.1f);
+        }
+    }
+
+    // Temperature bounds how far a node moves in an iteration, it cools down linearly
+    const float temperature_start = job->Incremental ? k * 2.0f : k * (1.0f + ImSqrt((float)node_count) * 0.1f);
+    ImNodeGraphWorkerVector<ImNodeGraphLayoutQuadCell> cells;
+    ImNodeGraphWorkerVector<int> stack;
+    for (int iteration = 0; iteration < IMNODEGRAPH_LAYOUT_FORCE_ITERATIONS; iteration++)
+    {
+        if (job->Cancel)
+            return;
+        BuildLayoutQuadtree(centers, &cells);
+        for (int n = 0; n < node_count; n++)
+        {
+            disp[n] = ImVec2(0.0f, 0.0f);
+            if (job->Fixed[n])
+                continue;
+            const ImVec2 p = centers[n];
+            stack.resize(0);
+            stack.push_back(0);
+            while (stack.Size > 0)
+            {
+                const ImNodeGraphLayoutQuadCell& cell = cells[stack.back()];
+                stack.pop_back();
+                if (cell.Count == 0 || cell.Point == n)
+                    continue;
+                ImVec2 d = p - cell.MassCenter;
+                float dist_sqr = ImLengthSqr(d);
+                if (cell.Child != -1 && cell.Size * cell.Size > theta_sqr * dist_sqr)
+                {
+                    for (int q = 0; q < 4; q++)
+                        stack.push_back(cell.Child + q);
+                    continue;
+                }
+                if (dist_sqr < 0.01f)
+                {
+                    d = ImVec2((n & 1) ? 0.1f : -0.1f, (n & 2) ? 0.1f : -0.1f);
+                    dist_sqr = ImLengthSqr(d);
+                }
+                disp[n] += d * (k * k * cell.Count / dist_sqr);
+            }
+        }
+        for (int e = 0; e < job->EdgeFrom.Size; e++)
+        {
+            const int a = job->EdgeFrom[e], b = job->EdgeTo[e];
+            const ImVec2 d = centers[b] - centers[a];
+            const ImVec2 force = d * (ImSqrt(ImLengthSqr(d)) / k);
+            disp[a] += force;
+            disp[b] -= force;
+        }
+        const float temperature = temperature_start * (1.0f - (float)iteration / IMNODEGRAPH_LAYOUT_FORCE_ITERATIONS);
+        for (int n = 0; n < node_count; n++)
+        {
+            const float len = ImSqrt(ImLengthSqr(disp[n]));
+            if (!job->Fixed[n] && len > 0.0f)
+                centers[n] += disp[n] * (ImMin(len, temperature) / len);
+        }
+    }
+    for (int n = 0; n < node_count; n++)
+        job->Pos[n] = centers[n] - job->Size[n] * 0.5f;
+    if (!job->Incremental)
+        AnchorLayout(job, anchor);
+}
+
+static void RunLayoutJob(ImNodeGraphLayoutJob* job)
+{
+    if (job->Layout == ImNodeGraphLayout_ForceDirected)
+        ComputeForceLayout(job);
+    else
+        ComputeLayeredLayout(job);
+    job->Done = true;
+}
+
+void ImNodeGraph::MarkLayoutChanged(ImNodeGraphData* graph, int node_idx)
+{
+    // Past that many changes an incremental layout would move most of the graph anyway, the next one is made in full
+    if (graph->LayoutChanges.Size > graph->Nodes.Slots.AliveCount + 64)
+    {
+        graph->LayoutTracking = false;
+        graph->LayoutChanges.clear();
+        return;
+    }
+    graph->LayoutChanges.push_back(graph->Nodes.ID[node_idx]);
+}
+
+void ImNodeGraph::CancelLayoutJob(ImNodeGraphData* graph)
+{
+    ImNodeGraphLayoutJob* job = graph->LayoutJob;
+    if (job == NULL)
+        return;
+    job->Cancel = true;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    job->Thread->join();
+    IM_DELETE(job->Thread);
+#endif
+    IM_DELETE(job);
+    graph->LayoutJob = NULL;
+}
+
+void ImNodeGraph::StopLayoutAnimation(ImNodeGraphData* graph, bool snap)
+{
+    if (snap)
+        for (int n = 0; n < graph->LayoutAnimIDs.Size; n++)
+            MoveNodeTo(graph, graph->LayoutAnimIDs[n], graph->LayoutAnimTo[n]);
+    graph->LayoutAnimIDs.resize(0);
+    graph->LayoutAnimFrom.resize(0);
+    graph->LayoutAnimTo.resize(0);
+}
+
+// Moves are recorded as one undo step from the positions the nodes have now, edits made while the layout was computed
+// included. Nodes removed since are skipped.
+static void ApplyLayoutJob(ImNodeGraphData* graph, ImNodeGraphLayoutJob* job)
+{
+    IMNODEGRAPH_PROFILE_ZONE("ApplyLayout");
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphUndoHistory& undo = graph->Undo;
+    ImNodeGraph::BeginUndoGroup();
+    for (int n = 0; n < job->NodeIDs.Size; n++)
+    {
+        const ImNodeGraphHandle node = ImNodeGraph::FindNode(graph, job->NodeIDs[n]);
+        if (node == 0)
+            continue;
+        const int node_idx = ImNodeGraphHandleIndex(node);
+        const ImVec2 pos = nodes.Pos[node_idx];
+        if (pos == job->Pos[n])
+            continue;
+        if (undo.IsRecording())
+        {
+            ImNodeGraph::BeginUndoRecord(graph);
+            undo.Put(&job->NodeIDs[n], sizeof(ImGuiID));
+            undo.Put(&pos, sizeof(ImVec2));
+            undo.Put(&job->Pos[n], sizeof(ImVec2));
+            ImNodeGraph::EndUndoRecord(graph, ImNodeGraphUndoType_NodeMoved);
+        }
+        if (job->Animate)
+        {
+            graph->LayoutAnimIDs.push_back(job->NodeIDs[n]);
+            graph->LayoutAnimFrom.push_back(pos);
+            graph->LayoutAnimTo.push_back(job->Pos[n]);
+        }
+        else
+        {
+            nodes.Pos[node_idx] = job->Pos[n];
+            ImNodeGraph::UpdateNodeBounds(graph, node_idx);
+        }
+    }
+    ImNodeGraph::EndUndoGroup();
+    graph->LayoutAnimTime = 0.0f;
+}
+
+// Called from BeginGraph(), before culling so the visible set matches the positions drawn this frame
+void ImNodeGraph::UpdateLayout(ImNodeGraphData* graph)
+{
+    if (ImNodeGraphLayoutJob* job = graph->LayoutJob)
+    {
+        if (!job->Done)
+            return;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+        job->Thread->join();
+        IM_DELETE(job->Thread);
+#endif
+        graph->LayoutJob = NULL;
+        CommitDragGroup(graph);
+        ApplyLayoutJob(graph, job);
+        IM_DELETE(job);
+    }
+    if (graph->LayoutAnimIDs.Size == 0)
+        return;
+    CommitDragGroup(graph);
+
+    const float duration = GImNodeGraph->Style.LayoutAnimDuration;
+    graph->LayoutAnimTime = (duration > 0.0f) ? ImMin(graph->LayoutAnimTime + ImGui::GetIO().DeltaTime / duration, 1.0f) : 1.0f;
+    const float t = graph->LayoutAnimTime * graph->LayoutAnimTime * (3.0f - 2.0f * graph->LayoutAnimTime);
+    for (int n = 0; n < graph->LayoutAnimIDs.Size; n++)
+        MoveNodeTo(graph, graph->LayoutAnimIDs[n], ImLerp(graph->LayoutAnimFrom[n], graph->LayoutAnimTo[n], t));
+    if (graph->LayoutAnimTime >= 1.0f)
+        StopLayoutAnimation(graph, false);
+}
+
+void ImNodeGraph::StartLayout(ImNodeGraphLayout layout, ImNodeGraphLayoutFlags flags)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "StartLayout() must be called between BeginGraph() and EndGraph()");
+    IMNODEGRAPH_PROFILE_ZONE("StartLayout");
+    CancelLayoutJob(graph);
+    StopLayoutAnimation(graph, true);
+    CommitDragGroup(graph);
+
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    const ImNodeGraphStyle& style = GImNodeGraph->Style;
+    ImNodeGraphLayoutJob* job = IM_NEW(ImNodeGraphLayoutJob)();
+    job->Layout = layout;
+    job->Incremental = (flags & ImNodeGraphLayoutFlags_Incremental) && graph->LayoutTracking;
+    job->Animate = !(flags & ImNodeGraphLayoutFlags_NoAnimation) && style.LayoutAnimDuration > 0.0f;
+    job->Spacing = style.LayoutSpacing;
+
+    // Node slot -> snapshot index
+    ImVector<int> local;
+    local.resize(nodes.Slots.GetSize());
+    job->NodeIDs.reserve(nodes.Slots.AliveCount);
+    job->Pos.reserve(nodes.Slots.AliveCount);
+    job->Size.reserve(nodes.Slots.AliveCount);
+    job->Fixed.reserve(nodes.Slots.AliveCount);
+    for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+    {
+        local[node_idx] = -1;
+        if (!nodes.Slots.IsSlotAlive(node_idx) || nodes.Hidden[node_idx])
+            continue;
+        local[node_idx] = job->NodeIDs.Size;
+        job->NodeIDs.push_back(nodes.ID[node_idx]);
+        job->Pos.push_back(nodes.Pos[node_idx]);
+        job->Size.push_back(nodes.Size[node_idx]);
+        job->Fixed.push_back(job->Incremental);
+    }
+
+    // Nodes hidden in a collapsed group stay where they are, their links pull the group instead
+    if (nodes.HiddenCount > 0)
+        for (int node_idx = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+            if (nodes.Slots.IsSlotAlive(node_idx) && nodes.Hidden[node_idx])
+                local[node_idx] = local[GetVisibleAncestor(graph, node_idx)];
+    job->EdgeFrom.reserve(links.Slots.AliveCount);
+    job->EdgeTo.reserve(links.Slots.AliveCount);
+    for (int link_idx = 0; link_idx < links.Slots.GetSize(); link_idx++)
+    {
+        if (!links.Slots.IsSlotAlive(link_idx))
+            continue;
+        const int from = local[ImNodeGraphHandleIndex(pins.Node[ImNodeGraphHandleIndex(links.StartPin[link_idx])])];
+        const int to = local[ImNodeGraphHandleIndex(pins.Node[ImNodeGraphHandleIndex(links.EndPin[link_idx])])];
+        if (from == to)
+            continue;
+        job->EdgeFrom.push_back(from);
+        job->EdgeTo.push_back(to);
+    }
+
+    if (job->Incremental)
+    {
+        // Changed nodes move, and so do their direct neighbors so they can make room
+        ImVector<bool> changed;
+        changed.resize(job->NodeIDs.Size, false);
+        int changed_count = 0;
+        for (int n = 0; n < graph->LayoutChanges.Size; n++)
+            if (ImNodeGraphHandle node = FindNode(graph, graph->LayoutChanges[n]))
+                if (!changed[local[ImNodeGraphHandleIndex(node)]])
+                {
+                    changed[local[ImNodeGraphHandleIndex(node)]] = true;
+                    changed_count++;
+                }
+        if (changed_count == 0)
+        {
+            IM_DELETE(job);
+            graph->LayoutChanges.resize(0);
+            return;
+        }
+        for (int n = 0; n < job->NodeIDs.Size; n++)
+            if (changed[n])
+                job->Fixed[n] = false;
+        for (int e = 0; e < job->EdgeFrom.Size; e++)
+            if (changed[job->EdgeFrom[e]] || changed[job->EdgeTo[e]])
+                job->Fixed[job->EdgeFrom[e]] = job->Fixed[job->EdgeTo[e]] = false;
+    }
+    if (job->Incremental && job->Layout != ImNodeGraphLayout_ForceDirected)
+    {
+        // A node covers the same number of cells wherever it is placed, the grid can be sized for all of them
+        ImNodeGraphSpatialGrid& grid = job->PlacedGrid;
+        const float inv_cell_size = 1.0f / grid.CellSize;
+        int entry_count = 0;
+        for (int n = 0; n < job->NodeIDs.Size; n++)
+            entry_count += ((int)(job->Size[n].x * inv_cell_size) + 2) * ((int)(job->Size[n].y * inv_cell_size) + 2);
+        grid.Cells.Reserve(entry_count);
+        grid.Entries.reserve(entry_count);
+        grid.QueryStamps.resize(job->NodeIDs.Size, 0);
+        job->PlacedRanges.resize(job->NodeIDs.Size, ImNodeGraphGridRange());
+    }
+    graph->LayoutTracking = true;
+    graph->LayoutChanges.resize(0);
+    graph->LayoutJob = job;
+#ifndef IMNODEGRAPH_DISABLE_THREADS
+    job->Thread = IM_NEW(std::thread)(RunLayoutJob, job);
+#else
+    RunLayoutJob(job);
+#endif
+}
+
+bool ImNodeGraph::IsLayoutInProgress()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    return graph->LayoutJob != NULL || graph->LayoutAnimIDs.Size > 0;
+}
+
+void ImNodeGraph::CancelLayout()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    CancelLayoutJob(graph);
+    StopLayoutAnimation(graph, false);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Queries
+//-----------------------------------------------------------------------------
+
+bool ImNodeGraph::IsLinkCreated(ImGuiID* out_start_pin_id, ImGuiID* out_end_pin_id)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    if (graph == NULL || !graph->LinkCreated)
+        return false;
+    if (out_start_pin_id)
+        *out_start_pin_id = graph->CreatedLinkStart;
+    if (out_end_pin_id)
+        *out_end_pin_id = graph->CreatedLinkEnd;
+    return true;
+}
+
+bool ImNodeGraph::IsNodeSelected(ImGuiID node_id)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    ImNodeGraphHandle node = graph ? FindNode(graph, node_id) : 0;
+    return node != 0 && graph->Selection.Test(ImNodeGraphHandleIndex(node));
+}
+
+int ImNodeGraph::GetSelectedNodeCount()
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return graph ? graph->Selection.Count : 0;
+}
+
+int ImNodeGraph::GetSelectedNodes(ImGuiID* out_node_ids, int max_count)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    if (graph == NULL)
+        return 0;
+    const ImNodeGraphSelection& sel = graph->Selection;
+    int count = 0;
+    for (int node_idx = sel.FindNext(0); node_idx != -1 && count < max_count; node_idx = sel.FindNext(node_idx + 1))
+        out_node_ids[count++] = graph->Nodes.ID[node_idx];
+    return count;
+}
+
+int ImNodeGraph::GetSelectionChanges(const ImGuiID** out_node_ids)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    if (graph == NULL || graph->Selection.ChangesOverflow)
+        return graph ? -1 : 0;
+    if (out_node_ids)
+        *out_node_ids = graph->Selection.Changes.Data;
+    return graph->Selection.Changes.Size;
+}
+
+ImGuiID ImNodeGraph::GetHoveredNode()
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return (graph && graph->Nodes.Slots.IsAlive(graph->HoveredNode)) ? graph->Nodes.ID[ImNodeGraphHandleIndex(graph->HoveredNode)] : 0;
+}
+
+ImGuiID ImNodeGraph::GetHoveredPin()
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return (graph && graph->Pins.Slots.IsAlive(graph->HoveredPin)) ? graph->Pins.ID[ImNodeGraphHandleIndex(graph->HoveredPin)] : 0;
+}
+
+ImGuiID ImNodeGraph::GetHoveredLink()
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return (graph && graph->Links.Slots.IsAlive(graph->HoveredLink)) ? graph->Links.ID[ImNodeGraphHandleIndex(graph->HoveredLink)] : 0;
+}
+
+void ImNodeGraph::SelectNode(ImGuiID node_id, bool selected)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SelectNode() must be called between BeginGraph() and EndGraph()");
+    const ImNodeGraphHandle node = FindNode(graph, node_id);
+    if (node != 0 && !graph->Nodes.Hidden[ImNodeGraphHandleIndex(node)])
+        SetNodeSelected(graph, ImNodeGraphHandleIndex(node), selected);
+}
+
+void ImNodeGraph::ClearSelection()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "ClearSelection() must be called between BeginGraph() and EndGraph()");
+    ClearNodeSelection(graph);
+}
+
+void ImNodeGraph::SelectAll()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SelectAll() must be called between BeginGraph() and EndGraph()");
+    SelectAllNodes(graph);
+}
+
+void ImNodeGraph::InvertSelection()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "InvertSelection() must be called between BeginGraph() and EndGraph()");
+    InvertNodeSelection(graph);
+}
+
+void ImNodeGraph::SelectDownstream()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SelectDownstream() must be called between BeginGraph() and EndGraph()");
+    SelectNodesDownstream(graph);
+}
+
+ImVec2 ImNodeGraph::ScreenToCanvas(const ImVec2& screen_pos)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return graph ? graph->ScreenToCanvas(screen_pos) : screen_pos;
+}
+
+ImVec2 ImNodeGraph::CanvasToScreen(const ImVec2& canvas_pos)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return graph ? graph->CanvasToScreen(canvas_pos) : canvas_pos;
+}
+
+float ImNodeGraph::GetZoom()
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return graph ? graph->Zoom : 1.0f;
+}
+
+void ImNodeGraph::SetZoom(float zoom)
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    if (graph)
+        graph->Zoom = ImClamp(zoom, GImNodeGraph->Style.ZoomMin, GImNodeGraph->Style.ZoomMax);
+}
+
+ImNodeGraphLod ImNodeGraph::GetLod()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    return graph->Lod;
+}
+
+int ImNodeGraph::GetVisibleNodeCount()
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    return graph->VisibleNodes.Size;
+}
+
+ImGuiID ImNodeGraph::GetVisibleNodeID(int n)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    return graph->Nodes.ID[graph->VisibleNodes[n]];
+}
+
+int ImNodeGraph::GetCulledNodeCount()
+{
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return graph ? graph->Stats.NodesCulled : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Graph files
+//-----------------------------------------------------------------------------
+
+ImNodeGraphData::~ImNodeGraphData()
+{
+    ImNodeGraph::CancelLayoutJob(this);
+    ImNodeGraph::CancelRouteJob(this);
+    if (RouteScratch != NULL)
+        IM_DELETE(RouteScratch);
+    ImNodeGraph::DetachMappedColumns(this, false);
+    if (File != NULL)
+        ImNodeGraph::UnmapFile(File);
+}
+
+#ifndef IMNODEGRAPH_DISABLE_FILE_MAPPING
+#ifdef _WIN32
+ImNodeGraphMappedFile* ImNodeGraph::MapFile(const char* filename)
+{
+    const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    ImVector<wchar_t> filename_w;
+    filename_w.resize(filename_wsize);
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_w.Data, filename_wsize);
+    HANDLE handle = ::CreateFileW(filename_w.Data, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    void* data = NULL;
+    if (::GetFileSizeEx(handle, &size) && size.QuadPart > 0 && (ImU64)size.QuadPart <= (ImU64)(size_t)-1)
+        mapping = ::CreateFileMappingW(handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping != NULL)
+        data = ::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (mapping != NULL)
+        ::CloseHandle(mapping); // The view keeps the mapping alive
+    ::CloseHandle(handle);
+    if (data == NULL)
+        return NULL;
+    ImNodeGraphMappedFile* file = IM_NEW(ImNodeGraphMappedFile)();
+    file->Data = (char*)data;
+    file->Size = (size_t)size.QuadPart;
+    return file;
+}
+
+void ImNodeGraph::UnmapFile(ImNodeGraphMappedFile* file)
+{
+    ::UnmapViewOfFile(file->Data);
+    IM_DELETE(file);
+}
+#else
+ImNodeGraphMappedFile* ImNodeGraph::MapFile(const char* filename)
+{
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file open
+    if (data == MAP_FAILED)
+        return NULL;
+    ImNodeGraphMappedFile* file = IM_NEW(ImNodeGraphMappedFile)();
+    file->Data = (char*)data;
+    file->Size = (size_t)st.st_size;
+    return file;
+}
+
+void ImNodeGraph::UnmapFile(ImNodeGraphMappedFile* file)
+{
+    munmap(file->Data, file->Size);
+    IM_DELETE(file);
+}
+#endif
+#else
+ImNodeGraphMappedFile* ImNodeGraph::MapFile(const char* filename)
+{
+    size_t size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &size);
+    if (data == NULL)
+        return NULL;
+    ImNodeGraphMappedFile* file = IM_NEW(ImNodeGraphMappedFile)();
+    file->Data = (char*)data;
+    file->Size = size;
+    return file;
+}
+
+void ImNodeGraph::UnmapFile(ImNodeGraphMappedFile* file)
+{
+    IM_FREE(file->Data);
+    IM_DELETE(file);
+}
+#endif
+
+static bool IsLittleEndianHost()
+{
+    const ImU32 value = 1;
+    return *(const ImU8*)&value == 1;
+}
+
+// Size of a section for the element counts of 'header', (ImU64)-1 for variable sized sections
+static ImU64 CalcFileSectionSize(const ImNodeGraphFileHeader* header, int section)
+{
+    IM_STATIC_ASSERT(sizeof(ImGuiID) == 4 && sizeof(ImNodeGraphHandle) == 4 && sizeof(ImPinDirection) == 4 && sizeof(ImPinType) == 4 && sizeof(ImVec2) == 8);
+    switch (section)
+    {
+    case ImNodeGraphFileSection_NodeID:
+    case ImNodeGraphFileSection_NodeFirstPin:   return (ImU64)header->NodeCount * 4;
+    case ImNodeGraphFileSection_NodePos:
+    case ImNodeGraphFileSection_NodeSize:       return (ImU64)header->NodeCount * 8;
+    case ImNodeGraphFileSection_NodePayload:    return (ImU64)header->NodeCount * sizeof(ImNodeGraphFileRange);
+    case ImNodeGraphFileSection_PinOffset:      return (ImU64)header->PinCount * 8;
+    case ImNodeGraphFileSection_PinID:
+    case ImNodeGraphFileSection_PinNode:
+    case ImNodeGraphFileSection_PinDirection:
+    case ImNodeGraphFileSection_PinType:
+    case ImNodeGraphFileSection_PinNextPin:
+    case ImNodeGraphFileSection_PinFirstLink:   return (ImU64)header->PinCount * 4;
+    case ImNodeGraphFileSection_LinkID:
+    case ImNodeGraphFileSection_LinkStartPin:
+    case ImNodeGraphFileSection_LinkEndPin:
+    case ImNodeGraphFileSection_LinkNextAtStart:
+    case ImNodeGraphFileSection_LinkNextAtEnd:  return (ImU64)header->LinkCount * 4;
+    default:                                    return (ImU64)-1;
+    }
+}
+
+static const void* GetFileSection(const ImNodeGraphMappedFile* file, const ImNodeGraphFileHeader* header, ImNodeGraphFileSection section)
+{
+    return file->Data + header->Sections[section].Offset;
+}
+
+// References must be 0 (when allowed) or fresh handles to one of the 'target_count' elements
+static bool ValidateFileHandles(const void* section, ImU32 count, ImU32 target_count, bool allow_none)
+{
+    const ImNodeGraphHandle* handles = (const ImNodeGraphHandle*)section;
+    for (ImU32 n = 0; n < count; n++)
+    {
+        const ImNodeGraphHandle handle = handles[n];
+        if (handle == 0 ? !allow_none : ((handle >> IMNODEGRAPH_HANDLE_INDEX_BITS) != 1 || (ImU32)ImNodeGraphHandleIndex(handle) >= target_count))
+            return false;
+    }
+    return true;
+}
+
+// NaN fails both comparisons
+static bool ValidateFileVectors(const void* section, ImU32 count, float min_value, float max_value)
+{
+    const ImVec2* values = (const ImVec2*)section;
+    for (ImU32 n = 0; n < count; n++)
+        if (!(values[n].x >= min_value && values[n].x <= max_value && values[n].y >= min_value && values[n].y <= max_value))
+            return false;
+    return true;
+}
+
+// Slots are dense in the file, handles are those of generation 1. A repeated ID would leave an element which can't be found.
+static bool BuildFileIDMap(const void* section, ImU32 count, ImNodeGraphIDMap* map)
+{
+    const ImGuiID* ids = (const ImGuiID*)section;
+    map->Reserve((int)count);
+    for (ImU32 n = 0; n < count; n++)
+    {
+        ImU32* handle = map->GetRef(ids[n], 0);
+        if (*handle != 0)
+            return false;
+        *handle = (1u << IMNODEGRAPH_HANDLE_INDEX_BITS) | n;
+    }
+    return true;
+}
+
+// Walk the pin chain of every node and the link chain of every pin once, a pin must be reached exactly once from
+// the node it names, a link exactly once from each of its two pins. This rules out loops and shared tails, which
+// would otherwise hang or corrupt the editor when the chains are later edited.
+static bool ValidateFileChains(const ImNodeGraphMappedFile* file, const ImNodeGraphFileHeader* header)
+{
+    const ImNodeGraphHandle* node_first_pin = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_NodeFirstPin);
+    const ImNodeGraphHandle* pin_node = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_PinNode);
+    const ImNodeGraphHandle* pin_next_pin = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_PinNextPin);
+    const ImNodeGraphHandle* pin_first_link = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_PinFirstLink);
+    const ImNodeGraphHandle* link_start_pin = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_LinkStartPin);
+    const ImNodeGraphHandle* link_end_pin = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_LinkEndPin);
+    const ImNodeGraphHandle* link_next_at_start = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_LinkNextAtStart);
+    const ImNodeGraphHandle* link_next_at_end = (const ImNodeGraphHandle*)GetFileSection(file, header, ImNodeGraphFileSection_LinkNextAtEnd);
+    const ImPinDirection* pin_direction = (const ImPinDirection*)GetFileSection(file, header, ImNodeGraphFileSection_PinDirection);
+
+    // One bit per visit: 1 for a pin or for a link reached from its start pin, 2 for a link reached from its end pin
+    ImVector<ImU8> pin_visited, link_visited;
+    pin_visited.resize((int)header->PinCount, 0);
+    link_visited.resize((int)header->LinkCount, 0);
+    for (ImU32 node_idx = 0; node_idx < header->NodeCount; node_idx++)
+        for (ImNodeGraphHandle pin = node_first_pin[node_idx]; pin != 0; pin = pin_next_pin[ImNodeGraphHandleIndex(pin)])
+        {
+            const int pin_idx = ImNodeGraphHandleIndex(pin);
+            if (pin_visited[pin_idx] != 0 || (ImU32)ImNodeGraphHandleIndex(pin_node[pin_idx]) != node_idx)
+                return false;
+            if (pin_direction[pin_idx] != ImPinDirection_Input && pin_direction[pin_idx] != ImPinDirection_Output)
+                return false;
+            pin_visited[pin_idx] = 1;
+            for (ImNodeGraphHandle link = pin_first_link[pin_idx]; link != 0; )
+            {
+                const int link_idx = ImNodeGraphHandleIndex(link);
+                const ImU8 side = (link_start_pin[link_idx] == pin) ? 1 : (link_end_pin[link_idx] == pin) ? 2 : 0;
+                if (side == 0 || (link_visited[link_idx] & side) != 0)
+                    return false;
+                link_visited[link_idx] |= side;
+                link = (side == 1) ? link_next_at_start[link_idx] : link_next_at_end[link_idx];
+            }
+        }
+    for (ImU32 pin_idx = 0; pin_idx < header->PinCount; pin_idx++)
+        if (pin_visited[(int)pin_idx] != 1)
+            return false;
+    for (ImU32 link_idx = 0; link_idx < header->LinkCount; link_idx++)
+        if (link_visited[(int)link_idx] != 3)
+            return false;
+    return true;
+}
+
+// Bounds, references, the structure of the pin and link chains, coordinates and IDs are checked so a corrupt file
+// can't make the editor read outside of it, loop over it or lose track of its elements.
+const ImNodeGraphFileHeader* ImNodeGraph::ValidateGraphFile(const ImNodeGraphMappedFile* file, ImNodeGraphIDMap* out_node_map, ImNodeGraphIDMap* out_pin_map, ImNodeGraphIDMap* out_link_map)
+{
+    if (file->Size < sizeof(ImNodeGraphFileHeader))
+        return NULL;
+    const ImNodeGraphFileHeader* header = (const ImNodeGraphFileHeader*)(const void*)file->Data;
+    if (memcmp(header->Magic, IMNODEGRAPH_FILE_MAGIC, sizeof(header->Magic)) != 0 || header->Version == 0 || header->Version > IMNODEGRAPH_FILE_VERSION)
+        return NULL;
+    if (header->SectionCount < ImNodeGraphFileSection_COUNT || header->FileSize != (ImU64)file->Size)
+        return NULL;
+    if (header->NodeCount >= IMNODEGRAPH_HANDLE_MAX_SLOTS || header->PinCount >= IMNODEGRAPH_HANDLE_MAX_SLOTS || header->LinkCount >= IMNODEGRAPH_HANDLE_MAX_SLOTS)
+        return NULL;
+    for (int n = 0; n < ImNodeGraphFileSection_COUNT; n++)
+    {
+        const ImNodeGraphFileRange& section = header->Sections[n];
+        const ImU64 expected_size = CalcFileSectionSize(header, n);
+        if (section.Offset % IMNODEGRAPH_FILE_ALIGNMENT != 0 || section.Offset < sizeof(ImNodeGraphFileHeader) || section.Offset > file->Size || section.Size > file->Size - section.Offset)
+            return NULL;
+        if (expected_size != (ImU64)-1 && section.Size != expected_size)
+            return NULL;
+    }
+
+    const ImU32 node_count = header->NodeCount, pin_count = header->PinCount, link_count = header->LinkCount;
+    if (!ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_NodeFirstPin), node_count, pin_count, true) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_PinNode), pin_count, node_count, false) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_PinNextPin), pin_count, pin_count, true) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_PinFirstLink), pin_count, link_count, true) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_LinkStartPin), link_count, pin_count, false) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_LinkEndPin), link_count, pin_count, false) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_LinkNextAtStart), link_count, link_count, true) ||
+        !ValidateFileHandles(GetFileSection(file, header, ImNodeGraphFileSection_LinkNextAtEnd), link_count, link_count, true))
+        return NULL;
+    if (!ValidateFileChains(file, header))
+        return NULL;
+    if (!ValidateFileVectors(GetFileSection(file, header, ImNodeGraphFileSection_NodePos), node_count, -IMNODEGRAPH_FILE_MAX_COORD, IMNODEGRAPH_FILE_MAX_COORD) ||
+        !ValidateFileVectors(GetFileSection(file, header, ImNodeGraphFileSection_NodeSize), node_count, 0.0f, IMNODEGRAPH_FILE_MAX_NODE_SIZE) ||
+        !ValidateFileVectors(GetFileSection(file, header, ImNodeGraphFileSection_PinOffset), pin_count, -IMNODEGRAPH_FILE_MAX_NODE_SIZE, IMNODEGRAPH_FILE_MAX_NODE_SIZE))
+        return NULL;
+    const ImNodeGraphFileRange* payloads = (const ImNodeGraphFileRange*)GetFileSection(file, header, ImNodeGraphFileSection_NodePayload);
+    const ImU64 payload_data_size = header->Sections[ImNodeGraphFileSection_PayloadData].Size;
+    for (ImU32 n = 0; n < node_count; n++)
+        if (payloads[n].Offset > payload_data_size || payloads[n].Size > payload_data_size - payloads[n].Offset)
+            return NULL;
+    if (!BuildFileIDMap(GetFileSection(file, header, ImNodeGraphFileSection_NodeID), node_count, out_node_map) ||
+        !BuildFileIDMap(GetFileSection(file, header, ImNodeGraphFileSection_PinID), pin_count, out_pin_map) ||
+        !BuildFileIDMap(GetFileSection(file, header, ImNodeGraphFileSection_LinkID), link_count, out_link_map))
+        return NULL;
+    return header;
+}
+
+template<typename T>
+static void DetachColumn(ImVector<T>& column, bool copy)
+{
+    T* data = NULL;
+    if (copy && column.Size > 0)
+    {
+        data = (T*)IM_ALLOC((size_t)column.Size * sizeof(T));
+        memcpy(data, column.Data, (size_t)column.Size * sizeof(T));
+    }
+    column.Data = data;
+    if (data == NULL)
+        column.Size = column.Capacity = 0;
+}
+
+void ImNodeGraph::DetachMappedColumns(ImNodeGraphData* graph, bool copy)
+{
+    if (!graph->ColumnsMapped)
+        return;
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    DetachColumn(nodes.ID, copy);
+    DetachColumn(nodes.Pos, copy);
+    DetachColumn(nodes.Size, copy);
+    DetachColumn(nodes.FirstPin, copy);
+    DetachColumn(pins.ID, copy);
+    DetachColumn(pins.Node, copy);
+    DetachColumn(pins.Offset, copy);
+    DetachColumn(pins.Direction, copy);
+    DetachColumn(pins.Type, copy);
+    DetachColumn(pins.NextPin, copy);
+    DetachColumn(pins.FirstLink, copy);
+    DetachColumn(links.ID, copy);
+    DetachColumn(links.StartPin, copy);
+    DetachColumn(links.EndPin, copy);
+    DetachColumn(links.NextAtStart, copy);
+    DetachColumn(links.NextAtEnd, copy);
+    graph->ColumnsMapped = false;
+}
+
+template<typename T>
+static void MapColumn(ImVector<T>& column, const ImNodeGraphMappedFile* file, const ImNodeGraphFileHeader* header, ImNodeGraphFileSection section, int count)
+{
+    IM_ASSERT(column.Data == NULL);
+    column.Data = (T*)(void*)(file->Data + header->Sections[section].Offset);
+    column.Size = column.Capacity = count;
+}
+
+void ImNodeGraph::ClearGraphStorage(ImNodeGraphData* graph)
+{
+    IM_ASSERT(GImNodeGraph->CurrentNode == 0 && "Can't clear a graph while submitting one of its nodes");
+    DetachMappedColumns(graph, false);
+    if (graph->File != NULL)
+        UnmapFile(graph->File);
+    graph->File = NULL;
+    graph->Nodes.~ImNodeGraphNodePool();
+    graph->Pins.~ImNodeGraphPinPool();
+    graph->Links.~ImNodeGraphLinkPool();
+    IM_PLACEMENT_NEW(&graph->Nodes) ImNodeGraphNodePool();
+    IM_PLACEMENT_NEW(&graph->Pins) ImNodeGraphPinPool();
+    IM_PLACEMENT_NEW(&graph->Links) ImNodeGraphLinkPool();
+    graph->NodeMap.Clear();
+    graph->PinMap.Clear();
+    graph->LinkMap.Clear();
+    graph->NodeGrid.Clear();
+    graph->Minimap.Clear();
+    graph->Selection.Clear();
+    graph->PinGrid.Clear();
+    graph->LinkGrid.Clear();
+    graph->DepthCounter = 0;
+    graph->LinkPoints.clear();
+    graph->LinkPointsUnused = 0;
+    graph->EvalActive = false;
+    graph->TopoNodes.clear();
+    graph->TopoHoles = 0;
+    graph->CyclicLinks.clear();
+    graph->DirtyNodes.clear();
+    graph->Undo.Clear();
+    CancelLayoutJob(graph);
+    StopLayoutAnimation(graph, false);
+    CancelRouteJob(graph);
+    graph->LayoutTracking = false;
+    graph->LayoutChanges.clear();
+    graph->VisibleNodes.resize(0);
+    graph->VisibleLinks.resize(0);
+    graph->Interaction = ImNodeGraphInteraction_None;
+    graph->DragGroupPending = false;
+    graph->DragBoundaryLinks.resize(0);
+    graph->DragLinkPin = graph->HoveredNode = graph->HoveredPin = graph->HoveredLink = 0;
+    graph->LinkCreated = false;
+}
+
+template<typename T>
+static void GatherFileColumn(const ImVector<T>& column, const ImNodeGraphSlots& slots, ImVector<char>* out)
+{
+    out->resize(slots.AliveCount * (int)sizeof(T));
+    T* dst = (T*)(void*)out->Data;
+    for (int n = 0; n < slots.GetSize(); n++)
+        if (slots.IsSlotAlive(n))
+            *dst++ = column[n];
+}
+
+static void GatherFileHandles(const ImVector<ImNodeGraphHandle>& column, const ImNodeGraphSlots& slots, const ImVector<ImNodeGraphHandle>& remap, ImVector<char>* out)
+{
+    out->resize(slots.AliveCount * (int)sizeof(ImNodeGraphHandle));
+    ImNodeGraphHandle* dst = (ImNodeGraphHandle*)(void*)out->Data;
+    for (int n = 0; n < slots.GetSize(); n++)
+        if (slots.IsSlotAlive(n))
+            *dst++ = column[n] ? remap[ImNodeGraphHandleIndex(column[n])] : 0;
+}
+
+// Slot -> handle the element gets in the file
+static void BuildFileHandles(const ImNodeGraphSlots& slots, ImVector<ImNodeGraphHandle>* out)
+{
+    out->resize(slots.GetSize());
+    ImU32 dense_idx = 0;
+    for (int n = 0; n < slots.GetSize(); n++)
+        (*out)[n] = slots.IsSlotAlive(n) ? ((1u << IMNODEGRAPH_HANDLE_INDEX_BITS) | dense_idx++) : 0;
+}
+
+// Pad up to the start of the section, then write its content unless 'data' is NULL
+static bool WriteFileSection(ImFileHandle f, const ImNodeGraphFileHeader& header, ImNodeGraphFileSection section, const void* data, ImU64* written)
+{
+    static const char padding[IMNODEGRAPH_FILE_ALIGNMENT] = {};
+    const ImNodeGraphFileRange& range = header.Sections[section];
+    IM_ASSERT(range.Offset >= *written && range.Offset - *written < IMNODEGRAPH_FILE_ALIGNMENT);
+    if (ImFileWrite(padding, 1, range.Offset - *written, f) != range.Offset - *written)
+        return false;
+    *written = range.Offset;
+    if (data == NULL)
+        return true;
+    if (ImFileWrite(data, 1, range.Size, f) != range.Size)
+        return false;
+    *written += range.Size;
+    return true;
+}
+
+bool ImNodeGraph::SaveGraph(const char* filename, ImNodeGraphPayloadCallback payload_callback, void* user_data)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SaveGraph() must be called between BeginGraph() and EndGraph()");
+    if (!IsLittleEndianHost())
+        return false;
+    IMNODEGRAPH_PROFILE_ZONE("SaveGraph");
+    CommitDragGroup(graph);
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+
+    // Payloads are only written after the columns, keep them at hand
+    ImVector<ImNodeGraphFileRange> payloads;
+    ImVector<const void*> payload_data;
+    payloads.resize(nodes.Slots.AliveCount);
+    payload_data.resize(nodes.Slots.AliveCount);
+    ImU64 payload_total = 0;
+    for (int node_idx = 0, n = 0; node_idx < nodes.Slots.GetSize(); node_idx++)
+    {
+        if (!nodes.Slots.IsSlotAlive(node_idx))
+            continue;
+        size_t size = 0;
+        payload_data[n] = payload_callback ? payload_callback(nodes.ID[node_idx], &size, user_data) : NULL;
+        payloads[n].Offset = payload_total;
+        payloads[n].Size = payload_data[n] ? (ImU64)size : 0;
+        payload_total += payloads[n].Size;
+        n++;
+    }
+
+    ImNodeGraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, IMNODEGRAPH_FILE_MAGIC, sizeof(header.Magic));
+    header.Version = IMNODEGRAPH_FILE_VERSION;
+    header.SectionCount = ImNodeGraphFileSection_COUNT;
+    header.NodeCount = (ImU32)nodes.Slots.AliveCount;
+    header.PinCount = (ImU32)pins.Slots.AliveCount;
+    header.LinkCount = (ImU32)links.Slots.AliveCount;
+    ImU64 offset = sizeof(ImNodeGraphFileHeader);
+    for (int n = 0; n < ImNodeGraphFileSection_COUNT; n++)
+    {
+        const ImU64 size = (n == ImNodeGraphFileSection_PayloadData) ? payload_total : CalcFileSectionSize(&header, n);
+        offset = (offset + IMNODEGRAPH_FILE_ALIGNMENT - 1) & ~(ImU64)(IMNODEGRAPH_FILE_ALIGNMENT - 1);
+        header.Sections[n].Offset = offset;
+        header.Sections[n].Size = size;
+        offset += size;
+    }
+    header.FileSize = offset;
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    ImVector<ImNodeGraphHandle> node_handles, pin_handles, link_handles;
+    BuildFileHandles(nodes.Slots, &node_handles);
+    BuildFileHandles(pins.Slots, &pin_handles);
+    BuildFileHandles(links.Slots, &link_handles);
+
+    // One column at a time, the scratch buffer never holds more than a section
+    ImVector<char> buf;
+    ImU64 written = sizeof(header);
+    bool ok = ImFileWrite(&header, 1, sizeof(header), f) == sizeof(header);
+    for (int n = 0; ok && n < ImNodeGraphFileSection_COUNT; n++)
+    {
+        switch (n)
+        {
+        case ImNodeGraphFileSection_NodeID:             GatherFileColumn(nodes.ID, nodes.Slots, &buf); break;
+        case ImNodeGraphFileSection_NodePos:            GatherFileColumn(nodes.Pos, nodes.Slots, &buf); break;
+        case ImNodeGraphFileSection_NodeSize:           GatherFileColumn(nodes.Size, nodes.Slots, &buf); break;
+        case ImNodeGraphFileSection_NodeFirstPin:       GatherFileHandles(nodes.FirstPin, nodes.Slots, pin_handles, &buf); break;
+        case ImNodeGraphFileSection_PinID:              GatherFileColumn(pins.ID, pins.Slots, &buf); break;
+        case ImNodeGraphFileSection_PinNode:            GatherFileHandles(pins.Node, pins.Slots, node_handles, &buf); break;
+        case ImNodeGraphFileSection_PinOffset:          GatherFileColumn(pins.Offset, pins.Slots, &buf); break;
+        case ImNodeGraphFileSection_PinDirection:       GatherFileColumn(pins.Direction, pins.Slots, &buf); break;
+        case ImNodeGraphFileSection_PinType:            GatherFileColumn(pins.Type, pins.Slots, &buf); break;
+        case ImNodeGraphFileSection_PinNextPin:         GatherFileHandles(pins.NextPin, pins.Slots, pin_handles, &buf); break;
+        case ImNodeGraphFileSection_PinFirstLink:       GatherFileHandles(pins.FirstLink, pins.Slots, link_handles, &buf); break;
+        case ImNodeGraphFileSection_LinkID:             GatherFileColumn(links.ID, links.Slots, &buf); break;
+        case ImNodeGraphFileSection_LinkStartPin:       GatherFileHandles(links.StartPin, links.Slots, pin_handles, &buf); break;
+        case ImNodeGraphFileSection_LinkEndPin:         GatherFileHandles(links.EndPin, links.Slots, pin_handles, &buf); break;
+        case ImNodeGraphFileSection_LinkNextAtStart:    GatherFileHandles(links.NextAtStart, links.Slots, link_handles, &buf); break;
+        case ImNodeGraphFileSection_LinkNextAtEnd:      GatherFileHandles(links.NextAtEnd, links.Slots, link_handles, &buf); break;
+        }
+        const void* data = (n == ImNodeGraphFileSection_NodePayload) ? (const void*)payloads.Data : (n == ImNodeGraphFileSection_PayloadData) ? NULL : (const void*)buf.Data;
+        ok = WriteFileSection(f, header, (ImNodeGraphFileSection)n, data, &written);
+    }
+    for (int n = 0; ok && n < payloads.Size; n++)
+        ok = ImFileWrite(payload_data[n], 1, payloads[n].Size, f) == payloads[n].Size;
+    ImFileClose(f);
+    return ok;
+}
+
+template<typename T>
+static void SwapBytes(T& a, T& b)
+{
+    char tmp[sizeof(T)];
+    memcpy(tmp, (void*)&a, sizeof(T));
+    memcpy((void*)&a, (void*)&b, sizeof(T));
+    memcpy((void*)&b, tmp, sizeof(T));
+}
+
+bool ImNodeGraph::LoadGraph(const char* filename)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "LoadGraph() must be called between BeginGraph() and EndGraph()");
+    if (!IsLittleEndianHost())
+        return false;
+    IMNODEGRAPH_PROFILE_ZONE("LoadGraph");
+    ImNodeGraphMappedFile* file = MapFile(filename);
+    if (file == NULL)
+        return false;
+    ImNodeGraphIDMap node_map, pin_map, link_map;
+    const ImNodeGraphFileHeader* header = ValidateGraphFile(file, &node_map, &pin_map, &link_map);
+    if (header == NULL)
+    {
+        UnmapFile(file);
+        return false;
+    }
+    ClearGraphStorage(graph);
+    SwapBytes(graph->NodeMap, node_map);
+    SwapBytes(graph->PinMap, pin_map);
+    SwapBytes(graph->LinkMap, link_map);
+    graph->File = file;
+    graph->ColumnsMapped = true;
+
+    // Columns stored in the file are used as they are, the others start as they would for new elements
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    const int node_count = (int)header->NodeCount, pin_count = (int)header->PinCount, link_count = (int)header->LinkCount;
+    MapColumn(nodes.ID, file, header, ImNodeGraphFileSection_NodeID, node_count);
+    MapColumn(nodes.Pos, file, header, ImNodeGraphFileSection_NodePos, node_count);
+    MapColumn(nodes.Size, file, header, ImNodeGraphFileSection_NodeSize, node_count);
+    MapColumn(nodes.FirstPin, file, header, ImNodeGraphFileSection_NodeFirstPin, node_count);
+    MapColumn(pins.ID, file, header, ImNodeGraphFileSection_PinID, pin_count);
+    MapColumn(pins.Node, file, header, ImNodeGraphFileSection_PinNode, pin_count);
+    MapColumn(pins.Offset, file, header, ImNodeGraphFileSection_PinOffset, pin_count);
+    MapColumn(pins.Direction, file, header, ImNodeGraphFileSection_PinDirection, pin_count);
+    MapColumn(pins.Type, file, header, ImNodeGraphFileSection_PinType, pin_count);
+    MapColumn(pins.NextPin, file, header, ImNodeGraphFileSection_PinNextPin, pin_count);
+    MapColumn(pins.FirstLink, file, header, ImNodeGraphFileSection_PinFirstLink, pin_count);
+    MapColumn(links.ID, file, header, ImNodeGraphFileSection_LinkID, link_count);
+    MapColumn(links.StartPin, file, header, ImNodeGraphFileSection_LinkStartPin, link_count);
+    MapColumn(links.EndPin, file, header, ImNodeGraphFileSection_LinkEndPin, link_count);
+    MapColumn(links.NextAtStart, file, header, ImNodeGraphFileSection_LinkNextAtStart, link_count);
+    MapColumn(links.NextAtEnd, file, header, ImNodeGraphFileSection_LinkNextAtEnd, link_count);
+
+    nodes.Slots.Generations.resize(node_count, 1);
+    nodes.Slots.AliveCount = node_count;
+    nodes.GridRange.resize(node_count, ImNodeGraphGridRange());
+    nodes.RouteRect.resize(node_count, ImRect());
+    nodes.Depth.resize(node_count);
+    for (int n = 0; n < node_count; n++)
+        nodes.Depth[n] = (ImU32)n + 1;
+    graph->DepthCounter = (ImU32)node_count;
+    nodes.VisibleFrame.resize(node_count, -1);
+    nodes.DrawOrder.resize(node_count, -1);
+    nodes.DrawCache.resize(node_count, NULL);
+    nodes.TopoOrder.resize(node_count, -1);
+    nodes.TopoVisit.resize(node_count, 0);
+    nodes.Dirty.resize(node_count, false);
+    nodes.ComputeCallback.resize(node_count, NULL);
+    nodes.ComputeUserData.resize(node_count, NULL);
+    nodes.Parent.resize(node_count, 0);
+    nodes.FirstChild.resize(node_count, 0);
+    nodes.NextSibling.resize(node_count, 0);
+    nodes.Collapsed.resize(node_count, false);
+    nodes.Hidden.resize(node_count, false);
+    nodes.GroupState.resize(node_count, NULL);
+    ImNodeGraphSelection& sel = graph->Selection;
+    sel.Bits.resize((node_count + 63) / 64);
+    sel.Alive.resize(sel.Bits.Size);
+    for (int word = 0; word < sel.Bits.Size; word++)
+    {
+        sel.Bits[word] = 0;
+        sel.Alive[word] = (word == node_count / 64) ? (((ImU64)1 << (node_count & 63)) - 1) : ~(ImU64)0;
+    }
+    pins.Slots.Generations.resize(pin_count, 1);
+    pins.Slots.AliveCount = pin_count;
+    pins.GridRange.resize(pin_count, ImNodeGraphGridRange());
+    links.Slots.Generations.resize(link_count, 1);
+    links.Slots.AliveCount = link_count;
+    links.Geometry.resize(link_count, ImNodeGraphLinkGeometry());
+    links.Cyclic.resize(link_count, false);
+
+    // Spatial index, the lookup tables were built by ValidateGraphFile()
+    for (int n = 0; n < node_count; n++)
+    {
+        graph->NodeGrid.Update(n, &nodes.GridRange[n], nodes.GetRect(n));
+        UpdateMinimapCell(graph, ImNodeGraphGridRange(), nodes.GridRange[n]);
+        nodes.RouteRect[n] = nodes.GetRect(n);
+    }
+    for (int n = 0; n < pin_count; n++)
+    {
+        const ImVec2 pos = GetPinCanvasPos(graph, n);
+        graph->PinGrid.Update(n, &pins.GridRange[n], ImRect(pos, pos));
+    }
+    for (int n = 0; n < link_count; n++)
+        UpdateLinkGeometry(graph, n);
+    return true;
+}
+
+// The ID section of the file is never written: mapped columns are only written in place by moves, and are copied
+// before any slot is reused.
+const void* ImNodeGraph::GetNodePayload(ImGuiID node_id, size_t* out_size)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL);
+    if (out_size)
+        *out_size = 0;
+    const ImNodeGraphMappedFile* file = graph->File;
+    const ImNodeGraphHandle node = FindNode(graph, node_id);
+    if (file == NULL || node == 0)
+        return NULL;
+    const ImNodeGraphFileHeader* header = (const ImNodeGraphFileHeader*)(const void*)file->Data;
+    const int node_idx = ImNodeGraphHandleIndex(node);
+    if ((ImU32)node_idx >= header->NodeCount || ((const ImGuiID*)GetFileSection(file, header, ImNodeGraphFileSection_NodeID))[node_idx] != node_id)
+        return NULL;
+    const ImNodeGraphFileRange& payload = ((const ImNodeGraphFileRange*)GetFileSection(file, header, ImNodeGraphFileSection_NodePayload))[node_idx];
+    if (payload.Size == 0)
+        return NULL;
+    if (out_size)
+        *out_size = (size_t)payload.Size;
+    return file->Data + header->Sections[ImNodeGraphFileSection_PayloadData].Offset + payload.Offset;
+}
+
+// Storage is only referred to by index and handle, moving it between graphs is safe (the same goes for ImPool relocating graphs)
+void ImNodeGraph::SwapGraphStorage(ImNodeGraphData* a, ImNodeGraphData* b)
+{
+    IM_ASSERT(a->File == NULL && b->File == NULL);
+    SwapBytes(a->Nodes, b->Nodes);
+    SwapBytes(a->Pins, b->Pins);
+    SwapBytes(a->Links, b->Links);
+    SwapBytes(a->NodeMap, b->NodeMap);
+    SwapBytes(a->PinMap, b->PinMap);
+    SwapBytes(a->LinkMap, b->LinkMap);
+    SwapBytes(a->NodeGrid, b->NodeGrid);
+    SwapBytes(a->PinGrid, b->PinGrid);
+    SwapBytes(a->LinkGrid, b->LinkGrid);
+    a->LinkPoints.swap(b->LinkPoints);
+    ImSwap(a->DepthCounter, b->DepthCounter);
+    ImSwap(a->LinkPointsUnused, b->LinkPointsUnused);
+    a->Selection.Bits.swap(b->Selection.Bits);
+    a->Selection.Alive.swap(b->Selection.Alive);
+    ImSwap(a->Selection.Count, b->Selection.Count);
+    SwapBytes(a->Minimap.Cells, b->Minimap.Cells);
+    a->Minimap.Version++;
+    b->Minimap.Version++;
+}
+
+// Output goes through a fixed-size buffer, flushed to the write function whenever it is full
+struct ImNodeGraphJsonWriter
+{
+    ImNodeGraphWriteFunc    WriteFunc;
+    void*                   UserData;
+    int                     Size;
+    bool                    Error;
+    char                    Buf[IMNODEGRAPH_JSON_CHUNK_SIZE];
+
+    ImNodeGraphJsonWriter(ImNodeGraphWriteFunc write_func, void* user_data) { WriteFunc = write_func; UserData = user_data; Size = 0; Error = false; }
+    void Flush()
+    {
+        if (Size > 0 && !Error && !WriteFunc(Buf, (size_t)Size, UserData))
+            Error = true;
+        Size = 0;
+    }
+    void Write(const char* data, int len)
+    {
+        while (len > 0)
+        {
+            if (Size == IM_ARRAYSIZE(Buf))
+                Flush();
+            const int n = ImMin(len, IM_ARRAYSIZE(Buf) - Size);
+            memcpy(Buf + Size, data, (size_t)n);
+            Size += n;
+            data += n;
+            len -= n;
+        }
+    }
+    void Writef(const char* fmt, ...) IM_FMTARGS(2)
+    {
+        char tmp[256];
+        va_list args;
+        va_start(args, fmt);
+        const int len = ImFormatStringV(tmp, IM_ARRAYSIZE(tmp), fmt, args);
+        va_end(args);
+        Write(tmp, len);
+    }
+};
+
+// Pull tokenizer over input read in fixed-size chunks. Only short strings (member names, enums) are kept, longer
+// ones and unknown values are skipped as they stream by.
+struct ImNodeGraphJsonReader
+{
+    ImNodeGraphReadFunc     ReadFunc;
+    void*                   UserData;
+    int                     Pos;
+    int                     Size;
+    bool                    Eof;
+    bool                    Error;
+    char                    Buf[IMNODEGRAPH_JSON_CHUNK_SIZE];
+
+    ImNodeGraphJsonReader(ImNodeGraphReadFunc read_func, void* user_data) { ReadFunc = read_func; UserData = user_data; Pos = Size = 0; Eof = Error = false; }
+    bool Fail()             { Error = true; return false; }
+    int  Peek()             // -1 at the end of the input or after an error
+    {
+        if (Pos == Size)
+        {
+            if (Eof || Error)
+                return -1;
+            const size_t read_size = ReadFunc(Buf, sizeof(Buf), UserData);
+            IM_ASSERT(read_size <= sizeof(Buf));
+            Pos = 0;
+            Size = (int)read_size;
+            if (read_size == 0)
+            {
+                Eof = true;
+                return -1;
+            }
+        }
+        return Error ? -1 : (unsigned char)Buf[Pos];
+    }
+    int  Get()              { const int c = Peek(); if (c >= 0) Pos++; return c; }
+    int  PeekToken()        { int c = Peek(); while (c == ' ' || c == '\t' || c == '\n' || c == '\r') { Pos++; c = Peek(); } return c; }
+    bool Expect(char c)     { if (PeekToken() != c) return Fail(); Pos++; return true; }
+};
+
+// Strings which don't fit 'out' are read as empty, they can't match anything we look for
+static bool JsonReadString(ImNodeGraphJsonReader& r, char* out, int out_size)
+{
+    if (!r.Expect('"'))
+        return false;
+    int len = 0;
+    bool truncated = false;
+    for (int c = r.Get(); c != '"'; c = r.Get())
+    {
+        if (c < 0x20) // Control character or end of input
+            return r.Fail();
+        if (c == '\\')
+        {
+            c = r.Get();
+            if (c == 'u')
+            {
+                for (int n = 0; n < 4; n++)
+                {
+                    const int x = r.Get();
+                    if (!((x >= '0' && x <= '9') || (x >= 'a' && x <= 'f') || (x >= 'A' && x <= 'F')))
+                        return r.Fail();
+                }
+                c = '?';
+            }
+            else if (c == 'n') c = '\n';
+            else if (c == 't') c = '\t';
+            else if (c == 'r') c = '\r';
+            else if (c == 'b') c = '\b';
+            else if (c == 'f') c = '\f';
+            else if (c != '"' && c != '\\' && c != '/')
+                return r.Fail();
+        }
+        if (len + 1 < out_size)
+            out[len++] = (char)c;
+        else
+            truncated = true;
+    }
+    if (out_size > 0)
+        out[truncated ? 0 : len] = 0;
+    return true;
+}
+
+static bool JsonReadNumber(ImNodeGraphJsonReader& r, double* out)
+{
+    char buf[64];
+    int len = 0;
+    for (int c = r.PeekToken(); (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'; c = r.Peek())
+    {
+        if (len + 1 == IM_ARRAYSIZE(buf))
+            return r.Fail();
+        buf[len++] = (char)r.Get();
+    }
+    buf[len] = 0;
+    char* end = NULL;
+    *out = strtod(buf, &end);
+    if (len == 0 || end != buf + len)
+        return r.Fail();
+    return true;
+}
+
+static bool JsonReadID(ImNodeGraphJsonReader& r, ImGuiID* out)
+{
+    double value;
+    if (!JsonReadNumber(r, &value) || value < 0.0 || value > (double)0xFFFFFFFFu || value != (double)(ImU32)value)
+        return r.Fail();
+    *out = (ImGuiID)value;
+    return true;
+}
+
+static bool JsonReadVec2(ImNodeGraphJsonReader& r, ImVec2* out)
+{
+    double x, y;
+    if (!r.Expect('[') || !JsonReadNumber(r, &x) || !r.Expect(',') || !JsonReadNumber(r, &y) || !r.Expect(']'))
+        return false;
+    *out = ImVec2((float)x, (float)y);
+    return true;
+}
+
+// Iterative, skipping deeply nested values takes no stack
+static bool JsonSkipValue(ImNodeGraphJsonReader& r)
+{
+    int depth = 0;
+    do
+    {
+        const int c = r.PeekToken();
+        if (c == '{' || c == '[')
+        {
+            r.Pos++;
+            depth++;
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (depth == 0)
+                return r.Fail();
+            r.Pos++;
+            depth--;
+        }
+        else if (c == ',' || c == ':')
+        {
+            if (depth == 0)
+                return r.Fail();
+            r.Pos++;
+        }
+        else if (c == '"')
+        {
+            if (!JsonReadString(r, NULL, 0))
+                return false;
+        }
+        else if (c == '-' || (c >= '0' && c <= '9'))
+        {
+            double value;
+            if (!JsonReadNumber(r, &value))
+                return false;
+        }
+        else if (c >= 'a' && c <= 'z')
+        {
+            char word[8];
+            int len = 0;
+            for (int w = r.Peek(); w >= 'a' && w <= 'z' && len + 1 < IM_ARRAYSIZE(word); w = r.Peek())
+                word[len++] = (char)r.Get();
+            word[len] = 0;
+            if (strcmp(word, "true") != 0 && strcmp(word, "false") != 0 && strcmp(word, "null") != 0)
+                return r.Fail();
+        }
+        else
+        {
+            return r.Fail();
+        }
+    }
+    while (depth > 0);
+    return true;
+}
+
+// Iterate the members of an object whose '{' was consumed, false at the closing '}' or on error
+static bool JsonNextMember(ImNodeGraphJsonReader& r, bool* first, char* key, int key_size)
+{
+    if (r.PeekToken() == '}')
+    {
+        r.Pos++;
+        return false;
+    }
+    if (!*first && !r.Expect(','))
+        return false;
+    *first = false;
+    return JsonReadString(r, key, key_size) && r.Expect(':');
+}
+
+// Iterate the elements of an array whose '[' was consumed
+static bool JsonNextElement(ImNodeGraphJsonReader& r, bool* first)
+{
+    if (r.PeekToken() == ']')
+    {
+        r.Pos++;
+        return false;
+    }
+    if (!*first && !r.Expect(','))
+        return false;
+    *first = false;
+    return !r.Error;
+}
+
+struct ImNodeGraphJsonPin
+{
+    ImGuiID                 ID;
+    ImPinDirection          Direction;
+    ImPinType               Type;
+    ImVec2                  Offset;
+};
+
+struct ImNodeGraphJsonLink
+{
+    ImGuiID                 ID;
+    ImGuiID                 StartPinID;
+    ImGuiID                 EndPinID;
+};
+
+static bool JsonReadPin(ImNodeGraphJsonReader& r, ImNodeGraphJsonPin* pin)
+{
+    char key[16];
+    bool first = true, has_id = false;
+    pin->Direction = ImPinDirection_Input;
+    pin->Type = 0;
+    pin->Offset = ImVec2(0.0f, 0.0f);
+    if (!r.Expect('{'))
+        return false;
+    while (JsonNextMember(r, &first, key, IM_ARRAYSIZE(key)))
+    {
+        double value;
+        if (strcmp(key, "id") == 0)
+            has_id = JsonReadID(r, &pin->ID);
+        else if (strcmp(key, "direction") == 0)
+        {
+            char direction[8];
+            if (!JsonReadString(r, direction, IM_ARRAYSIZE(direction)))
+                return false;
+            if (strcmp(direction, "input") == 0)
+                pin->Direction = ImPinDirection_Input;
+            else if (strcmp(direction, "output") == 0)
+                pin->Direction = ImPinDirection_Output;
+            else
+                return r.Fail();
+        }
+        else if (strcmp(key, "type") == 0)
+        {
+            if (!JsonReadNumber(r, &value) || value < 0.0 || value > (double)INT_MAX || value != (double)(int)value)
+                return r.Fail();
+            pin->Type = (ImPinType)value;
+        }
+        else if (strcmp(key, "offset") == 0)
+            JsonReadVec2(r, &pin->Offset);
+        else
+            JsonSkipValue(r);
+    }
+    return !r.Error && (has_id || r.Fail());
+}
+
+static bool JsonReadNodes(ImNodeGraphJsonReader& r, ImNodeGraphData* graph, ImVector<ImNodeGraphJsonPin>* pins)
+{
+    if (!r.Expect('['))
+        return false;
+    bool first_node = true;
+    while (JsonNextElement(r, &first_node))
+    {
+        // Members may come in any order, pins are kept until the node itself can be created
+        char key[16];
+        bool first = true, has_id = false;
+        ImGuiID node_id = 0;
+        ImVec2 pos(0.0f, 0.0f), size(0.0f, 0.0f);
+        pins->resize(0);
+        if (!r.Expect('{'))
+            return false;
+        while (JsonNextMember(r, &first, key, IM_ARRAYSIZE(key)))
+        {
+            if (strcmp(key, "id") == 0)
+                has_id = JsonReadID(r, &node_id);
+            else if (strcmp(key, "pos") == 0)
+                JsonReadVec2(r, &pos);
+            else if (strcmp(key, "size") == 0)
+                JsonReadVec2(r, &size);
+            else if (strcmp(key, "pins") == 0)
+            {
+                bool first_pin = true;
+                if (!r.Expect('['))
+                    return false;
+                while (JsonNextElement(r, &first_pin))
+                {
+                    pins->resize(pins->Size + 1);
+                    if (!JsonReadPin(r, &pins->back()))
+                        return false;
+                }
+            }
+            else
+                JsonSkipValue(r);
+        }
+        if (r.Error || !has_id || ImNodeGraph::FindNode(graph, node_id) != 0)
+            return r.Fail();
+
+        const ImNodeGraphHandle node = ImNodeGraph::CreateNode(graph, node_id, pos);
+        const int node_idx = ImNodeGraphHandleIndex(node);
+        graph->Nodes.Size[node_idx] = size;
+        for (int n = 0; n < pins->Size; n++)
+        {
+            const ImNodeGraphJsonPin& pin = (*pins)[n];
+            if (ImNodeGraph::FindPin(graph, pin.ID) != 0)
+                return r.Fail();
+            const ImNodeGraphHandle pin_handle = ImNodeGraph::CreatePin(graph, node, pin.ID, pin.Direction, pin.Type);
+            graph->Pins.Offset[ImNodeGraphHandleIndex(pin_handle)] = pin.Offset;
+        }
+        ImNodeGraph::UpdateNodeBounds(graph, node_idx);
+    }
+    return !r.Error;
+}
+
+// Same rules as Link(): links to missing pins are dropped
+static bool JsonCreateLink(ImNodeGraphData* graph, const ImNodeGraphJsonLink& link)
+{
+    if (ImNodeGraph::FindLink(graph, link.ID) != 0)
+        return false;
+    const ImNodeGraphHandle start_pin = ImNodeGraph::FindPin(graph, link.StartPinID);
+    const ImNodeGraphHandle end_pin = ImNodeGraph::FindPin(graph, link.EndPinID);
+    if (start_pin != 0 && end_pin != 0 && start_pin != end_pin)
+        ImNodeGraph::CreateLink(graph, link.ID, start_pin, end_pin);
+    return true;
+}
+
+static bool JsonReadLinks(ImNodeGraphJsonReader& r, ImNodeGraphData* graph, ImVector<ImNodeGraphJsonLink>* pending_links)
+{
+    if (!r.Expect('['))
+        return false;
+    bool first_link = true;
+    while (JsonNextElement(r, &first_link))
+    {
+        char key[16];
+        bool first = true, has_id = false, has_start = false, has_end = false;
+        ImNodeGraphJsonLink link;
+        if (!r.Expect('{'))
+            return false;
+        while (JsonNextMember(r, &first, key, IM_ARRAYSIZE(key)))
+        {
+            if (strcmp(key, "id") == 0)
+                has_id = JsonReadID(r, &link.ID);
+            else if (strcmp(key, "start") == 0)
+                has_start = JsonReadID(r, &link.StartPinID);
+            else if (strcmp(key, "end") == 0)
+                has_end = JsonReadID(r, &link.EndPinID);
+            else
+                JsonSkipValue(r);
+        }
+        if (r.Error || !has_id || !has_start || !has_end)
+            return r.Fail();
+
+        // Links read before their pins wait for the end of the file
+        if (ImNodeGraph::FindPin(graph, link.StartPinID) != 0 && ImNodeGraph::FindPin(graph, link.EndPinID) != 0)
+        {
+            if (!JsonCreateLink(graph, link))
+                return r.Fail();
+        }
+        else
+        {
+            pending_links->push_back(link);
+        }
+    }
+    return !r.Error;
+}
+
+static bool JsonReadGraph(ImNodeGraphJsonReader& r, ImNodeGraphData* graph)
+{
+    ImVector<ImNodeGraphJsonPin> pins;
+    ImVector<ImNodeGraphJsonLink> pending_links;
+    char key[16];
+    bool first = true;
+    if (!r.Expect('{'))
+        return false;
+    while (JsonNextMember(r, &first, key, IM_ARRAYSIZE(key)))
+    {
+        double version;
+        if (strcmp(key, "version") == 0)
+        {
+            if (JsonReadNumber(r, &version) && (version < 1.0 || version > IMNODEGRAPH_JSON_VERSION))
+                return r.Fail();
+        }
+        else if (strcmp(key, "nodes") == 0)
+            JsonReadNodes(r, graph, &pins);
+        else if (strcmp(key, "links") == 0)
+            JsonReadLinks(r, graph, &pending_links);
+        else
+            JsonSkipValue(r);
+    }
+    if (r.Error || r.PeekToken() != -1)
+        return false;
+    for (int n = 0; n < pending_links.Size; n++)
+        if (!JsonCreateLink(graph, pending_links[n]))
+            return false;
+    return true;
+}
+
+bool ImNodeGraph::SaveGraphJson(ImNodeGraphWriteFunc write_func, void* user_data)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "SaveGraphJson() must be called between BeginGraph() and EndGraph()");
+    IMNODEGRAPH_PROFILE_ZONE("SaveGraphJson");
+    CommitDragGroup(graph);
+    ImNodeGraphNodePool& nodes = graph->Nodes;
+    ImNodeGraphPinPool& pins = graph->Pins;
+    ImNodeGraphLinkPool& links = graph->Links;
+    ImNodeGraphJsonWriter* w = IM_NEW(ImNodeGraphJsonWriter)(write_func, user_data);
+    w->Writef("{\"version\":%d,\n\"nodes\":[", IMNODEGRAPH_JSON_VERSION);
+    const char* separator = "\n";
+    for (int node_idx = 0; node_idx < nodes.Slots.GetSize() && !w->Error; node_idx++)
+    {
+        if (!nodes.Slots.IsSlotAlive(node_idx))
+            continue;
+        const ImVec2 pos = nodes.Pos[node_idx], size = nodes.Size[node_idx];
+        w->Writef("%s{\"id\":%u,\"pos\":[%.9g,%.9g],\"size\":[%.9g,%.9g],\"pins\":[", separator, nodes.ID[node_idx], pos.x, pos.y, size.x, size.y);
+        for (ImNodeGraphHandle pin = nodes.FirstPin[node_idx]; pin != 0; pin = pins.NextPin[ImNodeGraphHandleIndex(pin)])
+        {
+            const int pin_idx = ImNodeGraphHandleIndex(pin);
+            const ImVec2 offset = pins.Offset[pin_idx];
+            w->Writef("%s{\"id\":%u,\"direction\":\"%s\",\"type\":%d,\"offset\":[%.9g,%.9g]}", pin == nodes.FirstPin[node_idx] ? "" : ",",
+                pins.ID[pin_idx], pins.Direction[pin_idx] == ImPinDirection_Output ? "output" : "input", pins.Type[pin_idx], offset.x, offset.y);
+        }
+        w->Write("]}", 2);
+        separator = ",\n";
+    }
+    w->Write("\n],\n\"links\":[", 13);
+    separator = "\n";
+    for (int link_idx = 0; link_idx < links.Slots.GetSize() && !w->Error; link_idx++)
+    {
+        if (!links.Slots.IsSlotAlive(link_idx))
+            continue;
+        w->Writef("%s{\"id\":%u,\"start\":%u,\"end\":%u}", separator, links.ID[link_idx],
+            pins.ID[ImNodeGraphHandleIndex(links.StartPin[link_idx])], pins.ID[ImNodeGraphHandleIndex(links.EndPin[link_idx])]);
+        separator = ",\n";
+    }
+    w->Write("\n]}\n", 4);
+    w->Flush();
+    const bool ok = !w->Error;
+    IM_DELETE(w);
+    return ok;
+}
+
+static bool WriteJsonToFile(const void* data, size_t size, void* user_data)
+{
+    return ImFileWrite(data, 1, (ImU64)size, (ImFileHandle)user_data) == (ImU64)size;
+}
+
+bool ImNodeGraph::SaveGraphJson(const char* filename)
+{
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    const bool ok = SaveGraphJson(WriteJsonToFile, (void*)f);
+    return ImFileClose(f) && ok;
+}
+
+// Read into a separate graph, swapped in once the whole file was read
+bool ImNodeGraph::LoadGraphJson(ImNodeGraphReadFunc read_func, void* user_data)
+{
+    ImNodeGraphData* graph = GetCurrentGraph();
+    IM_ASSERT(graph != NULL && "LoadGraphJson() must be called between BeginGraph() and EndGraph()");
+    IMNODEGRAPH_PROFILE_ZONE("LoadGraphJson");
+    ImNodeGraphJsonReader* r = IM_NEW(ImNodeGraphJsonReader)(read_func, user_data);
+    ImNodeGraphData* loaded = IM_NEW(ImNodeGraphData)();
+    const bool ok = JsonReadGraph(*r, loaded);
+    if (ok)
+    {
+        ClearGraphStorage(graph);
+        SwapGraphStorage(graph, loaded);
+    }
+    IM_DELETE(loaded);
+    IM_DELETE(r);
+    return ok;
+}
+
+static size_t ReadJsonFromFile(void* buffer, size_t size, void* user_data)
+{
+    return (size_t)ImFileRead(buffer, 1, (ImU64)size, (ImFileHandle)user_data);
+}
+
+bool ImNodeGraph::LoadGraphJson(const char* filename)
+{
+    ImFileHandle f = ImFileOpen(filename, "rb");
+    if (f == NULL)
+        return false;
+    const bool ok = LoadGraphJson(ReadJsonFromFile, (void*)f);
+    ImFileClose(f);
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Instrumentation
+//-----------------------------------------------------------------------------
+
+const ImNodeGraphFrameStats& ImNodeGraph::GetFrameStats()
+{
+    static const ImNodeGraphFrameStats empty_stats;
+    ImNodeGraphData* graph = GImNodeGraph->LastGraph;
+    return graph ? graph->Stats : empty_stats;
+}
+
+size_t ImNodeGraph::CalcGraphMemoryUsage(ImNodeGraphData* graph)
+{
+    size_t bytes = graph->Nodes.CalcMemoryUsage() + graph->Pins.CalcMemoryUsage() + graph->Links.CalcMemoryUsage();
+    bytes += graph->NodeMap.CalcMemoryUsage() + graph->PinMap.CalcMemoryUsage() + graph->LinkMap.CalcMemoryUsage();
+    bytes += graph->NodeGrid.CalcMemoryUsage() + graph->PinGrid.CalcMemoryUsage() + graph->LinkGrid.CalcMemoryUsage();
+    bytes += ImNodeGraphVectorBytes(graph->LinkPoints);
+    bytes += graph->Minimap.CalcMemoryUsage() + graph->Selection.CalcMemoryUsage() + ImNodeGraphVectorBytes(graph->DragBoundaryLinks);
+    bytes += ImNodeGraphVectorBytes(graph->TopoNodes) + ImNodeGraphVectorBytes(graph->CyclicLinks) + ImNodeGraphVectorBytes(graph->DirtyNodes) + ImNodeGraphVectorBytes(graph->TopoStack) + ImNodeGraphVectorBytes(graph->TopoLinked);
+    bytes += ImNodeGraphVectorBytes(graph->TopoForward) + ImNodeGraphVectorBytes(graph->TopoBackward) + ImNodeGraphVectorBytes(graph->TopoSlots);
+    bytes += ImNodeGraphVectorBytes(graph->ExecLocal) + ImNodeGraphVectorBytes(graph->ExecSuccStart) + ImNodeGraphVectorBytes(graph->ExecSucc);
+    bytes += graph->Undo.CalcMemoryUsage() + graph->TextWidths.CalcMemoryUsage();
+    bytes += ImNodeGraphVectorBytes(graph->LayoutChanges) + ImNodeGraphVectorBytes(graph->LayoutAnimIDs) + ImNodeGraphVectorBytes(graph->LayoutAnimFrom) + ImNodeGraphVectorBytes(graph->LayoutAnimTo);
+    if (graph->RouteScratch != NULL)
+        bytes += graph->RouteScratch->CalcMemoryUsage();
+    bytes += GImNodeGraph->FrameArena.CalcMemoryUsage(); // Shared by the graphs of the context
+
+    // Channels keep their buffers across frames
+    const ImDrawListSplitter& splitter = graph->Splitter;
+    bytes += ImNodeGraphVectorBytes(splitter._Channels);
+    for (int n = 0; n < splitter._Channels.Size; n++)
+        bytes += ImNodeGraphVectorBytes(splitter._Channels[n]._CmdBuffer) + ImNodeGraphVectorBytes(splitter._Channels[n]._IdxBuffer);
+    return bytes;
+}
+
+double ImNodeGraph::GetProfileTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int ImNodeGraph::BeginProfileZone(const char* name)
+{
+    ImNodeGraphContext* ctx = GImNodeGraph;
+    if (ctx == NULL || ctx->TraceFile == NULL)
+        return -1;
+    ImNodeGraphTraceEvent ev;
+    ev.Name = name;
+    ev.Start = (GetProfileTime() - ctx->TraceStartTime) * 1000000.0;
+    ev.Duration = -1.0;
+    ctx->TraceEvents.push_back(ev);
+    return ctx->TraceEvents.Size - 1;
+}
+
+void ImNodeGraph::EndProfileZone(int event_idx)
+{
+    ImNodeGraphContext* ctx = GImNodeGraph;
+    if (event_idx < 0 || ctx == NULL || ctx->TraceFile == NULL || event_idx >= ctx->TraceEvents.Size)
+        return; // Capture ended while the zone was open
+    ImNodeGraphTraceEvent& ev = ctx->TraceEvents[event_idx];
+    ev.Duration = (GetProfileTime() - ctx->TraceStartTime) * 1000000.0 - ev.Start;
+}
+
+ImNodeGraphProfileZone::ImNodeGraphProfileZone(const char* name)
+{
+    EventIdx = ImNodeGraph::BeginProfileZone(name);
+}
+
+ImNodeGraphProfileZone::~ImNodeGraphProfileZone()
+{
+    ImNodeGraph::EndProfileZone(EventIdx);
+}
+
+// Zones are referred to by index while open, so events are only written out once all of them are closed
+void ImNodeGraph::FlushTraceEvents(ImNodeGraphContext* ctx)
+{
+    for (int n = 0; n < ctx->TraceEvents.Size; n++)
+        if (ctx->TraceEvents[n].Duration < 0.0)
+            return;
+    ImGuiTextBuffer& buf = ctx->TraceBuffer;
+    buf.clear();
+    for (int n = 0; n < ctx->TraceEvents.Size; n++)
+    {
+        const ImNodeGraphTraceEvent& ev = ctx->TraceEvents[n];
+        buf.appendf("%s\n{\"name\":\"%s\",\"cat\":\"imnode_graph\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}", ctx->TraceFirstEvent ? "" : ",", ev.Name, ev.Start, ev.Duration);
+        ctx->TraceFirstEvent = false;
+    }
+    if (buf.size() > 0)
+        ImFileWrite(buf.c_str(), 1, (ImU64)buf.size(), ctx->TraceFile);
+    ctx->TraceEvents.resize(0);
+}
+
+bool ImNodeGraph::BeginTraceCapture(const char* filename)
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    if (g.TraceFile != NULL)
+        return false;
+    g.TraceFile = ImFileOpen(filename, "wb");
+    if (g.TraceFile == NULL)
+        return false;
+    const char* header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    ImFileWrite(header, 1, (ImU64)strlen(header), g.TraceFile);
+    g.TraceStartTime = GetProfileTime();
+    g.TraceEvents.resize(0);
+    g.TraceFirstEvent = true;
+    return true;
+}
+
+void ImNodeGraph::EndTraceCapture()
+{
+    ImNodeGraphContext& g = *GImNodeGraph;
+    if (g.TraceFile == NULL)
+        return;
+
+    // Zones still open when the capture ends are dropped
+    int closed_count = 0;
+    for (int n = 0; n < g.TraceEvents.Size; n++)
+        if (g.TraceEvents[n].Duration >= 0.0)
+            g.TraceEvents[closed_count++] = g.TraceEvents[n];
+    g.TraceEvents.resize(closed_count);
+    FlushTraceEvents(&g);
+    const char* footer = "\n]}\n";
+    ImFileWrite(footer, 1, (ImU64)strlen(footer), g.TraceFile);
+    ImFileClose(g.TraceFile);
+    g.TraceFile = NULL;
+    g.TraceBuffer.clear();
+}
+
+bool ImNodeGraph::IsTraceCaptureActive()
+{
+    return GImNodeGraph->TraceFile != NULL;
+}
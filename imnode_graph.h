@@ -0,0 +1,392 @@
+// imnode_graph: Node Graph Editor for Dear ImGui
+
+// Usage:
+// - Add imnode_graph.cpp to your project, next to the Dear ImGui sources.
+// - Create a context with ImNodeGraph::CreateContext() after ImGui::CreateContext().
+// - Inside any ImGui window:
+//
+//     ImNodeGraph::BeginGraph("My Graph");
+//     if (ImNodeGraph::BeginNode(node_id, "Multiply"))
+//     {
+//         ImNodeGraph::Pin(pin_a, "A", ImPinDirection_Input);
+//         ImNodeGraph::Pin(pin_b, "B", ImPinDirection_Input);
+//         ImNodeGraph::Pin(pin_out, "Out", ImPinDirection_Output);
+//         ImNodeGraph::EndNode();
+//     }
+//     ImNodeGraph::Link(link_id, pin_out, other_pin);
+//     ImNodeGraph::EndGraph();
+//
+// - Nodes, pins and links are retained by the graph: they persist until removed with RemoveNode()/RemoveLink().
+//   Nodes outside of the visible canvas are culled, BeginNode() returns false for them. Large graphs should
+//   only submit the nodes reported by GetVisibleNodeCount()/GetVisibleNodeID() so the per-frame cost scales
+//   with what is on screen rather than with the size of the graph.
+// - Zoomed out, nodes switch to cheaper representations drawn by the graph itself (see ImNodeGraphLod_).
+//   BeginNode() then returns false, skip any expensive per-node work when it does.
+
+#pragma once
+
+#include "imgui.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] Forward declarations and basic types
+//-----------------------------------------------------------------------------
+
+struct ImNodeGraphContext;          // Editor context, holds every graph
+struct ImNodeGraphData;             // Retained state of a single graph (internal)
+struct ImNodeGraphFrameStats;       // Counters for the last frame of a graph
+struct ImNodeGraphStyle;            // Sizes and colors
+
+typedef int ImNodeGraphFlags;       // -> enum ImNodeGraphFlags_
+typedef int ImNodeGraphCol;         // -> enum ImNodeGraphCol_
+typedef int ImNodeGraphEvalFlags;   // -> enum ImNodeGraphEvalFlags_
+typedef int ImNodeGraphLayout;      // -> enum ImNodeGraphLayout_
+typedef int ImNodeGraphLayoutFlags; // -> enum ImNodeGraphLayoutFlags_
+typedef int ImNodeGraphLod;         // -> enum ImNodeGraphLod_
+typedef int ImPinDirection;         // -> enum ImPinDirection_
+typedef int ImPinType;              // Application defined pin type, only pins of the same type can be linked unless SetPinTypeTable() allows it
+typedef void (*ImNodeGraphComputeCallback)(ImGuiID node_id, void* user_data);   // See SetNodeCompute()
+typedef void (*ImNodeGraphPropertyCallback)(ImGuiID node_id, ImGuiID property_id, const void* data, int size, void* user_data);   // See RecordPropertyChange()
+typedef const void* (*ImNodeGraphPayloadCallback)(ImGuiID node_id, size_t* out_size, void* user_data);     // See SaveGraph()
+typedef bool (*ImNodeGraphWriteFunc)(const void* data, size_t size, void* user_data);   // Return false to abort, see SaveGraphJson()
+typedef size_t (*ImNodeGraphReadFunc)(void* buffer, size_t size, void* user_data);      // Return the number of bytes read, 0 at the end, see LoadGraphJson()
+
+enum ImNodeGraphFlags_
+{
+    ImNodeGraphFlags_None           = 0,
+    ImNodeGraphFlags_NoCulling      = 1 << 0,   // Submit every node, even when outside of the visible canvas
+    ImNodeGraphFlags_NoGrid         = 1 << 1,   // Don't draw the background grid
+    ImNodeGraphFlags_NoLod          = 1 << 2,   // Always submit nodes in full, whatever the zoom
+    ImNodeGraphFlags_OrthogonalLinks = 1 << 3,  // Route links with horizontal and vertical segments around nodes instead of drawing curves
+    ImNodeGraphFlags_Minimap        = 1 << 4,   // Overview of the whole graph in the bottom-right corner. Click or drag in it to move the view.
+    ImNodeGraphFlags_NoCycles       = 1 << 5,   // Dragged links don't snap to pins they would close a cycle with, and aren't created
+};
+
+// Level of detail of the nodes, picked from the zoom and the Lod*Zoom style thresholds.
+// Below ImNodeGraphLod_Full the graph draws nodes itself from their retained size and BeginNode() returns false.
+enum ImNodeGraphLod_
+{
+    ImNodeGraphLod_Full,                        // Nodes are submitted with their title, pins and widgets
+    ImNodeGraphLod_Simple,                      // Header bar, body and pins, no text
+    ImNodeGraphLod_Box,                         // Single filled rectangle per node
+    ImNodeGraphLod_Density,                     // Spatial index cells shaded by how many nodes they hold, nodes are not visited
+};
+
+enum ImNodeGraphEvalFlags_
+{
+    ImNodeGraphEvalFlags_None           = 0,
+    ImNodeGraphEvalFlags_Parallel       = 1 << 0,   // Run independent nodes concurrently on the evaluation thread pool, callbacks must be thread-safe
+    ImNodeGraphEvalFlags_Deterministic  = 1 << 1,   // With _Parallel: same scheduling code on the calling thread only, in a reproducible order (for tests)
+};
+
+// Auto layout algorithms, see StartLayout()
+enum ImNodeGraphLayout_
+{
+    ImNodeGraphLayout_Layered,                  // Sugiyama style: nodes in columns following the links, left to right, with few crossings
+    ImNodeGraphLayout_ForceDirected,            // Links pull, nodes push each other away (Barnes-Hut approximation). Suits graphs without a main direction, nodes may still overlap
+};
+
+enum ImNodeGraphLayoutFlags_
+{
+    ImNodeGraphLayoutFlags_None         = 0,
+    ImNodeGraphLayoutFlags_Incremental  = 1 << 0,   // Only move the nodes added or relinked since the previous layout, and their direct neighbors
+    ImNodeGraphLayoutFlags_NoAnimation  = 1 << 1,   // Move nodes to their new position at once instead of over LayoutAnimDuration
+};
+
+enum ImPinDirection_
+{
+    ImPinDirection_Input,
+    ImPinDirection_Output,
+};
+
+enum ImNodeGraphCol_
+{
+    ImNodeGraphCol_GridBg,
+    ImNodeGraphCol_GridLine,
+    ImNodeGraphCol_NodeBg,
+    ImNodeGraphCol_NodeHeader,
+    ImNodeGraphCol_NodeOutline,
+    ImNodeGraphCol_NodeSelected,
+    ImNodeGraphCol_NodeTitle,
+    ImNodeGraphCol_NodeDensity,
+    ImNodeGraphCol_PinLabel,
+    ImNodeGraphCol_Pin,
+    ImNodeGraphCol_PinHovered,
+    ImNodeGraphCol_Link,
+    ImNodeGraphCol_LinkHovered,
+    ImNodeGraphCol_BoxSelect,
+    ImNodeGraphCol_BoxSelectOutline,
+    ImNodeGraphCol_MinimapBg,
+    ImNodeGraphCol_MinimapDensity,      // Occupied areas of the minimap, more opaque where nodes are denser
+    ImNodeGraphCol_MinimapViewport,
+    ImNodeGraphCol_MinimapViewportOutline,
+    ImNodeGraphCol_COUNT
+};
+
+struct ImNodeGraphStyle
+{
+    float       GridSpacing;        // Distance between grid lines, in canvas units
+    ImVec2      NodePadding;        // Padding around the node title and content
+    float       NodeRounding;       // Radius of the node corners
+    float       NodeBorderSize;     // Thickness of the node outline
+    float       PinRadius;          // Radius of the pin circles
+    float       PinHoverRadius;     // Distance from a pin center under which the pin is hovered
+    float       LinkThickness;      // Thickness of links
+    float       LinkSegmentLength;  // Target on-screen length of a link segment, links are tessellated from their length and the zoom
+    float       LinkHoverDistance;  // Distance from a link under which the link is hovered
+    float       LinkSnapDistance;   // While dragging a new link, distance under which it snaps to the nearest compatible pin
+    float       LinkRouteMargin;    // Orthogonal links: clearance kept around nodes, also the length of the straight part out of a pin
+    float       ZoomMin;            // Lower bound for the canvas zoom
+    float       ZoomMax;            // Upper bound for the canvas zoom
+    float       LodSimpleZoom;      // Below this zoom nodes are drawn as ImNodeGraphLod_Simple
+    float       LodBoxZoom;         // Below this zoom nodes are drawn as ImNodeGraphLod_Box
+    float       LodDensityZoom;     // Below this zoom nodes are drawn as ImNodeGraphLod_Density
+    ImVec2      LayoutSpacing;      // Auto layout: gap between layers (x) and between nodes of a layer (y), in canvas units. Also the link length sought by ImNodeGraphLayout_ForceDirected
+    float       LayoutAnimDuration; // Auto layout: seconds taken by nodes to reach their new position
+    ImVec2      MinimapSize;        // Size of the minimap, in pixels
+    ImVec2      MinimapOffset;      // Distance from the minimap to the bottom-right corner of the canvas
+    ImVec2      MinimapPadding;     // Space between the minimap border and the graph drawn inside
+    ImU32       Colors[ImNodeGraphCol_COUNT];
+
+    ImNodeGraphStyle();
+};
+
+// Counters gathered while a graph is submitted, see GetFrameStats()
+struct ImNodeGraphFrameStats
+{
+    int         NodesVisible;       // Nodes in the visible set
+    int         NodesSubmitted;     // BeginNode() calls which returned true
+    int         NodesCulled;        // Nodes left out of the visible set
+    int         NodeCacheHits;      // Nodes replayed from their draw cache
+    int         NodeCacheMisses;    // Nodes with a content version which had to be submitted
+    int         LinksVisible;
+    int         LinksTessellated;   // Link cache misses: visible links whose points were rebuilt
+    int         LinkCacheHits;      // Visible links drawn from their cached points
+    int         HitTests;           // Pins, nodes and link segments tested against the mouse
+    int         VtxCount;           // Vertices emitted into the window draw list, node widgets included
+    int         IdxCount;
+    int         DrawCmds;           // Draw commands added to the window draw list, close to constant however many nodes are drawn
+    size_t      BytesAllocated;     // Growth of the graph storage during the frame
+    size_t      MemoryUsage;        // Storage held by the graph at the end of the frame, per-frame scratch memory included
+
+    ImNodeGraphFrameStats()         { memset(this, 0, sizeof(*this)); }
+};
+
+// Conversion allowed from an output of type From to an input of type To, see ImPinTypeTable
+struct ImPinTypeConversion
+{
+    ImPinType   From;
+    ImPinType   To;
+};
+
+// Pin type compatibility matrix built at compile time from a list of conversions, for SetPinTypeTable().
+// Rows[t] has one bit per input type an output of type t can be linked to, same type included. Types are 0 to 63.
+//
+//     enum { PinType_Float, PinType_Int, PinType_Vec3, PinType_COUNT };
+//     static constexpr ImPinTypeConversion conversions[] = { { PinType_Int, PinType_Float }, { PinType_Float, PinType_Vec3 } };
+//     static constexpr ImPinTypeTable<PinType_COUNT> pin_types(conversions);
+//     ImNodeGraph::SetPinTypeTable(pin_types.Rows, PinType_COUNT);
+template<int... I> struct ImPinTypeIndexList {};
+template<int N, int... I> struct ImPinTypeMakeIndices : ImPinTypeMakeIndices<N - 1, N - 1, I...> {};
+template<int... I> struct ImPinTypeMakeIndices<0, I...> { typedef ImPinTypeIndexList<I...> Type; };
+
+// Single expression for C++11 constexpr, split in halves to keep the recursion depth logarithmic
+constexpr ImU64 ImPinTypeRow(ImPinType from, const ImPinTypeConversion* conversions, int count)
+{
+    return (count == 0) ? 0 : (count == 1) ? ((conversions[0].From == from) ? (ImU64)1 << conversions[0].To : 0) :
+        ImPinTypeRow(from, conversions, count / 2) | ImPinTypeRow(from, conversions + count / 2, count - count / 2);
+}
+
+template<int TYPE_COUNT>
+struct ImPinTypeTable
+{
+    static_assert(TYPE_COUNT > 0 && TYPE_COUNT <= 64, "Pin types are bits of an ImU64");
+    ImU64       Rows[TYPE_COUNT];
+
+    template<int CONVERSION_COUNT>
+    constexpr ImPinTypeTable(const ImPinTypeConversion (&conversions)[CONVERSION_COUNT]) : ImPinTypeTable(conversions, CONVERSION_COUNT, typename ImPinTypeMakeIndices<TYPE_COUNT>::Type()) {}
+    template<int... I>
+    constexpr ImPinTypeTable(const ImPinTypeConversion* conversions, int count, ImPinTypeIndexList<I...>) : Rows{ ((ImU64)1 << I) | ImPinTypeRow(I, conversions, count)... } {}
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] API
+//-----------------------------------------------------------------------------
+
+namespace ImNodeGraph
+{
+    // Context
+    IMGUI_API ImNodeGraphContext*   CreateContext();
+    IMGUI_API void                  DestroyContext(ImNodeGraphContext* ctx = NULL);  // NULL = destroy current context
+    IMGUI_API ImNodeGraphContext*   GetCurrentContext();
+    IMGUI_API void                  SetCurrentContext(ImNodeGraphContext* ctx);
+    IMGUI_API ImNodeGraphStyle&     GetStyle();
+
+    // Graph
+    // - The graph fills 'size' (0 = remaining content region) of the current window.
+    // - Right or middle mouse drag pans the canvas, mouse wheel zooms around the mouse cursor.
+    IMGUI_API void                  BeginGraph(const char* title, const ImVec2& size = ImVec2(0, 0), ImNodeGraphFlags flags = 0);
+    IMGUI_API void                  EndGraph();
+
+    // Nodes
+    // - BeginNode() returns false when the node is outside of the visible canvas or replayed from its draw cache, only call EndNode() if it returned true.
+    // - Any ImGui widget can be submitted between BeginNode() and EndNode(), the ID stack is scoped to the node.
+    // - 'content_version' opts into draw caching: pass a non-zero value and change it whenever the node content or its
+    //   look changes. While it is unchanged, the node was drawn at the same zoom and nothing inside it is hovered or
+    //   active, BeginNode() replays the draw data recorded the last time and returns false.
+    // - Dragged nodes move as a group: while the mouse is down only an offset and the links leaving the group are
+    //   updated. GetNodePos() includes it, the positions are stored when the nodes are dropped or edited.
+    IMGUI_API bool                  BeginNode(ImGuiID node_id, const char* title, ImU32 content_version = 0);
+    IMGUI_API void                  EndNode();
+    IMGUI_API void                  AddNode(ImGuiID node_id, const ImVec2& pos);        // Register a node without submitting it
+    IMGUI_API void                  RemoveNode(ImGuiID node_id);                        // Also removes its pins and every link attached to them
+    IMGUI_API void                  SetNodePos(ImGuiID node_id, const ImVec2& pos);     // Canvas space
+    IMGUI_API ImVec2                GetNodePos(ImGuiID node_id);
+    IMGUI_API ImVec2                GetNodeSize(ImGuiID node_id);                       // Size measured the last time the node was submitted
+    IMGUI_API void                  ReserveGraph(int node_count, int pin_count = 0, int link_count = 0);   // Preallocate storage before bulk loading
+
+    // Pins
+    // - Submit between BeginNode() and EndNode(). Inputs are drawn on the left edge of the node, outputs on the right edge.
+    // - SetPinTypeTable() sets which types an output can be linked to, one row of bits per output type (see
+    //   ImPinTypeTable to build it at compile time). Checking a pair of pins is a single lookup. The table is copied,
+    //   applies to every graph of the context, and types past its end can only be linked to the same type.
+    IMGUI_API void                  Pin(ImGuiID pin_id, const char* label, ImPinDirection direction, ImPinType type = 0);
+    IMGUI_API void                  AddPin(ImGuiID node_id, ImGuiID pin_id, ImPinDirection direction, ImPinType type = 0);
+    IMGUI_API void                  SetPinTypeTable(const ImU64* rows, int type_count);   // NULL to only link pins of the same type
+
+    // Links
+    // - Links are retained as well: calling Link() every frame is allowed but only the first call creates it.
+    // - Both pins must exist (submitted with Pin() or registered with AddPin()), otherwise the call is ignored.
+    // - With ImNodeGraphFlags_OrthogonalLinks, links are routed around the nodes near them (A* over the lines running
+    //   along node edges). Routes are cached and only computed again when a pin moves or a node moves on or near the
+    //   route. When many routes are stale at once, they are computed on a worker thread while the previous route, or a
+    //   plain elbow, is drawn.
+    IMGUI_API void                  Link(ImGuiID link_id, ImGuiID start_pin_id, ImGuiID end_pin_id);
+    IMGUI_API void                  RemoveLink(ImGuiID link_id);
+
+    // Groups (subgraphs), valid between BeginGraph() and EndGraph()
+    // - Any node can hold other nodes, groups can be nested. The nodes of a collapsed group are hidden: out of the spatial
+    //   index, never visible, hit-tested, selected nor moved by auto layouts, so they cost nothing per frame. Links
+    //   leaving them are drawn to the edges of the group, inputs on the left and outputs on the right.
+    // - Collapsing or expanding only visits the nodes of the group. Expanding puts them back where they were, moved along
+    //   with the group if it moved meanwhile.
+    // - Removing a group moves its nodes to the group it was in. Membership and collapsed state are not recorded in the
+    //   undo history nor saved in graph files.
+    IMGUI_API void                  SetNodeGroup(ImGuiID node_id, ImGuiID group_id);    // 0 = top level
+    IMGUI_API ImGuiID               GetNodeGroup(ImGuiID node_id);
+    IMGUI_API void                  SetGroupCollapsed(ImGuiID group_id, bool collapsed);
+    IMGUI_API bool                  IsGroupCollapsed(ImGuiID group_id);
+    IMGUI_API bool                  IsNodeHidden(ImGuiID node_id);                      // Inside a collapsed group
+
+    // Interaction queries, valid after EndGraph()
+    IMGUI_API bool                  IsLinkCreated(ImGuiID* out_start_pin_id, ImGuiID* out_end_pin_id);   // User dragged a link between two compatible pins
+    IMGUI_API bool                  IsNodeSelected(ImGuiID node_id);
+    IMGUI_API int                   GetSelectedNodeCount();
+    IMGUI_API int                   GetSelectedNodes(ImGuiID* out_node_ids, int max_count);    // Returns the number of IDs written
+    IMGUI_API int                   GetSelectionChanges(const ImGuiID** out_node_ids);        // Nodes selected or deselected during the frame, -1 when too many to be listed
+    IMGUI_API ImGuiID               GetHoveredNode();
+    IMGUI_API ImGuiID               GetHoveredPin();
+    IMGUI_API ImGuiID               GetHoveredLink();
+
+    // Selection
+    // - Call between BeginGraph() and EndGraph(). Whole graph operations run over one bit per node.
+    // - SelectDownstream() adds every node reachable from the outputs of the selected nodes.
+    IMGUI_API void                  SelectNode(ImGuiID node_id, bool selected = true);
+    IMGUI_API void                  ClearSelection();
+    IMGUI_API void                  SelectAll();
+    IMGUI_API void                  InvertSelection();
+    IMGUI_API void                  SelectDownstream();
+
+    // Canvas
+    IMGUI_API ImVec2                ScreenToCanvas(const ImVec2& screen_pos);
+    IMGUI_API ImVec2                CanvasToScreen(const ImVec2& canvas_pos);
+    IMGUI_API float                 GetZoom();
+    IMGUI_API void                  SetZoom(float zoom);
+
+    // Evaluation (optional)
+    // - Nothing is tracked until one of these functions is first called for a graph.
+    // - Nodes are evaluated in dependency order: a node runs after every node linked to its inputs. Links closing a
+    //   cycle are ignored for evaluation until the cycle is broken.
+    // - WouldLinkCloseCycle() and ImNodeGraphFlags_NoCycles use the same order: a link going forward in it can't close
+    //   a cycle, others only search the nodes between both ends in the order.
+    // - MarkNodeDirty() marks the node and everything downstream of it. Adding or removing a link marks the node on
+    //   its input side. EvaluateGraph() only runs the callbacks of dirty nodes and returns how many it ran.
+    // - Callbacks read and write application data, they must not add or remove nodes, pins or links. With
+    //   ImNodeGraphEvalFlags_Parallel they run on worker threads and must not call any ImNodeGraph function either.
+    IMGUI_API void                  SetNodeCompute(ImGuiID node_id, ImNodeGraphComputeCallback callback, void* user_data = NULL);
+    IMGUI_API void                  MarkNodeDirty(ImGuiID node_id);
+    IMGUI_API bool                  IsNodeDirty(ImGuiID node_id);
+    IMGUI_API bool                  WouldLinkCloseCycle(ImGuiID start_pin_id, ImGuiID end_pin_id);   // Only searches when the link goes against the current order
+    IMGUI_API int                   EvaluateGraph(ImNodeGraphEvalFlags flags = 0);
+    IMGUI_API void                  SetEvaluationThreadCount(int count);   // Threads used by ImNodeGraphEvalFlags_Parallel, including the calling one. 0 = one per hardware thread (default)
+
+    // Undo history (optional), valid between BeginGraph() and EndGraph()
+    // - Nothing is recorded until SetUndoBudget() is called with a non-zero budget. Edits are stored as compact deltas
+    //   in a ring buffer of that many bytes, the oldest steps are dropped when it is full.
+    // - Recorded: AddNode(), AddPin(), RemoveNode(), SetNodePos(), Link(), RemoveLink(), node drags and
+    //   RecordPropertyChange(). Nodes and pins created by BeginNode()/Pin() are not, they are submitted again anyway.
+    // - Every call is a step of its own, calls between BeginUndoGroup() and EndUndoGroup() form a single step. A node
+    //   drag is a single delta, SetNodePos() calls on the same node within a group are merged.
+    // - Application data attached to nodes is not part of the history, record it with RecordPropertyChange(): undoing
+    //   and redoing pass the old or new value back to the property callback.
+    IMGUI_API void                  SetUndoBudget(int bytes);                      // 0 = stop recording and clear the history
+    IMGUI_API void                  SetUndoPropertyCallback(ImNodeGraphPropertyCallback callback, void* user_data = NULL);
+    IMGUI_API void                  RecordPropertyChange(ImGuiID node_id, ImGuiID property_id, const void* old_data, const void* new_data, int size);
+    IMGUI_API void                  BeginUndoGroup();
+    IMGUI_API void                  EndUndoGroup();
+    IMGUI_API bool                  Undo();                                        // Returns false when there is nothing to undo
+    IMGUI_API bool                  Redo();
+    IMGUI_API bool                  CanUndo();
+    IMGUI_API bool                  CanRedo();
+    IMGUI_API void                  ClearUndoHistory();
+
+    // Auto layout, valid between BeginGraph() and EndGraph()
+    // - StartLayout() takes a snapshot of the positions, sizes and links and computes the layout on a worker thread. The
+    //   UI keeps running meanwhile: once the layout is ready, BeginGraph() moves the nodes to it over a few frames.
+    //   Moves are recorded as a single undo step. Starting a layout cancels the one in progress.
+    // - Edits made while a layout is computed are not part of it, nodes removed meanwhile are skipped when it lands.
+    // - With ImNodeGraphLayoutFlags_Incremental, nodes which were not added or relinked since the previous layout stay in
+    //   place and the new ones are fitted around them. Falls back to a full layout if none was made before.
+    IMGUI_API void                  StartLayout(ImNodeGraphLayout layout, ImNodeGraphLayoutFlags flags = 0);
+    IMGUI_API bool                  IsLayoutInProgress();          // Computing or moving nodes
+    IMGUI_API void                  CancelLayout();                // Nodes stay where they are
+
+    // Graph files, valid between BeginGraph() and EndGraph()
+    // - SaveGraph() writes the nodes, pins, links and positions of the graph, plus an optional opaque payload per node
+    //   returned by 'payload_callback', in a versioned little-endian binary format (see imnode_graph_internal.h).
+    // - LoadGraph() replaces the whole content of the graph. The file is mapped in memory and used in place: positions
+    //   and topology are read straight from the mapped pages, only the ID lookup tables and the spatial index are
+    //   built. Moving nodes only copies the pages it touches, privately, the file itself is never modified. The first
+    //   node, pin or link added copies the mapped columns to the heap.
+    // - Compute callbacks, selection and the undo history are not part of the file, LoadGraph() clears them.
+    IMGUI_API bool                  SaveGraph(const char* filename, ImNodeGraphPayloadCallback payload_callback = NULL, void* user_data = NULL); // Payloads must stay valid until SaveGraph() returns
+    IMGUI_API bool                  LoadGraph(const char* filename);               // Returns false and leaves the graph untouched if the file can't be read, is corrupt or from a newer version
+    IMGUI_API const void*           GetNodePayload(ImGuiID node_id, size_t* out_size); // Payload saved with the node in the loaded file, NULL if none. Valid until the graph is loaded again or destroyed
+
+    // JSON graph files, valid between BeginGraph() and EndGraph()
+    // - For exchanging graphs with other tools: nodes, pins, links, positions and sizes. Payloads are not included.
+    // - Streamed: written through a fixed-size buffer and read in fixed-size chunks, no document is ever built. Memory
+    //   used besides the graph itself doesn't depend on the size of the file.
+    // - Loading replaces the content of the graph, which is left untouched if the file is malformed.
+    IMGUI_API bool                  SaveGraphJson(const char* filename);
+    IMGUI_API bool                  SaveGraphJson(ImNodeGraphWriteFunc write_func, void* user_data);
+    IMGUI_API bool                  LoadGraphJson(const char* filename);
+    IMGUI_API bool                  LoadGraphJson(ImNodeGraphReadFunc read_func, void* user_data);
+
+    // Culling, valid between BeginGraph() and EndGraph()
+    // - The visible set is queried from the graph spatial index in BeginGraph(). It is empty at ImNodeGraphLod_Density.
+    IMGUI_API ImNodeGraphLod        GetLod();
+    IMGUI_API int                   GetVisibleNodeCount();
+    IMGUI_API ImGuiID               GetVisibleNodeID(int n);
+    IMGUI_API int                   GetCulledNodeCount();       // Nodes left out of the visible set this frame
+
+    // Instrumentation
+    // - GetFrameStats() is valid after EndGraph() and describes the frame which just ended.
+    // - While a trace capture is running, the editor passes (graph begin/end, node submission, link tessellation and
+    //   drawing, hit-testing, evaluation) are timed and streamed to 'filename' as Chrome trace events. Open the file
+    //   with chrome://tracing or https://ui.perfetto.dev. Zones can be forwarded to another profiler instead, see
+    //   IMNODEGRAPH_PROFILE_ZONE in imnode_graph_internal.h.
+    IMGUI_API const ImNodeGraphFrameStats& GetFrameStats();
+    IMGUI_API bool                  BeginTraceCapture(const char* filename);   // Returns false if the file can't be created or a capture is already running
+    IMGUI_API void                  EndTraceCapture();
+    IMGUI_API bool                  IsTraceCaptureActive();
+}
@@ -0,0 +1,944 @@
+// imnode_graph: Node Graph Editor for Dear ImGui
+// (internal structures, subject to change between versions)
+
+#pragma once
+
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imnode_graph.h"
+#include "imgui_internal.h"
+
+#if IMGUI_VERSION_NUM < 19000
+#error "imnode_graph requires Dear ImGui 1.90 or newer"
+#endif
+
+// Dear ImGui 1.92 replaced the texture identifier of draw commands with a texture reference (ImDrawCmd::TexRef)
+#if IMGUI_VERSION_NUM >= 19200
+typedef ImTextureRef ImNodeGraphTexture;
+#else
+typedef ImTextureID ImNodeGraphTexture;
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] Configuration
+//-----------------------------------------------------------------------------
+
+// Size of a spatial index cell, in canvas units. Should be in the order of a typical node size.
+#ifndef IMNODEGRAPH_GRID_CELL_SIZE
+#define IMNODEGRAPH_GRID_CELL_SIZE      256.0f
+#endif
+
+// Define to evaluate graphs on the calling thread only, ImNodeGraphEvalFlags_Parallel is then ignored and auto layouts
+// are computed within StartLayout()
+//#define IMNODEGRAPH_DISABLE_THREADS
+
+// Attempts an idle evaluation worker makes at finding work before sleeping until a node becomes ready
+#ifndef IMNODEGRAPH_EVAL_SPIN_COUNT
+#define IMNODEGRAPH_EVAL_SPIN_COUNT         64
+#endif
+
+// Auto layout effort: crossing reduction sweeps of ImNodeGraphLayout_Layered, iterations of ImNodeGraphLayout_ForceDirected
+#ifndef IMNODEGRAPH_LAYOUT_ORDER_SWEEPS
+#define IMNODEGRAPH_LAYOUT_ORDER_SWEEPS     8
+#endif
+#ifndef IMNODEGRAPH_LAYOUT_FORCE_ITERATIONS
+#define IMNODEGRAPH_LAYOUT_FORCE_ITERATIONS 200
+#endif
+
+// Orthogonal links: nodes considered when routing a link, the nearest ones to its pins are kept. Up to
+// IMNODEGRAPH_ROUTE_SYNC_LIMIT stale routes are computed within a frame, more go to a worker thread.
+#ifndef IMNODEGRAPH_ROUTE_MAX_OBSTACLES
+#define IMNODEGRAPH_ROUTE_MAX_OBSTACLES     64
+#endif
+#ifndef IMNODEGRAPH_ROUTE_SYNC_LIMIT
+#define IMNODEGRAPH_ROUTE_SYNC_LIMIT        16
+#endif
+
+// Minimap cells span that many spatial index cells per side
+#ifndef IMNODEGRAPH_MINIMAP_CELL_SCALE
+#define IMNODEGRAPH_MINIMAP_CELL_SCALE      4
+#endif
+
+// Nodes listed by GetSelectionChanges() within a frame, past that it reports everything as changed
+#ifndef IMNODEGRAPH_SELECTION_MAX_CHANGES
+#define IMNODEGRAPH_SELECTION_MAX_CHANGES   1024
+#endif
+
+// Define to load graph files with a plain read instead of mapping them in memory (platforms without mmap)
+//#define IMNODEGRAPH_DISABLE_FILE_MAPPING
+
+// Size of the buffers JSON graph files are written and read through, whatever the size of the graph
+#ifndef IMNODEGRAPH_JSON_CHUNK_SIZE
+#define IMNODEGRAPH_JSON_CHUNK_SIZE     16384
+#endif
+
+// Upper bound for the number of segments of a tessellated link
+#ifndef IMNODEGRAPH_LINK_MAX_SEGMENTS
+#define IMNODEGRAPH_LINK_MAX_SEGMENTS   64
+#endif
+
+// Scoped profiler zone around an editor pass, 'name' is a string literal. Defaults to the built-in trace capture
+// (see BeginTraceCapture()), define to nothing to compile the zones out or forward them to your own profiler:
+//   #define IMNODEGRAPH_PROFILE_ZONE(name)  ZoneScopedN(name)
+#ifndef IMNODEGRAPH_PROFILE_ZONE
+#define IMNODEGRAPH_PROFILE_ZONE(name)  ImNodeGraphProfileZone imnodegraph_profile_zone(name)
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] Forward declarations
+//-----------------------------------------------------------------------------
+
+struct ImNodeGraphIDMap;
+struct ImNodeGraphSlots;
+struct ImNodeGraphNodePool;
+struct ImNodeGraphNodeDrawCache;
+struct ImNodeGraphGroupState;
+struct ImNodeGraphPinPool;
+struct ImNodeGraphLinkPool;
+struct ImNodeGraphLinkGeometry;
+struct ImNodeGraphSelection;
+struct ImNodeGraphGridRange;
+struct ImNodeGraphGridEntry;
+struct ImNodeGraphGridCell;
+struct ImNodeGraphSpatialGrid;
+struct ImNodeGraphMinimap;
+struct ImNodeGraphExecutor;         // Evaluation thread pool, defined in imnode_graph.cpp
+struct ImNodeGraphLayoutJob;        // Auto layout computed on a worker thread, defined in imnode_graph.cpp
+struct ImNodeGraphRouteJob;         // Link routes computed on a worker thread, defined in imnode_graph.cpp
+struct ImNodeGraphRouteScratch;
+struct ImNodeGraphTraceEvent;
+struct ImNodeGraphFrameArena;
+struct ImNodeGraphUndoHistory;
+struct ImNodeGraphFileHeader;
+struct ImNodeGraphMappedFile;
+struct ImNodeGraphProfileZone;
+
+typedef ImU32 ImNodeGraphHandle;    // Generational handle into one of the element pools, 0 is never valid
+
+// Bytes held by a vector, used to account for the graph storage in ImNodeGraphFrameStats
+template<typename T>
+static inline size_t ImNodeGraphVectorBytes(const ImVector<T>& v) { return (size_t)v.Capacity * sizeof(T); }
+
+// Fixed channels of the window draw list while a graph is submitted, back to front
+enum ImNodeGraphDrawLayer
+{
+    ImNodeGraphDrawLayer_Links,         // Grid and links
+    ImNodeGraphDrawLayer_Nodes,         // Composed back to front by ComposeNodeLayer(). Nodes below ImNodeGraphLod_Full are drawn here directly.
+    ImNodeGraphDrawLayer_NodeScratch,   // Submitted nodes in submission order, emptied by ComposeNodeLayer()
+    ImNodeGraphDrawLayer_Overlay,       // Dragged link, box selection, minimap
+    ImNodeGraphDrawLayer_COUNT
+};
+
+enum ImNodeGraphInteraction
+{
+    ImNodeGraphInteraction_None,
+    ImNodeGraphInteraction_DragNodes,
+    ImNodeGraphInteraction_DragLink,
+    ImNodeGraphInteraction_BoxSelect,
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Frame arena
+//-----------------------------------------------------------------------------
+
+// Bump allocator for data which only lives during a graph frame: visible sets, sort keys, query results, screen
+// space points... Reset at the start of every BeginGraph(), which invalidates everything allocated from it.
+// Allocations which don't fit go to overflow blocks, the next reset replaces them with a single block large
+// enough for the whole frame, so a warm editor stops allocating.
+struct ImNodeGraphFrameArena
+{
+    char*                   Data;
+    size_t                  Size;               // Bytes used in Data
+    size_t                  Capacity;
+    ImVector<void*>         Overflow;           // Blocks allocated since the last reset because Data was full
+    size_t                  OverflowSize;
+    int                     Epoch;              // Bumped by every reset, see ImNodeGraphArenaVector
+
+    ImNodeGraphFrameArena()     { Data = NULL; Size = Capacity = OverflowSize = 0; Epoch = 1; }
+    ~ImNodeGraphFrameArena()    { Clear(); }
+    void*                   Alloc(size_t size); // 16 bytes aligned
+    void                    Reset();
+    void                    Clear();            // Release all memory
+    size_t                  CalcMemoryUsage() const { return Capacity + OverflowSize + ImNodeGraphVectorBytes(Overflow); }
+};
+
+namespace ImNodeGraph
+{
+    IMGUI_API ImNodeGraphFrameArena* GetFrameArena();   // Of the current context, shared by its graphs
+}
+
+// Growable array in the frame arena of the current context, with the subset of the ImVector interface used on
+// per-frame data. Growing copies to a new arena range, the old one is reclaimed by the next reset. A buffer left
+// from an earlier frame is dropped by resize(), so arrays are reused like an ImVector: resize(0) then push_back().
+template<typename T>
+struct ImNodeGraphArenaVector
+{
+    int                     Size;
+    int                     Capacity;
+    T*                      Data;
+    int                     Epoch;              // Arena epoch Data was allocated in
+
+    ImNodeGraphArenaVector()                    { Size = Capacity = 0; Data = NULL; Epoch = 0; }
+    bool                    empty() const       { return Size == 0; }
+    T&                      operator[](int i)   { IM_ASSERT(i >= 0 && i < Size); return Data[i]; }
+    const T&                operator[](int i) const { IM_ASSERT(i >= 0 && i < Size); return Data[i]; }
+    T*                      begin()             { return Data; }
+    T*                      end()               { return Data + Size; }
+    T&                      back()              { IM_ASSERT(Size > 0); return Data[Size - 1]; }
+    void                    clear()             { Size = Capacity = 0; Data = NULL; }
+    void                    push_back(const T& v)
+    {
+        IM_ASSERT((Capacity == 0 || Epoch == ImNodeGraph::GetFrameArena()->Epoch) && "Arena vector from a previous frame, call resize(0) first");
+        if (Size == Capacity)
+            reserve(Capacity ? Capacity * 2 : 16);
+        Data[Size++] = v;
+    }
+    void                    resize(int new_size)
+    {
+        if (Epoch != ImNodeGraph::GetFrameArena()->Epoch)
+            clear();
+        if (new_size > Capacity)
+            reserve(ImMax(new_size, Capacity * 2));
+        Size = new_size;
+    }
+    void                    reserve(int new_capacity)
+    {
+        ImNodeGraphFrameArena* arena = ImNodeGraph::GetFrameArena();
+        if (Epoch != arena->Epoch)
+        {
+            clear();
+            Epoch = arena->Epoch;
+        }
+        if (new_capacity <= Capacity)
+            return;
+        T* new_data = (T*)arena->Alloc((size_t)new_capacity * sizeof(T));
+        if (Size > 0)
+            memcpy(new_data, Data, (size_t)Size * sizeof(T));
+        Data = new_data;
+        Capacity = new_capacity;
+    }
+};
+
+// Growable array for code running on worker threads, with the subset of the ImVector interface used there. Allocates
+// with malloc(): ImGui::MemAlloc() updates the allocation counters of the current ImGui context, which belongs to the
+// main thread. Elements are copied with memcpy() as in ImVector.
+template<typename T>
+struct ImNodeGraphWorkerVector
+{
+    int                     Size;
+    int                     Capacity;
+    T*                      Data;
+
+    ImNodeGraphWorkerVector()                   { Size = Capacity = 0; Data = NULL; }
+    ImNodeGraphWorkerVector(const ImNodeGraphWorkerVector<T>& src) { Size = Capacity = 0; Data = NULL; operator=(src); }
+    ImNodeGraphWorkerVector<T>& operator=(const ImNodeGraphWorkerVector<T>& src) { resize(src.Size); if (src.Size > 0) memcpy(Data, src.Data, (size_t)src.Size * sizeof(T)); return *this; }
+    ~ImNodeGraphWorkerVector()                  { free(Data); }
+    bool                    empty() const       { return Size == 0; }
+    T&                      operator[](int i)   { IM_ASSERT(i >= 0 && i < Size); return Data[i]; }
+    const T&                operator[](int i) const { IM_ASSERT(i >= 0 && i < Size); return Data[i]; }
+    T*                      begin()             { return Data; }
+    T*                      end()               { return Data + Size; }
+    T&                      back()              { IM_ASSERT(Size > 0); return Data[Size - 1]; }
+    void                    clear()             { free(Data); Size = Capacity = 0; Data = NULL; }
+    void                    push_back(const T& v) { if (Size == Capacity) reserve(Capacity ? Capacity * 2 : 16); Data[Size++] = v; }
+    void                    pop_back()          { IM_ASSERT(Size > 0); Size--; }
+    void                    resize(int new_size) { if (new_size > Capacity) reserve(ImMax(new_size, Capacity * 2)); Size = new_size; }
+    void                    resize(int new_size, const T& v) { const int old_size = Size; resize(new_size); for (int n = old_size; n < new_size; n++) Data[n] = v; }
+    void                    reserve(int new_capacity)
+    {
+        if (new_capacity <= Capacity)
+            return;
+        T* new_data = (T*)malloc((size_t)new_capacity * sizeof(T));
+        IM_ASSERT(new_data != NULL);
+        if (Size > 0)
+            memcpy(new_data, Data, (size_t)Size * sizeof(T));
+        free(Data);
+        Data = new_data;
+        Capacity = new_capacity;
+    }
+};
+
+template<typename T>
+static inline size_t ImNodeGraphVectorBytes(const ImNodeGraphWorkerVector<T>& v) { return (size_t)v.Capacity * sizeof(T); }
+
+//-----------------------------------------------------------------------------
+// [SECTION] ID map
+//-----------------------------------------------------------------------------
+
+// Flat open-addressing table from ImGuiID to a 32-bit value, linear probing over a power of two capacity.
+// Keys are re-hashed since application IDs are often sequential. Removal shifts the following entries back
+// instead of leaving tombstones, so lookups stay short after heavy churn. Key 0 marks empty slots and is
+// stored on the side.
+struct ImNodeGraphIDMapPair
+{
+    ImGuiID                 Key;
+    ImU32                   Value;
+};
+
+struct ImNodeGraphIDMap
+{
+    ImVector<ImNodeGraphIDMapPair>  Pairs;
+    int                             Count;          // Including the zero key
+    bool                            HasZeroKey;
+    ImU32                           ZeroKeyValue;
+
+    ImNodeGraphIDMap()              { Count = 0; HasZeroKey = false; ZeroKeyValue = 0; }
+    void                            Clear()         { Pairs.clear(); Count = 0; HasZeroKey = false; ZeroKeyValue = 0; }
+    ImU32                           Get(ImGuiID key, ImU32 default_val = 0) const;
+    ImU32*                          GetRef(ImGuiID key, ImU32 default_val = 0);     // Inserts when missing, valid until the next insertion
+    void                            Set(ImGuiID key, ImU32 val)                     { *GetRef(key) = val; }
+    bool                            Remove(ImGuiID key);
+    void                            Reserve(int count);
+    size_t                          CalcMemoryUsage() const                         { return ImNodeGraphVectorBytes(Pairs); }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Handles
+//-----------------------------------------------------------------------------
+
+// Handle layout: [generation:8][slot index:24]
+#define IMNODEGRAPH_HANDLE_INDEX_BITS   24
+#define IMNODEGRAPH_HANDLE_INDEX_MASK   ((1u << IMNODEGRAPH_HANDLE_INDEX_BITS) - 1)
+#define IMNODEGRAPH_HANDLE_MAX_SLOTS    (1 << IMNODEGRAPH_HANDLE_INDEX_BITS)
+
+static inline int ImNodeGraphHandleIndex(ImNodeGraphHandle handle) { return (int)(handle & IMNODEGRAPH_HANDLE_INDEX_MASK); }
+
+// Slot allocator shared by the element pools. The generation of a slot is bumped on allocation and on
+// release, so it is odd while the slot is alive and a stale handle never matches a reused slot.
+// Released slots are recycled first, pool columns only grow when no slot is free.
+struct ImNodeGraphSlots
+{
+    ImVector<ImU8>          Generations;
+    ImVector<int>           FreeSlots;
+    int                     AliveCount;
+
+    ImNodeGraphSlots()                                      { AliveCount = 0; }
+    void                    Clear()                         { Generations.clear(); FreeSlots.clear(); AliveCount = 0; }
+    int                     GetSize() const                 { return Generations.Size; }
+    bool                    IsSlotAlive(int idx) const      { return (Generations[idx] & 1) != 0; }
+    ImNodeGraphHandle       GetHandle(int idx) const        { return ((ImU32)Generations[idx] << IMNODEGRAPH_HANDLE_INDEX_BITS) | (ImU32)idx; }
+    bool                    IsAlive(ImNodeGraphHandle h) const
+    {
+        const int idx = ImNodeGraphHandleIndex(h);
+        return idx < Generations.Size && (Generations[idx] & 1) != 0 && Generations[idx] == (ImU8)(h >> IMNODEGRAPH_HANDLE_INDEX_BITS);
+    }
+    int                     Alloc();                        // Returns a slot index, == GetSize() - 1 when the pool must grow its columns
+    void                    Free(int idx);
+    size_t                  CalcMemoryUsage() const         { return ImNodeGraphVectorBytes(Generations) + ImNodeGraphVectorBytes(FreeSlots); }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Graph elements
+//-----------------------------------------------------------------------------
+
+// Range of cells covered by a node in the spatial grid. Empty when X1 < X0.
+struct ImNodeGraphGridRange
+{
+    int         X0, Y0, X1, Y1;
+
+    ImNodeGraphGridRange()                              { X0 = Y0 = 0; X1 = Y1 = -1; }
+    ImNodeGraphGridRange(int x0, int y0, int x1, int y1) { X0 = x0; Y0 = y0; X1 = x1; Y1 = y1; }
+    bool        IsEmpty() const                         { return X1 < X0 || Y1 < Y0; }
+    bool        operator==(const ImNodeGraphGridRange& o) const { return X0 == o.X0 && Y0 == o.Y0 && X1 == o.X1 && Y1 == o.Y1; }
+};
+
+// Draw data of a node recorded in EndNode(), in screen space at the position the node had then, back to front.
+// Replayed by BeginNode(), translated to the current position, while the application version, the zoom and
+// the selection state are unchanged and nothing inside the node is hovered or active.
+struct ImNodeGraphNodeDrawCmd
+{
+    ImVec4                  ClipRect;
+    ImNodeGraphTexture      Texture;
+    int                     VtxOffset;          // Range in ImNodeGraphNodeDrawCache::VtxBuffer
+    int                     VtxCount;
+    int                     IdxOffset;          // Range in ImNodeGraphNodeDrawCache::IdxBuffer, relative to VtxOffset
+    int                     IdxCount;
+};
+
+struct ImNodeGraphNodeDrawCache
+{
+    ImU32                               Version;
+    float                               Zoom;
+    bool                                Selected;
+    ImRect                              ScreenRect;     // Node rectangle when recorded
+    ImVec2                              TexUvWhitePixel;// Moves when the font atlas is rebuilt, along with the recorded texture coordinates
+    ImVector<ImNodeGraphNodeDrawCmd>    CmdBuffer;
+    ImVector<ImDrawVert>                VtxBuffer;
+    ImVector<ImDrawIdx>                 IdxBuffer;
+
+    ImNodeGraphNodeDrawCache()          { Version = 0; Zoom = 0.0f; Selected = false; TexUvWhitePixel = ImVec2(-1.0f, -1.0f); }
+    size_t                              CalcMemoryUsage() const { return sizeof(*this) + ImNodeGraphVectorBytes(CmdBuffer) + ImNodeGraphVectorBytes(VtxBuffer) + ImNodeGraphVectorBytes(IdxBuffer); }
+};
+
+// Index ranges a node submitted during the frame drew in ImNodeGraphDrawLayer_NodeScratch. The background is only
+// drawn in EndNode() once the size is known, it goes back under the title and widgets when the node layer is composed.
+struct ImNodeGraphNodeDraw
+{
+    int                     NodeIdx;
+    int                     ContentBegin;       // Title and widgets: [ContentBegin, BackgroundBegin)
+    int                     BackgroundBegin;    // [BackgroundBegin, PinsBegin)
+    int                     PinsBegin;          // [PinsBegin, End)
+    int                     End;
+};
+
+// Allocated for collapsed group nodes. While a group is collapsed its inner nodes are hidden: out of the spatial index,
+// never visible nor selectable, and links leaving them are drawn to the edges of the group.
+struct ImNodeGraphGroupState
+{
+    ImVec2                              CollapsedPos;   // Group position when collapsed, inner nodes move by the difference when expanded
+    ImVector<ImNodeGraphHandle>         BoundaryLinks;  // Links from a hidden inner node to a node outside, only while the group is displayed. May hold destroyed links.
+
+    size_t                              CalcMemoryUsage() const { return sizeof(*this) + ImNodeGraphVectorBytes(BoundaryLinks); }
+};
+
+// Elements are stored as structure-of-arrays, one column per field, all indexed by slot.
+// Culling, dragging and link drawing only touch the columns they need.
+struct ImNodeGraphNodePool
+{
+    ImNodeGraphSlots                Slots;
+    ImVector<ImGuiID>               ID;
+    ImVector<ImVec2>                Pos;            // Canvas space, top-left corner
+    ImVector<ImVec2>                Size;           // Canvas space, measured in EndNode()
+    ImVector<ImNodeGraphHandle>     FirstPin;       // Pins are chained through ImNodeGraphPinPool::NextPin, in creation order
+    ImVector<ImNodeGraphGridRange>  GridRange;      // Cells the node is registered in
+    ImVector<ImRect>                RouteRect;      // Rectangle link routes last went around, only maintained with ImNodeGraphFlags_OrthogonalLinks
+    ImVector<ImU32>                 Depth;          // Draw order, higher is on top
+    ImVector<int>                   VisibleFrame;   // Last frame the node was part of the visible set
+    ImVector<int>                   DrawOrder;      // Back to front position in the visible set for this frame, -1 when drawn on top of it
+    ImVector<ImNodeGraphNodeDrawCache*> DrawCache;  // Only allocated for nodes submitted with a content version
+    ImVector<int>                   TopoOrder;      // Position in ImNodeGraphData::TopoNodes, only maintained once evaluation is used
+    ImVector<int>                   TopoVisit;      // Last traversal that reached the node
+    ImVector<bool>                  Dirty;
+    ImVector<ImNodeGraphComputeCallback> ComputeCallback;
+    ImVector<void*>                 ComputeUserData;
+    ImVector<ImNodeGraphHandle>     Parent;         // Group the node is in, 0 at the top level
+    ImVector<ImNodeGraphHandle>     FirstChild;     // Nodes of a group are chained through NextSibling
+    ImVector<ImNodeGraphHandle>     NextSibling;
+    ImVector<bool>                  Collapsed;
+    ImVector<bool>                  Hidden;         // An ancestor group is collapsed
+    ImVector<ImNodeGraphGroupState*> GroupState;    // Only allocated for collapsed groups
+    size_t                          DrawCacheBytes;         // Held by every DrawCache, kept up to date as they are recorded and freed
+    size_t                          GroupStateBytes;        // Held by every GroupState, same
+    int                             HiddenCount;
+
+    ImNodeGraphNodePool()                                   { DrawCacheBytes = GroupStateBytes = 0; HiddenCount = 0; }
+    ~ImNodeGraphNodePool()                                  { for (int n = 0; n < DrawCache.Size; n++) IM_DELETE(DrawCache[n]); for (int n = 0; n < GroupState.Size; n++) IM_DELETE(GroupState[n]); }
+    int                             Add(ImGuiID id);
+    void                            Remove(int idx)         { FreeDrawCache(idx); FreeGroupState(idx); Slots.Free(idx); }
+    void                            Reserve(int capacity);
+    size_t                          CalcMemoryUsage() const;
+    void                            FreeDrawCache(int idx)  { if (DrawCache[idx] == NULL) return; DrawCacheBytes -= DrawCache[idx]->CalcMemoryUsage(); IM_DELETE(DrawCache[idx]); DrawCache[idx] = NULL; }
+    void                            FreeGroupState(int idx) { if (GroupState[idx] == NULL) return; GroupStateBytes -= GroupState[idx]->CalcMemoryUsage(); IM_DELETE(GroupState[idx]); GroupState[idx] = NULL; }
+    ImRect                          GetRect(int idx) const  { return ImRect(Pos[idx], Pos[idx] + Size[idx]); }
+};
+
+struct ImNodeGraphPinPool
+{
+    ImNodeGraphSlots                Slots;
+    ImVector<ImGuiID>               ID;
+    ImVector<ImNodeGraphHandle>     Node;
+    ImVector<ImVec2>                Offset;         // Canvas space, pin center relative to the node position
+    ImVector<ImPinDirection>        Direction;
+    ImVector<ImPinType>             Type;
+    ImVector<ImNodeGraphHandle>     NextPin;        // Next pin of the same node
+    ImVector<ImNodeGraphHandle>     FirstLink;      // Links are chained through ImNodeGraphLinkPool::NextAtStart/NextAtEnd
+    ImVector<ImNodeGraphGridRange>  GridRange;      // Cell the pin center is registered in
+
+    int                             Add(ImGuiID id);
+    void                            Remove(int idx)         { Slots.Free(idx); }
+    void                            Reserve(int capacity);
+    size_t                          CalcMemoryUsage() const;
+};
+
+// Cached tessellation of a link, in canvas space. Bounds and cells are refreshed whenever an endpoint moves, points are
+// only rebuilt for visible links, when an endpoint moved or when the zoom calls for another segment count.
+// With ImNodeGraphFlags_OrthogonalLinks the points are the route instead, Bounds its bounding box once routed.
+struct ImNodeGraphLinkGeometry
+{
+    ImVec2                  Start;              // Endpoints the geometry was built for
+    ImVec2                  End;
+    ImRect                  Bounds;             // Bounds of the control points
+    float                   Length;             // Length of the control polygon, upper bound of the curve length
+    int                     Segments;           // 0 when the points are stale
+    int                     PointsOffset;       // Range in ImNodeGraphData::LinkPoints
+    int                     PointsCapacity;
+    ImNodeGraphGridRange    GridRange;          // Cells covered by Bounds
+    bool                    RouteStale;         // Points are a placeholder or go around nodes which moved since
+    ImU32                   RouteVersion;       // Bumped whenever the route goes stale, results of older requests are dropped
+
+    ImNodeGraphLinkGeometry()                   { Start = End = ImVec2(FLT_MAX, FLT_MAX); Length = 0.0f; Segments = PointsOffset = PointsCapacity = 0; RouteStale = false; RouteVersion = 0; }
+};
+
+struct ImNodeGraphLinkPool
+{
+    ImNodeGraphSlots                Slots;
+    ImVector<ImGuiID>               ID;
+    ImVector<ImNodeGraphHandle>     StartPin;       // Output pin
+    ImVector<ImNodeGraphHandle>     EndPin;         // Input pin
+    ImVector<ImNodeGraphHandle>     NextAtStart;    // Next link attached to StartPin
+    ImVector<ImNodeGraphHandle>     NextAtEnd;      // Next link attached to EndPin
+    ImVector<ImNodeGraphLinkGeometry> Geometry;
+    ImVector<bool>                  Cyclic;         // Closes a cycle, ignored by evaluation
+
+    int                             Add(ImGuiID id);
+    void                            Remove(int idx)         { Slots.Free(idx); }
+    void                            Reserve(int capacity);
+    size_t                          CalcMemoryUsage() const;
+};
+
+// Selected nodes as one bit per node slot, along with a mask of the live slots: selecting all or inverting is a pass
+// over 64-bit words. Bits of free slots are always clear.
+struct ImNodeGraphSelection
+{
+    ImVector<ImU64>                 Bits;
+    ImVector<ImU64>                 Alive;
+    int                             Count;          // Selected nodes
+    ImVector<ImGuiID>               Changes;        // Nodes selected or deselected since BeginGraph(), may repeat
+    bool                            ChangesOverflow;// More than IMNODEGRAPH_SELECTION_MAX_CHANGES changes, Changes is left empty
+
+    ImNodeGraphSelection()                                  { Count = 0; ChangesOverflow = false; }
+    void                            Clear()                 { Bits.clear(); Alive.clear(); Count = 0; Changes.clear(); ChangesOverflow = true; }
+    bool                            Test(int idx) const     { return (Bits[idx >> 6] & ((ImU64)1 << (idx & 63))) != 0; }
+    int                             FindNext(int idx) const;    // First selected slot from idx, -1 when none
+    void                            AddSlot(int idx);
+    void                            RemoveSlot(int idx)     { IM_ASSERT(!Test(idx)); Alive[idx >> 6] &= ~((ImU64)1 << (idx & 63)); }
+    void                            AddChange(ImGuiID id);
+    size_t                          CalcMemoryUsage() const { return ImNodeGraphVectorBytes(Bits) + ImNodeGraphVectorBytes(Alive) + ImNodeGraphVectorBytes(Changes); }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Spatial index
+//-----------------------------------------------------------------------------
+
+// Uniform grid over the unbounded canvas. Each occupied cell heads a singly linked list of entries,
+// an element is registered in every cell its bounding rectangle overlaps. Elements are only re-registered
+// when the range of cells they cover changes, so moving inside the same cells is free.
+// One grid is kept per element kind: nodes, pins (as points) and links (bezier bounds).
+struct ImNodeGraphGridEntry
+{
+    int                     Item;               // Element slot index
+    int                     Next;               // Next entry in the same cell, or in the free list
+};
+
+// Occupied cell returned by ImNodeGraphSpatialGrid::QueryCells()
+struct ImNodeGraphGridCell
+{
+    int                     X, Y;
+    int                     Head;               // First entry of the cell
+
+    ImNodeGraphGridCell()                       { X = Y = 0; Head = -1; }
+    ImNodeGraphGridCell(int x, int y, int head) { X = x; Y = y; Head = head; }
+};
+
+struct ImNodeGraphSpatialGrid
+{
+    float                           CellSize;
+    ImNodeGraphIDMap                Cells;          // Cell key -> first entry, only occupied cells are present
+    ImVector<ImNodeGraphGridEntry>  Entries;
+    int                             FreeEntry;
+    ImVector<int>                   QueryStamps;    // Per element slot, last query that returned the element
+    int                             QueryStamp;
+    ImNodeGraphArenaVector<ImNodeGraphGridCell> CellBuffer; // Scratch for Query()
+
+    ImNodeGraphSpatialGrid()        { CellSize = IMNODEGRAPH_GRID_CELL_SIZE; FreeEntry = -1; QueryStamp = 0; }
+    void                            Clear()         { Cells.Clear(); Entries.clear(); FreeEntry = -1; QueryStamps.clear(); QueryStamp = 0; }
+
+    ImNodeGraphGridRange            GetRange(const ImRect& bb) const;
+    void                            Update(int item_idx, ImNodeGraphGridRange* range, const ImRect& bb);
+    void                            Remove(int item_idx, ImNodeGraphGridRange* range);
+    void                            Query(const ImRect& bb, ImNodeGraphArenaVector<int>* out_items); // Conservative, cell granularity
+    void                            QueryMore(const ImRect& bb, ImNodeGraphArenaVector<int>* out_items); // Add to the previous query, without repeating its items
+    void                            QueryCells(const ImRect& bb, ImNodeGraphArenaVector<ImNodeGraphGridCell>* out_cells) const; // Occupied cells overlapping bb
+    void                            CollectCell(int entry_idx, ImNodeGraphArenaVector<int>* out_items);
+    size_t                          CalcMemoryUsage() const { return Cells.CalcMemoryUsage() + ImNodeGraphVectorBytes(Entries) + ImNodeGraphVectorBytes(QueryStamps); }
+};
+
+// Occupancy grid behind ImNodeGraphFlags_Minimap. Nodes are counted in the cell of their top-left corner, kept up to
+// date as they move. The quads drawn for the cells are only built again when a count changes or the minimap is resized.
+struct ImNodeGraphMinimap
+{
+    ImNodeGraphIDMap                Cells;          // Cell key -> node count, only occupied cells are present
+    ImU32                           Version;        // Bumped whenever a count changes
+    ImU32                           BuiltVersion;   // Version the quads were built for
+    ImVec2                          BuiltSize;
+    ImRect                          Bounds;         // Canvas space, covered by the occupied cells when built
+    float                           Scale;          // Canvas units to minimap pixels, 0.0f when the graph is empty
+    ImVec2                          Origin;         // Pixel Bounds.Min is drawn at, relative to the minimap top-left
+    ImVector<ImDrawVert>            VtxBuffer;      // 4 per occupied cell, relative to the minimap top-left
+    ImVec2                          GrabOffset;     // Canvas space, from the view center to the point the minimap was clicked at
+
+    ImNodeGraphMinimap()            { Version = 1; BuiltVersion = 0; Scale = 0.0f; }
+    void                            Clear()         { Cells.Clear(); Version++; }
+    size_t                          CalcMemoryUsage() const { return Cells.CalcMemoryUsage() + ImNodeGraphVectorBytes(VtxBuffer); }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Undo history
+//-----------------------------------------------------------------------------
+
+// Payloads, IDs are stored rather than handles so records stay valid across deletion and re-creation
+enum ImNodeGraphUndoType
+{
+    ImNodeGraphUndoType_NodeCreated,        // Node ID, Pos
+    ImNodeGraphUndoType_NodeDeleted,        // Node ID, Pos, Size, pin count, link count, pins (ID, Direction, Type, Offset), links (ID, start pin ID, end pin ID)
+    ImNodeGraphUndoType_NodeMoved,          // Node ID, old Pos, new Pos
+    ImNodeGraphUndoType_NodesMoved,         // Offset, node count, node IDs
+    ImNodeGraphUndoType_PinCreated,         // Pin ID, node ID, Direction, Type
+    ImNodeGraphUndoType_LinkAdded,          // Link ID, start pin ID, end pin ID
+    ImNodeGraphUndoType_LinkRemoved,        // Link ID, start pin ID, end pin ID
+    ImNodeGraphUndoType_PropertyChanged,    // Node ID, property ID, size, old value, new value
+};
+
+enum ImNodeGraphUndoRecordFlags_
+{
+    ImNodeGraphUndoRecordFlags_None         = 0,
+    ImNodeGraphUndoRecordFlags_StepBegin    = 1 << 0,   // First record of an undo step
+};
+
+// Records are laid out as [ImU32 size][ImU8 type][ImU8 flags][payload][ImU32 size], the size covering the whole
+// record so the history can be walked both ways. Positions are logical byte offsets which only grow, a record is
+// stored at position % capacity and may wrap around the end of the buffer.
+#define IMNODEGRAPH_UNDO_HEADER_SIZE    6
+#define IMNODEGRAPH_UNDO_TRAILER_SIZE   4
+
+struct ImNodeGraphUndoHistory
+{
+    ImVector<ImU8>          Buffer;             // Ring, Size is the byte budget. Empty when not recording.
+    ImU64                   Begin;              // Oldest record
+    ImU64                   Cursor;             // End of the last applied record, the ones after it can be redone
+    ImU64                   End;
+    int                     GroupDepth;
+    bool                    GroupHasRecord;     // The open group already started a step
+    ImU64                   MergeRecord;        // NodeMoved record that SetNodePos() may update in place, ~0 when none
+    ImGuiID                 MergeNodeID;
+    ImVector<ImU8>          Scratch;            // Record being written or applied
+    ImNodeGraphPropertyCallback PropertyCallback;
+    void*                   PropertyUserData;
+
+    ImNodeGraphUndoHistory()    { Begin = Cursor = End = 0; GroupDepth = 0; GroupHasRecord = false; MergeRecord = ~(ImU64)0; MergeNodeID = 0; PropertyCallback = NULL; PropertyUserData = NULL; }
+    bool                    IsRecording() const { return Buffer.Size > 0; }
+    void                    Clear()             { Begin = Cursor = End = 0; MergeRecord = ~(ImU64)0; }
+    void                    Write(ImU64 pos, const void* src, int size);    // Wrap-aware copies
+    void                    Read(ImU64 pos, void* dst, int size) const;
+    void                    Put(const void* src, int size)  { const int offset = Scratch.Size; Scratch.resize(offset + size); memcpy(Scratch.Data + offset, src, (size_t)size); }
+    void                    Get(int* offset, void* dst, int size) const { memcpy(dst, Scratch.Data + *offset, (size_t)size); *offset += size; }
+    size_t                  CalcMemoryUsage() const { return ImNodeGraphVectorBytes(Buffer) + ImNodeGraphVectorBytes(Scratch); }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Graph files
+//-----------------------------------------------------------------------------
+
+// Binary graph file written by SaveGraph(), laid out so it can be used in place once mapped in memory:
+// - Little-endian. ImNodeGraphFileHeader, then one section per pool column, each starting on an 8 bytes boundary.
+// - Elements are stored densely, in slot order. References to other elements are stored as the handles a fresh
+//   pool hands out, generation 1: (1 << 24) | index, 0 for none. LoadGraph() points the pool columns at the
+//   sections instead of copying them.
+// - Readers reject versions newer than their own. Sections are only ever appended, those past SectionCount are
+//   missing from the file.
+#define IMNODEGRAPH_FILE_MAGIC          "IMNGRAPH"
+#define IMNODEGRAPH_FILE_VERSION        1
+#define IMNODEGRAPH_FILE_ALIGNMENT      8
+#define IMNODEGRAPH_FILE_MAX_COORD      8388608.0f  // Node positions, the range of the spatial index with the default cell size
+#define IMNODEGRAPH_FILE_MAX_NODE_SIZE  16384.0f    // Node sizes and pin offsets
+
+enum ImNodeGraphFileSection
+{
+    ImNodeGraphFileSection_NodeID,              // ImGuiID[NodeCount]
+    ImNodeGraphFileSection_NodePos,             // ImVec2[NodeCount]
+    ImNodeGraphFileSection_NodeSize,            // ImVec2[NodeCount]
+    ImNodeGraphFileSection_NodeFirstPin,        // ImNodeGraphHandle[NodeCount]
+    ImNodeGraphFileSection_NodePayload,         // ImNodeGraphFileRange[NodeCount], relative to the PayloadData section
+    ImNodeGraphFileSection_PinID,               // ImGuiID[PinCount]
+    ImNodeGraphFileSection_PinNode,             // ImNodeGraphHandle[PinCount]
+    ImNodeGraphFileSection_PinOffset,           // ImVec2[PinCount]
+    ImNodeGraphFileSection_PinDirection,        // ImS32[PinCount]
+    ImNodeGraphFileSection_PinType,             // ImS32[PinCount]
+    ImNodeGraphFileSection_PinNextPin,          // ImNodeGraphHandle[PinCount]
+    ImNodeGraphFileSection_PinFirstLink,        // ImNodeGraphHandle[PinCount]
+    ImNodeGraphFileSection_LinkID,              // ImGuiID[LinkCount]
+    ImNodeGraphFileSection_LinkStartPin,        // ImNodeGraphHandle[LinkCount]
+    ImNodeGraphFileSection_LinkEndPin,          // ImNodeGraphHandle[LinkCount]
+    ImNodeGraphFileSection_LinkNextAtStart,     // ImNodeGraphHandle[LinkCount]
+    ImNodeGraphFileSection_LinkNextAtEnd,       // ImNodeGraphHandle[LinkCount]
+    ImNodeGraphFileSection_PayloadData,         // Node payloads, back to back
+    ImNodeGraphFileSection_COUNT
+};
+
+struct ImNodeGraphFileRange
+{
+    ImU64                   Offset;             // Bytes
+    ImU64                   Size;
+};
+
+struct ImNodeGraphFileHeader
+{
+    char                    Magic[8];           // IMNODEGRAPH_FILE_MAGIC, not zero terminated
+    ImU32                   Version;
+    ImU32                   SectionCount;
+    ImU64                   FileSize;
+    ImU32                   NodeCount;
+    ImU32                   PinCount;
+    ImU32                   LinkCount;
+    ImU32                   Reserved;
+    ImNodeGraphFileRange    Sections[ImNodeGraphFileSection_COUNT];    // From the start of the file
+};
+
+// JSON graph files, written by SaveGraphJson(). Unknown members are skipped when reading, links may come before
+// the pins they refer to:
+//   {"version":1,
+//    "nodes":[{"id":1,"pos":[0,0],"size":[120,80],"pins":[{"id":2,"direction":"output","type":0,"offset":[120,40]}]}, ...],
+//    "links":[{"id":3,"start":2,"end":5}, ...]}
+#define IMNODEGRAPH_JSON_VERSION        1
+
+// File loaded by LoadGraph(). A private mapping: pages are copied on write, changes never reach the file.
+struct ImNodeGraphMappedFile
+{
+    char*                   Data;
+    size_t                  Size;
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Graph and context
+//-----------------------------------------------------------------------------
+
+struct ImNodeGraphData
+{
+    ImGuiID                     ID;
+    ImNodeGraphFlags            Flags;
+    ImRect                      ScreenRect;         // Canvas area in screen space
+    ImVec2                      Pan;                // Screen space offset of the canvas origin from ScreenRect.Min
+    float                       Zoom;
+    ImNodeGraphLod              Lod;
+
+    ImNodeGraphNodePool         Nodes;
+    ImNodeGraphPinPool          Pins;
+    ImNodeGraphLinkPool         Links;
+    ImNodeGraphIDMap            NodeMap;            // ImGuiID -> handle
+    ImNodeGraphIDMap            PinMap;
+    ImNodeGraphIDMap            LinkMap;
+    ImNodeGraphSpatialGrid      NodeGrid;
+    ImNodeGraphSpatialGrid      PinGrid;
+    ImNodeGraphSpatialGrid      LinkGrid;
+    ImU32                       DepthCounter;
+    ImVector<ImVec2>            LinkPoints;         // Tessellated links, ranges owned by ImNodeGraphLinkGeometry
+    int                         LinkPointsUnused;   // Points in ranges of destroyed or relocated links
+
+    // Evaluation. Topological order of the nodes, kept up to date as links are added (Pearce-Kelly).
+    bool                        EvalActive;
+    ImVector<int>               TopoNodes;          // Node slots in evaluation order, -1 for removed nodes
+    int                         TopoHoles;
+    int                         TopoVisitStamp;
+    ImVector<int>               CyclicLinks;        // Link slots closing a cycle, retried when a link is removed
+    ImVector<int>               DirtyNodes;         // Node slots marked since the last evaluation, may hold stale entries
+    ImVector<int>               TopoStack;          // Scratch for traversals
+    ImVector<int>               TopoLinked;
+    ImVector<int>               TopoForward;
+    ImVector<int>               TopoBackward;
+    ImVector<int>               TopoSlots;
+    ImVector<int>               ExecLocal;          // Node slot -> index in the evaluated subgraph
+    ImVector<int>               ExecSuccStart;      // Successors of the evaluated subgraph, compressed rows
+    ImVector<int>               ExecSucc;
+
+    ImNodeGraphUndoHistory      Undo;
+
+    // Auto layout. The job owns a copy of the topology, the graph is only touched again once it is done.
+    ImNodeGraphLayoutJob*       LayoutJob;          // Being computed, NULL when none
+    bool                        LayoutTracking;     // A layout was made, changes are collected for the next incremental one
+    ImVector<ImGuiID>           LayoutChanges;      // Nodes added or relinked since, may hold duplicates and removed nodes
+    ImVector<ImGuiID>           LayoutAnimIDs;      // Nodes moving to their computed position
+    ImVector<ImVec2>            LayoutAnimFrom;
+    ImVector<ImVec2>            LayoutAnimTo;
+    float                       LayoutAnimTime;     // 0.0f -> 1.0f
+
+    // Orthogonal link routing
+    ImNodeGraphRouteJob*        RouteJob;           // Routes being computed, NULL when none
+    ImNodeGraphRouteScratch*    RouteScratch;       // Buffers for the routes computed on the main thread, allocated on first use
+
+    ImNodeGraphMinimap          Minimap;
+
+    // Loaded file. While ColumnsMapped, the columns listed in DetachMappedColumns() point into it rather than to heap
+    // memory: they can be written in place but not grown, the first element added copies them.
+    ImNodeGraphMappedFile*      File;
+    bool                        ColumnsMapped;
+
+    // Per-frame state
+    int                         Frame;
+    ImNodeGraphArenaVector<int> VisibleNodes;       // Node slots, sorted back to front
+    ImNodeGraphArenaVector<int> VisibleLinks;       // Link slots
+    ImNodeGraphArenaVector<ImNodeGraphGridCell> DensityCells;
+    ImNodeGraphArenaVector<ImVec2> LinkScreenPoints; // Scratch buffer for drawing a link
+    ImNodeGraphArenaVector<ImU64> SortBuffer;
+    ImNodeGraphArenaVector<int> QueryBuffer;        // Spatial index queries made while hit-testing
+    ImNodeGraphArenaVector<int> RouteQuery;         // Links and nodes near a moved node or a link to route
+    ImNodeGraphArenaVector<int> StaleRoutes;        // Visible links waiting for a route
+    ImNodeGraphArenaVector<int> GroupNodes;         // Nodes of the group being collapsed or expanded
+    ImNodeGraphArenaVector<int> GroupStack;         // Scratch for walking a group
+    ImNodeGraphFrameStats       Stats;              // Gathered from BeginGraph() to EndGraph()
+    size_t                      MemoryUsageAtBegin;
+    int                         VtxCountAtBegin;
+    int                         IdxCountAtBegin;
+    int                         CmdCountAtBegin;
+    int                         NodesZone;          // Profiler zone spanning node submission, -1 when not capturing
+    ImDrawListSplitter          Splitter;           // One channel per ImNodeGraphDrawLayer_
+    ImNodeGraphArenaVector<ImNodeGraphNodeDraw> NodeDraws; // Nodes submitted or replayed this frame, in submission order
+    ImNodeGraphArenaVector<int> NodeDrawSlots;      // Draw order -> index in NodeDraws, -1 when the node wasn't drawn
+    ImNodeGraphIDMap            TextWidths;         // Widths of node titles and pin labels as float bits, keyed by string hash seeded with font and size bucket
+    int                         TextZoomBucket;     // TextWidths is cleared when the zoom moves to another bucket
+    ImFont*                     TextFont;           // Last font measured with, and what it maps to
+    float                       TextFontSize;
+    float                       TextBucketSize;     // Font size text is measured at
+    ImGuiID                     TextSeed;
+    ImGuiID                     CanvasItemID;
+    bool                        CanvasHovered;
+    bool                        CanvasClicked;
+
+    // Interaction
+    ImNodeGraphSelection        Selection;
+    ImNodeGraphArenaVector<int> SelectionStack;     // Nodes left to visit by SelectNodesDownstream()
+    ImNodeGraphInteraction      Interaction;
+    ImVec2                      BoxSelectStart;     // Canvas space
+    ImVec2                      DragOffset;         // Canvas space, accumulated since the node drag started
+    bool                        DragGroupPending;   // Selected nodes are displayed DragGroupOffset away from their stored position, see CommitDragGroup()
+    ImVec2                      DragGroupOffset;    // Canvas space, not written to the selected nodes yet
+    ImVector<ImNodeGraphHandle> DragBoundaryLinks;  // Links with a single end in the drag group, may hold destroyed links
+    ImNodeGraphHandle           DragLinkPin;
+    int                         DragLinkCycleNode;  // Target node slot DragLinkCyclic was found for, -1 when none
+    bool                        DragLinkCyclic;
+    ImNodeGraphHandle           HoveredNode;
+    ImNodeGraphHandle           HoveredPin;
+    ImNodeGraphHandle           HoveredLink;
+    bool                        LinkCreated;
+    ImGuiID                     CreatedLinkStart;
+    ImGuiID                     CreatedLinkEnd;
+
+    ImNodeGraphData()           { ID = 0; Flags = 0; Zoom = 1.0f; Lod = ImNodeGraphLod_Full; DepthCounter = 0; LinkPointsUnused = 0; EvalActive = false; LayoutJob = NULL; LayoutTracking = false; LayoutAnimTime = 0.0f; RouteJob = NULL; RouteScratch = NULL; File = NULL; ColumnsMapped = false; TopoHoles = TopoVisitStamp = 0; Frame = 0; MemoryUsageAtBegin = 0; VtxCountAtBegin = IdxCountAtBegin = CmdCountAtBegin = 0; NodesZone = -1; TextZoomBucket = INT_MIN; TextFont = NULL; TextFontSize = TextBucketSize = 0.0f; TextSeed = 0; CanvasItemID = 0; CanvasHovered = CanvasClicked = false; Interaction = ImNodeGraphInteraction_None; DragGroupPending = false; DragLinkPin = HoveredNode = HoveredPin = HoveredLink = 0; DragLinkCycleNode = -1; DragLinkCyclic = false; LinkCreated = false; CreatedLinkStart = CreatedLinkEnd = 0; }
+
+    ~ImNodeGraphData();
+
+    ImVec2                      CanvasToScreen(const ImVec2& p) const   { return ScreenRect.Min + Pan + p * Zoom; }
+    ImVec2                      ScreenToCanvas(const ImVec2& p) const   { return (p - ScreenRect.Min - Pan) / Zoom; }
+
+    // Where elements are displayed, which differs from where they are stored while a drag group is pending. Links
+    // between two nodes of the group keep their stored shape and are displayed moved by the offset.
+    ImVec2                      GetNodeDisplayPos(int node_idx) const   { return (DragGroupPending && Selection.Test(node_idx)) ? Nodes.Pos[node_idx] + DragGroupOffset : Nodes.Pos[node_idx]; }
+    ImRect                      GetNodeDisplayRect(int node_idx) const  { const ImVec2 pos = GetNodeDisplayPos(node_idx); return ImRect(pos, pos + Nodes.Size[node_idx]); }
+    bool                        IsLinkInDragGroup(int link_idx) const
+    {
+        return DragGroupPending && Selection.Test(ImNodeGraphHandleIndex(Pins.Node[ImNodeGraphHandleIndex(Links.StartPin[link_idx])]))
+                                && Selection.Test(ImNodeGraphHandleIndex(Pins.Node[ImNodeGraphHandleIndex(Links.EndPin[link_idx])]));
+    }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Instrumentation
+//-----------------------------------------------------------------------------
+
+// Chrome trace "complete" event, times in microseconds from the start of the capture
+struct ImNodeGraphTraceEvent
+{
+    const char*                 Name;
+    double                      Start;
+    double                      Duration;           // < 0 while the zone is open
+};
+
+// Built-in implementation of IMNODEGRAPH_PROFILE_ZONE(), costs a branch when no capture is running
+struct ImNodeGraphProfileZone
+{
+    int                         EventIdx;
+
+    ImNodeGraphProfileZone(const char* name);
+    ~ImNodeGraphProfileZone();
+};
+
+struct ImNodeGraphContext
+{
+    ImNodeGraphStyle            Style;
+    ImPool<ImNodeGraphData>     Graphs;
+    ImNodeGraphData*            CurrentGraph;
+    ImNodeGraphHandle           CurrentNode;
+    float                       CurrentNodeTitleWidth;
+    ImU32                       CurrentNodeVersion;
+    bool                        CurrentNodeCacheable;   // Draw data may be recorded in EndNode()
+    ImNodeGraphData*            LastGraph;          // Target of the queries made after EndGraph()
+    ImVector<ImU64>             PinTypeRows;        // See SetPinTypeTable()
+    ImNodeGraphExecutor*        Executor;           // Created on the first parallel evaluation
+    int                         EvalThreadCount;
+
+    // Trace capture, events are streamed to the file in BeginGraph() and EndTraceCapture()
+    ImFileHandle                TraceFile;
+    double                      TraceStartTime;     // Seconds, ImNodeGraph::GetProfileTime() clock
+    ImVector<ImNodeGraphTraceEvent> TraceEvents;    // Not written yet
+    ImGuiTextBuffer             TraceBuffer;        // Scratch for formatting events
+
+    ImNodeGraphFrameArena       FrameArena;         // Per-frame data of the graph being submitted
+    bool                        TraceFirstEvent;    // No event written yet, they are comma separated
+
+    ImNodeGraphContext()        { CurrentGraph = LastGraph = NULL; CurrentNode = 0; CurrentNodeTitleWidth = 0.0f; CurrentNodeVersion = 0; CurrentNodeCacheable = false; Executor = NULL; EvalThreadCount = 0; TraceFile = NULL; TraceStartTime = 0.0; TraceFirstEvent = true; }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Internal API
+//-----------------------------------------------------------------------------
+
+namespace ImNodeGraph
+{
+    IMGUI_API ImNodeGraphData*      GetCurrentGraph();
+    IMGUI_API ImNodeGraphHandle     FindNode(ImNodeGraphData* graph, ImGuiID node_id);     // 0 when missing
+    IMGUI_API ImNodeGraphHandle     FindPin(ImNodeGraphData* graph, ImGuiID pin_id);
+    IMGUI_API ImNodeGraphHandle     FindLink(ImNodeGraphData* graph, ImGuiID link_id);
+    IMGUI_API ImNodeGraphHandle     CreateNode(ImNodeGraphData* graph, ImGuiID node_id, const ImVec2& pos);
+    IMGUI_API ImNodeGraphHandle     CreatePin(ImNodeGraphData* graph, ImNodeGraphHandle node, ImGuiID pin_id, ImPinDirection direction, ImPinType type);
+    IMGUI_API ImNodeGraphHandle     CreateLink(ImNodeGraphData* graph, ImGuiID link_id, ImNodeGraphHandle start_pin, ImNodeGraphHandle end_pin);
+    IMGUI_API void                  DestroyNode(ImNodeGraphData* graph, ImNodeGraphHandle node);   // Also destroys its pins and their links
+    IMGUI_API void                  DestroyPin(ImNodeGraphData* graph, ImNodeGraphHandle pin);     // Also destroys its links
+    IMGUI_API void                  DestroyLink(ImNodeGraphData* graph, ImNodeGraphHandle link);
+    IMGUI_API void                  UpdateNodeBounds(ImNodeGraphData* graph, int node_idx);        // Call after changing Pos, Size or pin offsets, also refreshes the pins and their links
+    IMGUI_API void                  UpdatePinBounds(ImNodeGraphData* graph, int pin_idx);
+    IMGUI_API ImVec2                GetPinCanvasPos(ImNodeGraphData* graph, int pin_idx);                 // Where the pin is displayed, pending drag offset included. Pins of hidden nodes are on the edge of their collapsed group.
+    IMGUI_API void                  GetLinkBezier(const ImVec2& start, const ImVec2& end, ImVec2 out_points[4]); // Canvas space
+    IMGUI_API void                  UpdateLinkGeometry(ImNodeGraphData* graph, int link_idx);     // Refresh endpoints, bounds and spatial index
+    IMGUI_API ImVec2*               AllocLinkPoints(ImNodeGraphData* graph, int link_idx, int count); // Range in graph->LinkPoints, valid until the next call
+    IMGUI_API void                  InvalidateLinkRoutes(ImNodeGraphData* graph, const ImRect& rect); // Routes going near 'rect' are computed again
+    IMGUI_API void                  UpdateLinkRoutes(ImNodeGraphData* graph);                      // Route the stale links in graph->StaleRoutes
+    IMGUI_API void                  CancelRouteJob(ImNodeGraphData* graph);
+    IMGUI_API void                  SetNodeSelected(ImNodeGraphData* graph, int node_idx, bool selected);
+    IMGUI_API void                  ClearNodeSelection(ImNodeGraphData* graph);
+    IMGUI_API void                  SelectAllNodes(ImNodeGraphData* graph);
+    IMGUI_API void                  InvertNodeSelection(ImNodeGraphData* graph);
+    IMGUI_API void                  SelectNodesDownstream(ImNodeGraphData* graph);                 // Add the nodes reachable from the outputs of the selected ones
+    IMGUI_API void                  MoveNodeToGroup(ImNodeGraphData* graph, int node_idx, int group_idx); // -1 = top level, the node is hidden or shown to match its new ancestors
+    IMGUI_API void                  CollapseGroup(ImNodeGraphData* graph, int group_idx, bool collapsed); // Only visits the nodes of the group
+    IMGUI_API int                   GetVisibleAncestor(ImNodeGraphData* graph, int node_idx);      // The node itself, or the collapsed group it is hidden in
+    IMGUI_API void                  UpdateGroupBoundary(ImNodeGraphData* graph, int group_idx);    // Collect the BoundaryLinks of a displayed collapsed group
+    IMGUI_API void                  BeginDragGroup(ImNodeGraphData* graph);                        // Start moving the selected nodes by graph->DragGroupOffset
+    IMGUI_API void                  CommitDragGroup(ImNodeGraphData* graph);                       // Write the pending drag offset to the selected nodes, no-op when none
+    IMGUI_API void                  UpdateMinimapCell(ImNodeGraphData* graph, const ImNodeGraphGridRange& old_range, const ImNodeGraphGridRange& new_range); // Node moved between spatial index ranges
+    IMGUI_API void                  ActivateEvaluation(ImNodeGraphData* graph);                    // Build the topological order from scratch
+    IMGUI_API bool                  AddTopologicalEdge(ImNodeGraphData* graph, int from_node_idx, int to_node_idx); // False when the edge closes a cycle
+    IMGUI_API bool                  WouldCloseCycle(ImNodeGraphData* graph, int from_node_idx, int to_node_idx);    // Same test as AddTopologicalEdge(), leaves the order as is
+    IMGUI_API void                  MarkDirtyDownstream(ImNodeGraphData* graph, int node_idx);
+    IMGUI_API ImNodeGraphHandle     FindNearestCompatiblePin(ImNodeGraphData* graph, int pin_idx, const ImVec2& pos, float max_dist); // Among pins of visible nodes, 0 when none
+    IMGUI_API void                  TessellateLink(ImNodeGraphData* graph, int link_idx, int segments);
+    IMGUI_API void                  UpdateTextCache(ImNodeGraphData* graph);                       // Clear the measured text widths on zoom bucket change
+    IMGUI_API float                 CalcTextWidth(ImNodeGraphData* graph, const char* text, const char* text_end); // Cached width with the current font and size
+    IMGUI_API void                  RecordNodeDrawData(ImNodeGraphData* graph, int node_idx, ImDrawList* draw_list); // From graph->NodeDraws.back()
+    IMGUI_API void                  ComposeNodeLayer(ImNodeGraphData* graph, ImDrawList* draw_list); // Copy the submitted nodes to ImNodeGraphDrawLayer_Nodes back to front
+    IMGUI_API void                  ReplayNodeDrawData(ImNodeGraphData* graph, int node_idx, ImDrawList* draw_list);
+    IMGUI_API void                  BeginUndoRecord(ImNodeGraphData* graph);                       // Payload is then appended to graph->Undo.Scratch
+    IMGUI_API void                  EndUndoRecord(ImNodeGraphData* graph, ImNodeGraphUndoType type);
+    IMGUI_API void                  RecordNodeDeleted(ImNodeGraphData* graph, int node_idx);
+    IMGUI_API void                  ApplyUndoRecord(ImNodeGraphData* graph, bool undo);            // Record in graph->Undo.Scratch
+    IMGUI_API void                  MarkLayoutChanged(ImNodeGraphData* graph, int node_idx);       // Node to move in the next incremental layout
+    IMGUI_API void                  CancelLayoutJob(ImNodeGraphData* graph);                       // Waits for the worker thread to notice
+    IMGUI_API void                  StopLayoutAnimation(ImNodeGraphData* graph, bool snap);        // Leave the moving nodes where they are, or put them at their destination
+    IMGUI_API void                  ClearGraphStorage(ImNodeGraphData* graph);                     // Destroy every element, release the loaded file and the history
+    IMGUI_API void                  DetachMappedColumns(ImNodeGraphData* graph, bool copy);        // Copy the columns pointing into graph->File to the heap, or drop them
+    IMGUI_API void                  SwapGraphStorage(ImNodeGraphData* a, ImNodeGraphData* b);      // Exchange the elements of two graphs, neither may have a loaded file
+    IMGUI_API const ImNodeGraphFileHeader* ValidateGraphFile(const ImNodeGraphMappedFile* file, ImNodeGraphIDMap* out_node_map, ImNodeGraphIDMap* out_pin_map, ImNodeGraphIDMap* out_link_map);   // NULL when truncated, corrupt or from a newer version. Lookup tables are filled on the way.
+    IMGUI_API size_t                CalcGraphMemoryUsage(ImNodeGraphData* graph);                  // Bytes held by the retained storage and scratch buffers
+    IMGUI_API double                GetProfileTime();                                              // Seconds, monotonic
+    IMGUI_API int                   BeginProfileZone(const char* name);                            // Returns -1 when no capture is running
+    IMGUI_API void                  EndProfileZone(int event_idx);
+}
@@ -0,0 +1,1420 @@
+// imnode_graph: tests
+// Runs headless like the benchmark: no display backend, draw lists are built and dropped. Each test gets a fresh
+// node graph context and its own graph.
+
+// Usage:
+//   imnode_graph_tests [name...]      Runs the tests whose name starts with one of the arguments, all by default
+
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imgui.h"
+#include "imnode_graph.h"
+#include "imnode_graph_internal.h"
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Harness
+//-----------------------------------------------------------------------------
+
+static int GCheckFailures = 0;
+
+#define IM_CHECK(_EXPR)         do { if (!(_EXPR)) { fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #_EXPR); GCheckFailures++; return; } } while (0)
+#define IM_CHECK_EQ(_A, _B)     do { const long long a_ = (long long)(_A), b_ = (long long)(_B); if (a_ != b_) { fprintf(stderr, "%s(%d): check failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #_A, #_B, a_, b_); GCheckFailures++; return; } } while (0)
+
+static ImU32 GRandState = 1;
+static int TestRand(int range)
+{
+    GRandState = GRandState * 1664525u + 1013904223u;
+    return (int)((GRandState >> 8) % (ImU32)range);
+}
+
+static const ImVec2 DisplaySize(1280.0f, 720.0f);
+
+// Graph functions are only valid between BeginGraph() and EndGraph(), tests run their body inside a frame
+static void BeginTestFrame()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = DisplaySize;
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(DisplaySize);
+    ImGui::Begin("Tests", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings);
+    ImNodeGraph::BeginGraph("Graph");
+}
+
+static void EndTestFrame()
+{
+    ImNodeGraph::EndGraph();
+    ImGui::End();
+    ImGui::Render();
+}
+
+// Node n: node ID = n*4+1, inputs n*4+2 and n*4+3, output n*4+4, as in the benchmark
+static inline ImGuiID NodeID(int n)     { return (ImGuiID)n * 4 + 1; }
+static inline ImGuiID InputID(int n)    { return NodeID(n) + 1; }
+static inline ImGuiID Input2ID(int n)   { return NodeID(n) + 2; }
+static inline ImGuiID OutputID(int n)   { return NodeID(n) + 3; }
+
+static void AddTestNode(int n)
+{
+    ImNodeGraph::AddNode(NodeID(n), ImVec2((n % 32) * 200.0f, (n / 32) * 120.0f));
+    ImNodeGraph::AddPin(NodeID(n), InputID(n), ImPinDirection_Input);
+    ImNodeGraph::AddPin(NodeID(n), Input2ID(n), ImPinDirection_Input);
+    ImNodeGraph::AddPin(NodeID(n), OutputID(n), ImPinDirection_Output);
+}
+
+//-----------------------------------------------------------------------------
+// Tests
+//-----------------------------------------------------------------------------
+
+static void TestGraphBuild()
+{
+    BeginTestFrame();
+    for (int n = 0; n < 100; n++)
+        AddTestNode(n);
+    for (int n = 1; n < 100; n++)
+        ImNodeGraph::Link((ImGuiID)n, OutputID(n - 1), InputID(n));
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    IM_CHECK_EQ(graph->Nodes.Slots.AliveCount, 100);
+    IM_CHECK_EQ(graph->Links.Slots.AliveCount, 99);
+    ImNodeGraph::RemoveNode(NodeID(50));
+    IM_CHECK_EQ(graph->Nodes.Slots.AliveCount, 99);
+    IM_CHECK_EQ(graph->Links.Slots.AliveCount, 97);
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// ID map
+//-----------------------------------------------------------------------------
+
+static inline ImU32 IDMapTestValue(ImGuiID key)  { return key * 3 + 1; }
+
+// Occupied slots must match the count, less the zero key which is stored on the side
+static int CountIDMapPairs(const ImNodeGraphIDMap& map)
+{
+    int count = 0;
+    for (int n = 0; n < map.Pairs.Size; n++)
+        count += (map.Pairs[n].Key != 0) ? 1 : 0;
+    return count;
+}
+
+static void TestIDMapZeroKey()
+{
+    ImNodeGraphIDMap map;
+    IM_CHECK_EQ(map.Get(0, 77), 77);
+    IM_CHECK(!map.Remove(0));
+    map.Set(0, 5);
+    IM_CHECK_EQ(map.Get(0), 5);
+    IM_CHECK_EQ(map.Count, 1);
+    IM_CHECK_EQ(map.Pairs.Size, 0);
+    map.Set(1, 6);
+    IM_CHECK_EQ(map.Count, 2);
+    IM_CHECK_EQ(CountIDMapPairs(map), 1);
+    IM_CHECK(map.Remove(0));
+    IM_CHECK(!map.Remove(0));
+    IM_CHECK_EQ(map.Get(0, 77), 77);
+    IM_CHECK_EQ(map.Get(1), 6);
+    IM_CHECK_EQ(map.Count, 1);
+}
+
+// A full smallest table packs its keys in long clusters, every removal shifts entries back toward their home slot
+static void TestIDMapBackwardShift()
+{
+    for (int round = 0; round < 200; round++)
+    {
+        ImNodeGraphIDMap map;
+        ImGuiID keys[11];
+        for (int n = 0; n < IM_ARRAYSIZE(keys); n++)
+        {
+            keys[n] = (ImGuiID)(TestRand(1 << 30) + 1);
+            map.Set(keys[n], IDMapTestValue(keys[n]));
+        }
+        IM_CHECK_EQ(map.Pairs.Size, 16);
+        for (int n = IM_ARRAYSIZE(keys) - 1; n > 0; n--)
+            ImSwap(keys[n], keys[TestRand(n + 1)]);
+        int alive = map.Count;
+        for (int n = 0; n < IM_ARRAYSIZE(keys); n++)
+        {
+            const bool removed = map.Remove(keys[n]);
+            alive -= removed ? 1 : 0;  // Random keys may repeat
+            IM_CHECK(!map.Remove(keys[n]));
+            IM_CHECK_EQ(map.Count, alive);
+            IM_CHECK_EQ(CountIDMapPairs(map), alive);
+            for (int other = 0; other < IM_ARRAYSIZE(keys); other++)
+            {
+                bool gone = false;
+                for (int removed_n = 0; removed_n <= n; removed_n++)
+                    gone |= (keys[removed_n] == keys[other]);
+                IM_CHECK_EQ(map.Get(keys[other], 0), gone ? 0 : IDMapTestValue(keys[other]));
+            }
+        }
+        IM_CHECK_EQ(map.Count, 0);
+    }
+}
+
+static void TestIDMapGrowth()
+{
+    ImNodeGraphIDMap map;
+    int grow_count = 0;
+    for (ImGuiID key = 1; key <= 10000; key++)
+    {
+        const int size_before = map.Pairs.Size;
+        map.Set(key, IDMapTestValue(key));
+        IM_CHECK(map.Count * 10 <= map.Pairs.Size * 7);
+        IM_CHECK((map.Pairs.Size & (map.Pairs.Size - 1)) == 0);
+        if (map.Pairs.Size == size_before)
+            continue;
+
+        // Everything was rehashed
+        grow_count++;
+        IM_CHECK_EQ(CountIDMapPairs(map), map.Count);
+        for (ImGuiID other = 1; other <= key; other++)
+            IM_CHECK_EQ(map.Get(other), IDMapTestValue(other));
+    }
+    IM_CHECK(grow_count > 5);
+    IM_CHECK_EQ(map.Count, 10000);
+}
+
+static void TestIDMapChurn()
+{
+    const ImGuiID key_count = 50000;
+    ImNodeGraphIDMap map;
+    for (ImGuiID key = 1; key <= key_count; key++)
+        map.Set(key, IDMapTestValue(key));
+    for (ImGuiID key = 2; key <= key_count; key += 2)
+        IM_CHECK(map.Remove(key));
+    IM_CHECK_EQ(map.Count, key_count / 2);
+    for (ImGuiID key = 1; key <= key_count; key++)
+        IM_CHECK_EQ(map.Get(key, 0), (key & 1) ? IDMapTestValue(key) : 0);
+
+    const int size_before = map.Pairs.Size;
+    for (ImGuiID key = 2; key <= key_count; key += 2)
+        map.Set(key, IDMapTestValue(key) + 1);
+    IM_CHECK_EQ(map.Pairs.Size, size_before);
+    IM_CHECK_EQ(map.Count, key_count);
+    IM_CHECK_EQ(CountIDMapPairs(map), key_count);
+    for (ImGuiID key = 1; key <= key_count; key++)
+        IM_CHECK_EQ(map.Get(key, 0), IDMapTestValue(key) + ((key & 1) ? 0 : 1));
+}
+
+//-----------------------------------------------------------------------------
+// Evaluation
+//-----------------------------------------------------------------------------
+
+// Layers of nodes, each linked from one or two random nodes of the previous layer
+static const int EvalLayerWidth = 64;
+static const int EvalLayerCount = 16;
+static const int EvalNodeCount = EvalLayerWidth * EvalLayerCount;
+
+struct EvalTestState
+{
+    std::atomic<int>    Clock;
+    std::atomic<int>    RunCount[EvalNodeCount];
+    int                 Begin[EvalNodeCount];       // Clock when the callback started and ended, each node is only written by its own callback
+    int                 End[EvalNodeCount];
+    ImVector<int>       LinkFrom, LinkTo;
+    ImVector<int>       Sequence;                   // Nodes in the order they ran, deterministic runs only
+
+    void                Reset()
+    {
+        Clock = 0;
+        for (int n = 0; n < EvalNodeCount; n++)
+        {
+            RunCount[n] = 0;
+            Begin[n] = End[n] = -1;
+        }
+        Sequence.resize(0);
+    }
+};
+
+static void EvalTestCompute(ImGuiID node_id, void* user_data)
+{
+    EvalTestState* state = (EvalTestState*)user_data;
+    const int n = (int)(node_id - 1) / 4;
+    state->Begin[n] = state->Clock.fetch_add(1);
+    state->RunCount[n].fetch_add(1);
+    state->End[n] = state->Clock.fetch_add(1);
+}
+
+static void EvalTestComputeSequence(ImGuiID node_id, void* user_data)
+{
+    EvalTestCompute(node_id, user_data);
+    ((EvalTestState*)user_data)->Sequence.push_back((int)(node_id - 1) / 4);
+}
+
+static void BuildEvalGraph(EvalTestState* state, ImNodeGraphComputeCallback callback)
+{
+    ImGuiID link_id = 1;
+    for (int n = 0; n < EvalNodeCount; n++)
+    {
+        AddTestNode(n);
+        ImNodeGraph::SetNodeCompute(NodeID(n), callback, state);
+        if (n < EvalLayerWidth)
+            continue;
+        const int prev_layer = (n / EvalLayerWidth - 1) * EvalLayerWidth;
+        const int from = prev_layer + TestRand(EvalLayerWidth);
+        ImNodeGraph::Link(link_id++, OutputID(from), InputID(n));
+        state->LinkFrom.push_back(from);
+        state->LinkTo.push_back(n);
+        const int from2 = prev_layer + TestRand(EvalLayerWidth);
+        if (from2 != from && TestRand(2) == 0)
+        {
+            ImNodeGraph::Link(link_id++, OutputID(from2), Input2ID(n));
+            state->LinkFrom.push_back(from2);
+            state->LinkTo.push_back(n);
+        }
+    }
+}
+
+// Marks a few roots dirty, returns what must run: everything downstream of them
+static void MarkEvalRootsDirty(EvalTestState* state, bool* out_expected)
+{
+    memset(out_expected, 0, sizeof(bool) * EvalNodeCount);
+    for (int n = 0; n < EvalLayerWidth; n += 7)
+    {
+        ImNodeGraph::MarkNodeDirty(NodeID(n));
+        out_expected[n] = true;
+    }
+    for (int link_n = 0; link_n < state->LinkFrom.Size; link_n++)   // Links are listed layer by layer
+        if (out_expected[state->LinkFrom[link_n]])
+            out_expected[state->LinkTo[link_n]] = true;
+}
+
+// Every node ran as expected, once, and only after all of its inputs which ran too
+static void CheckEvalRun(const EvalTestState* state, const bool* expected, int evaluated)
+{
+    int expected_count = 0;
+    for (int n = 0; n < EvalNodeCount; n++)
+    {
+        IM_CHECK_EQ(state->RunCount[n].load(), expected[n] ? 1 : 0);
+        expected_count += expected[n] ? 1 : 0;
+    }
+    IM_CHECK_EQ(evaluated, expected_count);
+    for (int link_n = 0; link_n < state->LinkFrom.Size; link_n++)
+        if (expected[state->LinkTo[link_n]] && expected[state->LinkFrom[link_n]])
+            IM_CHECK(state->End[state->LinkFrom[link_n]] < state->Begin[state->LinkTo[link_n]]);
+}
+
+static void TestEvalParallel()
+{
+    static EvalTestState state;
+    static bool expected[EvalNodeCount];
+    state.LinkFrom.resize(0);
+    state.LinkTo.resize(0);
+    ImNodeGraph::SetEvaluationThreadCount(4);
+    BeginTestFrame();
+    BuildEvalGraph(&state, EvalTestCompute);
+
+    // First evaluation runs everything
+    state.Reset();
+    for (int n = 0; n < EvalNodeCount; n++)
+        expected[n] = true;
+    CheckEvalRun(&state, expected, ImNodeGraph::EvaluateGraph(ImNodeGraphEvalFlags_Parallel));
+    IM_CHECK_EQ(ImNodeGraph::EvaluateGraph(ImNodeGraphEvalFlags_Parallel), 0);
+
+    for (int round = 0; round < 20; round++)
+    {
+        state.Reset();
+        MarkEvalRootsDirty(&state, expected);
+        CheckEvalRun(&state, expected, ImNodeGraph::EvaluateGraph(ImNodeGraphEvalFlags_Parallel));
+    }
+    EndTestFrame();
+}
+
+static void TestEvalDeterministic()
+{
+    static EvalTestState state;
+    static bool expected[EvalNodeCount];
+    state.LinkFrom.resize(0);
+    state.LinkTo.resize(0);
+    BeginTestFrame();
+    BuildEvalGraph(&state, EvalTestComputeSequence);
+    ImNodeGraph::EvaluateGraph(ImNodeGraphEvalFlags_Parallel | ImNodeGraphEvalFlags_Deterministic);
+
+    // Same order whatever the thread count and the run
+    ImVector<int> reference;
+    const int thread_counts[] = { 1, 4, 4, 8 };
+    for (int n = 0; n < IM_ARRAYSIZE(thread_counts); n++)
+    {
+        ImNodeGraph::SetEvaluationThreadCount(thread_counts[n]);
+        state.Reset();
+        MarkEvalRootsDirty(&state, expected);
+        CheckEvalRun(&state, expected, ImNodeGraph::EvaluateGraph(ImNodeGraphEvalFlags_Parallel | ImNodeGraphEvalFlags_Deterministic));
+        if (n == 0)
+        {
+            reference = state.Sequence;
+            continue;
+        }
+        IM_CHECK_EQ(state.Sequence.Size, reference.Size);
+        IM_CHECK(memcmp(state.Sequence.Data, reference.Data, (size_t)reference.size_in_bytes()) == 0);
+    }
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// Topological order
+//-----------------------------------------------------------------------------
+
+struct TopoTestLink
+{
+    ImGuiID     ID;
+    int         From, To;
+};
+
+static bool IsTestLinkCyclic(ImNodeGraphData* graph, ImGuiID link_id)
+{
+    return graph->Links.Cyclic[ImNodeGraphHandleIndex(ImNodeGraph::FindLink(graph, link_id))];
+}
+
+// Reference: plain DFS over the links evaluation follows, 'from' -> 'to' closes a cycle when 'to' reaches 'from'
+static bool ReferenceClosesCycle(const ImVector<TopoTestLink>& links, const ImVector<bool>& followed, int node_count, int from, int to)
+{
+    ImVector<bool> visited;
+    visited.resize(node_count, false);
+    ImVector<int> stack;
+    stack.push_back(to);
+    visited[to] = true;
+    while (stack.Size > 0)
+    {
+        const int n = stack.back();
+        stack.pop_back();
+        if (n == from)
+            return true;
+        for (int link_n = 0; link_n < links.Size; link_n++)
+            if (followed[link_n] && links[link_n].From == n && !visited[links[link_n].To])
+            {
+                visited[links[link_n].To] = true;
+                stack.push_back(links[link_n].To);
+            }
+    }
+    return false;
+}
+
+static void GetFollowedLinks(ImNodeGraphData* graph, const ImVector<TopoTestLink>& links, ImVector<bool>* out_followed)
+{
+    out_followed->resize(links.Size);
+    for (int link_n = 0; link_n < links.Size; link_n++)
+        (*out_followed)[link_n] = !IsTestLinkCyclic(graph, links[link_n].ID);
+}
+
+// The order lists every node once and every link it follows goes forward. Links it ignores really close a cycle.
+static void CheckTopoOrder(ImNodeGraphData* graph, const ImVector<TopoTestLink>& links, int node_count)
+{
+    const ImNodeGraphNodePool& nodes = graph->Nodes;
+    for (int n = 0; n < node_count; n++)
+    {
+        const int node_idx = ImNodeGraphHandleIndex(ImNodeGraph::FindNode(graph, NodeID(n)));
+        const int order = nodes.TopoOrder[node_idx];
+        IM_CHECK(order >= 0 && order < graph->TopoNodes.Size);
+        IM_CHECK_EQ(graph->TopoNodes[order], node_idx);
+    }
+    ImVector<bool> followed;
+    GetFollowedLinks(graph, links, &followed);
+    for (int link_n = 0; link_n < links.Size; link_n++)
+    {
+        const TopoTestLink& link = links[link_n];
+        const int from_idx = ImNodeGraphHandleIndex(ImNodeGraph::FindNode(graph, NodeID(link.From)));
+        const int to_idx = ImNodeGraphHandleIndex(ImNodeGraph::FindNode(graph, NodeID(link.To)));
+        if (followed[link_n])
+            IM_CHECK(nodes.TopoOrder[from_idx] < nodes.TopoOrder[to_idx]);
+        else
+            IM_CHECK(ReferenceClosesCycle(links, followed, node_count, link.From, link.To));
+    }
+}
+
+static void TestTopoRandomLinks()
+{
+    const int node_count = 40;
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    IM_CHECK(!ImNodeGraph::IsNodeDirty(NodeID(0)));     // Starts maintaining the order before any link exists
+    for (int n = 0; n < node_count; n++)
+        AddTestNode(n);
+
+    // Up to 80 links between 40 nodes: plenty of cycles, and removals which break some of them
+    ImVector<TopoTestLink> links;
+    ImVector<bool> followed;
+    ImGuiID next_link_id = 1;
+    int cyclic_added = 0;
+    const int failures_before = GCheckFailures;
+    for (int step = 0; step < 3000 && GCheckFailures == failures_before; step++)
+    {
+        if (links.Size == 0 || (links.Size < 80 && TestRand(10) < 6))
+        {
+            TopoTestLink link;
+            link.ID = next_link_id++;
+            link.From = TestRand(node_count);
+            link.To = TestRand(node_count);
+            const ImGuiID end_pin_id = TestRand(2) ? InputID(link.To) : Input2ID(link.To);
+            GetFollowedLinks(graph, links, &followed);
+            const bool closes_cycle = ReferenceClosesCycle(links, followed, node_count, link.From, link.To);
+            IM_CHECK_EQ(ImNodeGraph::WouldLinkCloseCycle(OutputID(link.From), end_pin_id), closes_cycle);
+            ImNodeGraph::Link(link.ID, OutputID(link.From), end_pin_id);
+            links.push_back(link);
+            IM_CHECK_EQ(IsTestLinkCyclic(graph, link.ID), closes_cycle);
+            cyclic_added += closes_cycle ? 1 : 0;
+        }
+        else
+        {
+            const int link_n = TestRand(links.Size);
+            ImNodeGraph::RemoveLink(links[link_n].ID);
+            links.erase(links.Data + link_n);
+        }
+        CheckTopoOrder(graph, links, node_count);
+    }
+    IM_CHECK(cyclic_added > 0);
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// Undo history
+//-----------------------------------------------------------------------------
+
+// SetNodePos() records a NodeMoved record: node ID, old and new position
+static const int UndoMoveRecordSize = IMNODEGRAPH_UNDO_HEADER_SIZE + (int)sizeof(ImGuiID) + 2 * (int)sizeof(ImVec2) + IMNODEGRAPH_UNDO_TRAILER_SIZE;
+
+static inline ImVec2 UndoTestPos(int step, int n)   { return ImVec2((float)(step * 10 + n), (float)(step * 7 - n)); }
+
+static bool IsNodeAt(int n, const ImVec2& pos)
+{
+    const ImVec2 node_pos = ImNodeGraph::GetNodePos(NodeID(n));
+    return node_pos.x == pos.x && node_pos.y == pos.y;
+}
+
+// Single moves past the budget: the oldest are dropped, undo stops at the oldest kept and redo goes back to the last
+static void TestUndoBudget()
+{
+    const int kept_count = 10, step_count = 25;
+    BeginTestFrame();
+    AddTestNode(0);
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * kept_count);
+    for (int step = 1; step <= step_count; step++)
+        ImNodeGraph::SetNodePos(NodeID(0), UndoTestPos(step, 0));
+
+    int undo_count = 0;
+    while (ImNodeGraph::Undo())
+    {
+        undo_count++;
+        IM_CHECK(IsNodeAt(0, UndoTestPos(step_count - undo_count, 0)));
+    }
+    IM_CHECK_EQ(undo_count, kept_count);
+    IM_CHECK(!ImNodeGraph::CanUndo());
+    IM_CHECK(ImNodeGraph::CanRedo());
+    for (int n = 0; n < undo_count; n++)
+        IM_CHECK(ImNodeGraph::Redo());
+    IM_CHECK(!ImNodeGraph::Redo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(step_count, 0)));
+
+    // A new edit after undoing drops what could be redone
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(ImNodeGraph::Undo());
+    ImNodeGraph::SetNodePos(NodeID(0), ImVec2(-5.0f, -5.0f));
+    IM_CHECK(!ImNodeGraph::CanRedo());
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(step_count - 2, 0)));
+    IM_CHECK(ImNodeGraph::Redo());
+    IM_CHECK(IsNodeAt(0, ImVec2(-5.0f, -5.0f)));
+    EndTestFrame();
+}
+
+// Steps of three records each, the budget not a multiple of a step: records wrap around the end of the ring
+static void TestUndoGroupsWrap()
+{
+    const int group_size = 3, step_count = 40;
+    BeginTestFrame();
+    for (int n = 0; n < group_size; n++)
+        AddTestNode(n);
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * group_size * 5 + UndoMoveRecordSize / 2);
+    for (int step = 1; step <= step_count; step++)
+    {
+        ImNodeGraph::BeginUndoGroup();
+        for (int n = 0; n < group_size; n++)
+            ImNodeGraph::SetNodePos(NodeID(n), UndoTestPos(step, n));
+        ImNodeGraph::EndUndoGroup();
+    }
+
+    // Each undo restores a whole step
+    int undo_count = 0;
+    while (ImNodeGraph::Undo())
+    {
+        undo_count++;
+        for (int n = 0; n < group_size; n++)
+            IM_CHECK(IsNodeAt(n, UndoTestPos(step_count - undo_count, n)));
+    }
+    IM_CHECK_EQ(undo_count, 5);
+    for (int redo_count = 1; redo_count <= undo_count; redo_count++)
+    {
+        IM_CHECK(ImNodeGraph::Redo());
+        for (int n = 0; n < group_size; n++)
+            IM_CHECK(IsNodeAt(n, UndoTestPos(step_count - undo_count + redo_count, n)));
+    }
+    IM_CHECK(!ImNodeGraph::CanRedo());
+
+    // A step larger than the budget loses its first records: what is left is undone as one step, and is dropped as
+    // a whole by the first edit which needs room
+    const int large_count = 20;
+    for (int n = group_size; n < large_count; n++)
+        AddTestNode(n);
+    ImNodeGraph::ClearUndoHistory();
+    ImNodeGraph::BeginUndoGroup();
+    for (int n = 0; n < large_count; n++)
+        ImNodeGraph::SetNodePos(NodeID(n), UndoTestPos(100, n));
+    ImNodeGraph::EndUndoGroup();
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(!ImNodeGraph::CanUndo());
+    int restored_count = 0;
+    for (int n = 0; n < large_count; n++)
+        restored_count += IsNodeAt(n, UndoTestPos(100, n)) ? 0 : 1;
+    IM_CHECK(restored_count > 0 && restored_count < large_count);
+    IM_CHECK(IsNodeAt(0, UndoTestPos(100, 0)));
+    IM_CHECK(IsNodeAt(large_count - 1, ImVec2((large_count - 1) * 200.0f, 0.0f)));
+    IM_CHECK(ImNodeGraph::Redo());
+    for (int n = 0; n < large_count; n++)
+        IM_CHECK(IsNodeAt(n, UndoTestPos(100, n)));
+    for (int step = 101; step <= 111; step++)
+        ImNodeGraph::SetNodePos(NodeID(0), UndoTestPos(step, 0));
+    int single_count = 0;
+    while (ImNodeGraph::Undo())
+        single_count++;
+    IM_CHECK_EQ(single_count, 11);
+    IM_CHECK(IsNodeAt(0, UndoTestPos(100, 0)));
+    EndTestFrame();
+}
+
+// Shrinking keeps the most recent steps, the cursor stays on the same step when it is kept
+static void TestUndoBudgetShrink()
+{
+    const int step_count = 10;
+    BeginTestFrame();
+    AddTestNode(0);
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * 100);
+    for (int step = 1; step <= step_count; step++)
+        ImNodeGraph::SetNodePos(NodeID(0), UndoTestPos(step, 0));
+    for (int n = 0; n < 4; n++)
+        IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(6, 0)));
+
+    // Steps 6 to 10 are kept, the cursor is past step 6
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * 5);
+    IM_CHECK(IsNodeAt(0, UndoTestPos(6, 0)));
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(5, 0)));
+    IM_CHECK(!ImNodeGraph::CanUndo());
+    for (int step = 6; step <= step_count; step++)
+    {
+        IM_CHECK(ImNodeGraph::Redo());
+        IM_CHECK(IsNodeAt(0, UndoTestPos(step, 0)));
+    }
+    IM_CHECK(!ImNodeGraph::CanRedo());
+
+    // Only steps past the cursor fit: nothing to undo, the kept steps can still be redone
+    for (int n = 0; n < 3; n++)
+        IM_CHECK(ImNodeGraph::Undo());
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * 2);
+    IM_CHECK(!ImNodeGraph::CanUndo());
+    IM_CHECK(ImNodeGraph::Redo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(step_count - 1, 0)));
+    IM_CHECK(ImNodeGraph::Redo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(step_count, 0)));
+    IM_CHECK(!ImNodeGraph::CanRedo());
+
+    // Growing keeps everything
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * 50);
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(!ImNodeGraph::CanUndo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(step_count - 2, 0)));
+    EndTestFrame();
+}
+
+// Moving the same node again within a group updates its record in place
+static void TestUndoMergeMoves()
+{
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    AddTestNode(0);
+    AddTestNode(1);
+    const ImVec2 start_pos = ImNodeGraph::GetNodePos(NodeID(0));
+    ImNodeGraph::SetUndoBudget(UndoMoveRecordSize * 8 + UndoMoveRecordSize / 3);
+    for (int round = 0; round < 20; round++)  // Enough to wrap the ring, records get split at its end
+    {
+        const ImU64 end = graph->Undo.End;
+        ImNodeGraph::BeginUndoGroup();
+        for (int step = 1; step <= 10; step++)
+            ImNodeGraph::SetNodePos(NodeID(0), UndoTestPos(round * 10 + step, 0));
+        ImNodeGraph::EndUndoGroup();
+        IM_CHECK_EQ(graph->Undo.End - end, UndoMoveRecordSize);
+        ImNodeGraph::SetNodePos(NodeID(1), UndoTestPos(round, 1));
+    }
+
+    // Node 1 and node 0 alternate, each group of node 0 undoes to where it started
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(190, 0)));
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(180, 0)));
+    IM_CHECK(ImNodeGraph::Redo());
+    IM_CHECK(IsNodeAt(0, UndoTestPos(190, 0)));
+
+    // Another node moved in between ends the merge
+    ImNodeGraph::SetNodePos(NodeID(0), start_pos);
+    ImNodeGraph::ClearUndoHistory();
+    ImNodeGraph::BeginUndoGroup();
+    ImNodeGraph::SetNodePos(NodeID(0), ImVec2(1.0f, 1.0f));
+    ImNodeGraph::SetNodePos(NodeID(1), ImVec2(2.0f, 2.0f));
+    ImNodeGraph::SetNodePos(NodeID(0), ImVec2(3.0f, 3.0f));
+    ImNodeGraph::EndUndoGroup();
+    IM_CHECK_EQ(graph->Undo.End - graph->Undo.Begin, UndoMoveRecordSize * 3);
+    IM_CHECK(ImNodeGraph::Undo());
+    IM_CHECK(IsNodeAt(0, start_pos));
+    IM_CHECK(!ImNodeGraph::CanUndo());
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// Auto layout
+//-----------------------------------------------------------------------------
+
+struct LayoutTestState
+{
+    ImVector<int>   LinkFrom;           // Node indices, as for EvalTestState
+    ImVector<int>   LinkTo;
+    ImGuiID         NextLinkID;
+
+    LayoutTestState() { NextLinkID = 1; }
+};
+
+// Nodes of different sizes, so layers are not a regular grid
+static void AddLayoutTestNode(int n)
+{
+    AddTestNode(n);
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    const int node_idx = ImNodeGraphHandleIndex(ImNodeGraph::FindNode(graph, NodeID(n)));
+    graph->Nodes.Size[node_idx] = ImVec2(100.0f + (n % 3) * 40.0f, 50.0f + (n % 4) * 30.0f);
+    ImNodeGraph::UpdateNodeBounds(graph, node_idx);
+}
+
+static void AddLayoutTestLink(LayoutTestState* state, int from, ImGuiID end_pin_id, int to)
+{
+    ImNodeGraph::Link(state->NextLinkID++, OutputID(from), end_pin_id);
+    state->LinkFrom.push_back(from);
+    state->LinkTo.push_back(to);
+}
+
+// Layouts are computed on a worker and applied by BeginGraph(): run frames until the nodes are in place
+static bool WaitForLayout()
+{
+    for (int frame = 0; frame < 1000000; frame++)
+    {
+        if (!ImNodeGraph::IsLayoutInProgress())
+            return true;
+        EndTestFrame();
+        BeginTestFrame();
+    }
+    return false;
+}
+
+static bool HasOverlappingNodes(ImNodeGraphData* graph)
+{
+    const ImNodeGraphNodePool& nodes = graph->Nodes;
+    for (int a = 0; a < nodes.Slots.GetSize(); a++)
+        for (int b = a + 1; b < nodes.Slots.GetSize(); b++)
+            if (nodes.Slots.IsSlotAlive(a) && nodes.Slots.IsSlotAlive(b) && nodes.GetRect(a).Overlaps(nodes.GetRect(b)))
+                return true;
+    return false;
+}
+
+// Nodes an incremental layout may move: the ones added or relinked, and their direct neighbors
+static void MarkLayoutMovable(const LayoutTestState& state, int first_change_link, const ImVector<int>& added, ImVector<bool>* movable)
+{
+    ImVector<bool> changed;
+    changed.resize(movable->Size, false);
+    for (int n = 0; n < added.Size; n++)
+        changed[added[n]] = true;
+    for (int e = first_change_link; e < state.LinkFrom.Size; e++)
+        changed[state.LinkFrom[e]] = changed[state.LinkTo[e]] = true;
+    for (int n = 0; n < movable->Size; n++)
+        (*movable)[n] = changed[n];
+    for (int e = 0; e < state.LinkFrom.Size; e++)
+        if (changed[state.LinkFrom[e]] || changed[state.LinkTo[e]])
+            (*movable)[state.LinkFrom[e]] = (*movable)[state.LinkTo[e]] = true;
+}
+
+// A tree laid out in full, then nodes added and linked into it: the incremental layout only moves the nodes around the
+// changes, and fits them without overlapping anything
+static void TestLayoutIncremental()
+{
+    const int tree_count = 40, added_count = 10, node_count = tree_count + added_count;
+    LayoutTestState state;
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    for (int n = 0; n < tree_count; n++)
+    {
+        AddLayoutTestNode(n);
+        if (n > 0)
+            AddLayoutTestLink(&state, TestRand(n), InputID(n), n);
+    }
+    ImNodeGraph::StartLayout(ImNodeGraphLayout_Layered, ImNodeGraphLayoutFlags_NoAnimation);
+    IM_CHECK(WaitForLayout());
+    IM_CHECK(!HasOverlappingNodes(graph));
+
+    // New nodes fed by the tree, half of them also feeding a tree node past their source: the graph stays acyclic
+    const int first_change_link = state.LinkFrom.Size;
+    ImVector<int> added;
+    ImVector<bool> input2_used;
+    input2_used.resize(tree_count, false);
+    for (int n = tree_count; n < node_count; n++)
+    {
+        AddLayoutTestNode(n);
+        added.push_back(n);
+        const int from = TestRand(tree_count - 1);
+        AddLayoutTestLink(&state, from, InputID(n), n);
+        const int to = from + 1 + TestRand(tree_count - 1 - from);
+        if ((n & 1) == 0 && !input2_used[to])
+        {
+            AddLayoutTestLink(&state, n, Input2ID(to), to);
+            input2_used[to] = true;
+        }
+    }
+    ImVector<bool> movable;
+    movable.resize(node_count);
+    MarkLayoutMovable(state, first_change_link, added, &movable);
+    ImVector<ImVec2> prev_pos;
+    for (int n = 0; n < node_count; n++)
+        prev_pos.push_back(ImNodeGraph::GetNodePos(NodeID(n)));
+
+    ImNodeGraph::StartLayout(ImNodeGraphLayout_Layered, ImNodeGraphLayoutFlags_Incremental | ImNodeGraphLayoutFlags_NoAnimation);
+    IM_CHECK(WaitForLayout());
+    int fixed_count = 0;
+    for (int n = 0; n < node_count; n++)
+        if (!movable[n])
+        {
+            const ImVec2 pos = ImNodeGraph::GetNodePos(NodeID(n));
+            IM_CHECK(pos.x == prev_pos[n].x && pos.y == prev_pos[n].y);
+            fixed_count++;
+        }
+    IM_CHECK(fixed_count > 0);
+    IM_CHECK(!HasOverlappingNodes(graph));
+
+    // Nothing changed since: no layout to run
+    ImNodeGraph::StartLayout(ImNodeGraphLayout_Layered, ImNodeGraphLayoutFlags_Incremental | ImNodeGraphLayoutFlags_NoAnimation);
+    IM_CHECK(!ImNodeGraph::IsLayoutInProgress());
+    EndTestFrame();
+}
+
+// Force directed placement around the same kind of changes: nodes away from them keep their position
+static void TestLayoutForceIncremental()
+{
+    const int tree_count = 40, added_count = 5, node_count = tree_count + added_count;
+    LayoutTestState state;
+    BeginTestFrame();
+    for (int n = 0; n < tree_count; n++)
+    {
+        AddLayoutTestNode(n);
+        if (n > 0)
+            AddLayoutTestLink(&state, TestRand(n), InputID(n), n);
+    }
+    ImNodeGraph::StartLayout(ImNodeGraphLayout_ForceDirected, ImNodeGraphLayoutFlags_NoAnimation);
+    IM_CHECK(WaitForLayout());
+
+    const int first_change_link = state.LinkFrom.Size;
+    ImVector<int> added;
+    for (int n = tree_count; n < node_count; n++)
+    {
+        AddLayoutTestNode(n);
+        added.push_back(n);
+        AddLayoutTestLink(&state, TestRand(tree_count), InputID(n), n);
+    }
+    ImVector<bool> movable;
+    movable.resize(node_count);
+    MarkLayoutMovable(state, first_change_link, added, &movable);
+    ImVector<ImVec2> prev_pos;
+    for (int n = 0; n < node_count; n++)
+        prev_pos.push_back(ImNodeGraph::GetNodePos(NodeID(n)));
+
+    ImNodeGraph::StartLayout(ImNodeGraphLayout_ForceDirected, ImNodeGraphLayoutFlags_Incremental | ImNodeGraphLayoutFlags_NoAnimation);
+    IM_CHECK(WaitForLayout());
+    for (int n = 0; n < node_count; n++)
+    {
+        // Fixed nodes go through their center and back, which may round
+        const ImVec2 pos = ImNodeGraph::GetNodePos(NodeID(n));
+        IM_CHECK(pos.x == pos.x && pos.y == pos.y);
+        if (!movable[n])
+            IM_CHECK(ImFabs(pos.x - prev_pos[n].x) < 0.01f && ImFabs(pos.y - prev_pos[n].y) < 0.01f);
+    }
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// Graph files
+//-----------------------------------------------------------------------------
+
+// Everything a graph file stores, gathered from the pools and sorted by ID so graphs compare with memcmp()
+struct SnapshotNode     { ImGuiID ID; ImVec2 Pos; ImVec2 Size; ImGuiID FirstPinID; };
+struct SnapshotPin      { ImGuiID ID; ImGuiID NodeID; ImGuiID NextPinID; ImPinDirection Direction; ImPinType Type; ImVec2 Offset; };
+struct SnapshotLink     { ImGuiID ID; ImGuiID StartPinID; ImGuiID EndPinID; };
+
+struct GraphSnapshot
+{
+    ImVector<SnapshotNode>  Nodes;
+    ImVector<SnapshotPin>   Pins;
+    ImVector<SnapshotLink>  Links;
+};
+
+static int CompareSnapshotIDs(const void* lhs, const void* rhs)
+{
+    const ImGuiID a = *(const ImGuiID*)lhs, b = *(const ImGuiID*)rhs;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+static ImGuiID GetPinIDOrZero(ImNodeGraphData* graph, ImNodeGraphHandle pin)
+{
+    return (pin != 0) ? graph->Pins.ID[ImNodeGraphHandleIndex(pin)] : 0;
+}
+
+static void TakeSnapshot(ImNodeGraphData* graph, GraphSnapshot* out)
+{
+    const ImNodeGraphNodePool& nodes = graph->Nodes;
+    const ImNodeGraphPinPool& pins = graph->Pins;
+    const ImNodeGraphLinkPool& links = graph->Links;
+    out->Nodes.resize(0);
+    out->Pins.resize(0);
+    out->Links.resize(0);
+    for (int idx = 0; idx < nodes.Slots.GetSize(); idx++)
+        if (nodes.Slots.IsSlotAlive(idx))
+        {
+            SnapshotNode node;
+            memset(&node, 0, sizeof(node));
+            node.ID = nodes.ID[idx];
+            node.Pos = nodes.Pos[idx];
+            node.Size = nodes.Size[idx];
+            node.FirstPinID = GetPinIDOrZero(graph, nodes.FirstPin[idx]);
+            out->Nodes.push_back(node);
+        }
+    for (int idx = 0; idx < pins.Slots.GetSize(); idx++)
+        if (pins.Slots.IsSlotAlive(idx))
+        {
+            SnapshotPin pin;
+            memset(&pin, 0, sizeof(pin));
+            pin.ID = pins.ID[idx];
+            pin.NodeID = nodes.ID[ImNodeGraphHandleIndex(pins.Node[idx])];
+            pin.NextPinID = GetPinIDOrZero(graph, pins.NextPin[idx]);
+            pin.Direction = pins.Direction[idx];
+            pin.Type = pins.Type[idx];
+            pin.Offset = pins.Offset[idx];
+            out->Pins.push_back(pin);
+        }
+    for (int idx = 0; idx < links.Slots.GetSize(); idx++)
+        if (links.Slots.IsSlotAlive(idx))
+        {
+            SnapshotLink link;
+            memset(&link, 0, sizeof(link));
+            link.ID = links.ID[idx];
+            link.StartPinID = GetPinIDOrZero(graph, links.StartPin[idx]);
+            link.EndPinID = GetPinIDOrZero(graph, links.EndPin[idx]);
+            out->Links.push_back(link);
+        }
+    ImQsort(out->Nodes.Data, (size_t)out->Nodes.Size, sizeof(SnapshotNode), CompareSnapshotIDs);
+    ImQsort(out->Pins.Data, (size_t)out->Pins.Size, sizeof(SnapshotPin), CompareSnapshotIDs);
+    ImQsort(out->Links.Data, (size_t)out->Links.Size, sizeof(SnapshotLink), CompareSnapshotIDs);
+}
+
+static void CheckSnapshot(ImNodeGraphData* graph, const GraphSnapshot& expected)
+{
+    GraphSnapshot current;
+    TakeSnapshot(graph, &current);
+    IM_CHECK_EQ(current.Nodes.Size, expected.Nodes.Size);
+    IM_CHECK_EQ(current.Pins.Size, expected.Pins.Size);
+    IM_CHECK_EQ(current.Links.Size, expected.Links.Size);
+    IM_CHECK(memcmp(current.Nodes.Data, expected.Nodes.Data, (size_t)expected.Nodes.size_in_bytes()) == 0);
+    IM_CHECK(memcmp(current.Pins.Data, expected.Pins.Data, (size_t)expected.Pins.size_in_bytes()) == 0);
+    IM_CHECK(memcmp(current.Links.Data, expected.Links.Data, (size_t)expected.Links.size_in_bytes()) == 0);
+
+    // Lookups go through the rebuilt maps
+    for (int n = 0; n < expected.Nodes.Size; n++)
+        IM_CHECK(ImNodeGraph::FindNode(graph, expected.Nodes[n].ID) != 0);
+    for (int n = 0; n < expected.Pins.Size; n++)
+        IM_CHECK(ImNodeGraph::FindPin(graph, expected.Pins[n].ID) != 0);
+    for (int n = 0; n < expected.Links.Size; n++)
+        IM_CHECK(ImNodeGraph::FindLink(graph, expected.Links[n].ID) != 0);
+}
+
+// Random DAG with a few removals so the pools have holes, plus a pin of a varying type on every node
+static void BuildFileTestGraph(int node_count)
+{
+    ImGuiID link_id = 1;
+    for (int n = 0; n < node_count; n++)
+    {
+        AddTestNode(n);
+        ImNodeGraph::SetNodePos(NodeID(n), ImVec2((float)TestRand(4000), (float)TestRand(4000)));
+        ImNodeGraph::AddPin(NodeID(n), 0x80000000u + (ImGuiID)n, ImPinDirection_Output, n % 5);
+        if (n == 0)
+            continue;
+        ImNodeGraph::Link(link_id++, OutputID(TestRand(n)), InputID(n));
+        if (TestRand(2) == 0)
+            ImNodeGraph::Link(link_id++, OutputID(TestRand(n)), Input2ID(n));
+    }
+    for (int n = 0; n < node_count; n += 17)
+        ImNodeGraph::RemoveNode(NodeID(n));
+}
+
+static const void* FileTestPayload(ImGuiID node_id, size_t* out_size, void*)
+{
+    static char buf[32];
+    if (node_id % 3 != 0)
+        return NULL;
+    *out_size = (size_t)ImFormatString(buf, IM_ARRAYSIZE(buf), "payload %u", node_id);
+    return buf;
+}
+
+static bool ReadTestFile(const char* filename, ImVector<char>* out_data)
+{
+    size_t size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &size);
+    if (data == NULL)
+        return false;
+    out_data->resize((int)size);
+    memcpy(out_data->Data, data, size);
+    IM_FREE(data);
+    return true;
+}
+
+static bool WriteTestFile(const char* filename, const void* data, size_t size)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+        return false;
+    const bool ok = fwrite(data, 1, size, f) == size;
+    fclose(f);
+    return ok;
+}
+
+static const char* BinaryTestFilename = "imnode_graph_tests.bin";
+static const char* CorruptTestFilename = "imnode_graph_tests_corrupt.bin";
+
+static void TestFileRoundTrip()
+{
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    BuildFileTestGraph(500);
+    GraphSnapshot saved;
+    TakeSnapshot(graph, &saved);
+    IM_CHECK(ImNodeGraph::SaveGraph(BinaryTestFilename, FileTestPayload));
+
+    // Diverge before loading back
+    ImNodeGraph::RemoveNode(NodeID(1));
+    ImNodeGraph::SetNodePos(NodeID(2), ImVec2(-1.0f, -1.0f));
+    IM_CHECK(ImNodeGraph::LoadGraph(BinaryTestFilename));
+    IM_CHECK(graph->ColumnsMapped);
+    CheckSnapshot(graph, saved);
+    for (int n = 0; n < saved.Nodes.Size; n++)
+    {
+        const ImGuiID node_id = saved.Nodes[n].ID;
+        size_t size = 0;
+        const char* payload = (const char*)ImNodeGraph::GetNodePayload(node_id, &size);
+        if (node_id % 3 != 0)
+        {
+            IM_CHECK(payload == NULL);
+            continue;
+        }
+        char expected[32];
+        IM_CHECK(payload != NULL);
+        IM_CHECK_EQ(size, ImFormatString(expected, IM_ARRAYSIZE(expected), "payload %u", node_id));
+        IM_CHECK(memcmp(payload, expected, size) == 0);
+    }
+    EndTestFrame();
+}
+
+// The first addition copies the mapped columns out of the file, existing elements must come along unchanged
+static void TestFileMutateAfterLoad()
+{
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    BuildFileTestGraph(300);
+    GraphSnapshot saved;
+    TakeSnapshot(graph, &saved);
+    IM_CHECK(ImNodeGraph::SaveGraph(BinaryTestFilename));
+    IM_CHECK(ImNodeGraph::LoadGraph(BinaryTestFilename));
+
+    // Written to the private mapping, never to the file
+    const ImVec2 moved_pos(12345.0f, 678.0f);
+    ImNodeGraph::SetNodePos(NodeID(1), moved_pos);
+    IM_CHECK(graph->ColumnsMapped);
+
+    const int new_n = 10000;
+    AddTestNode(new_n);
+    IM_CHECK(!graph->ColumnsMapped);
+    ImNodeGraph::Link(0x40000000u, OutputID(2), InputID(new_n));
+    ImNodeGraph::Link(0x40000001u, OutputID(new_n), Input2ID(3));
+    IM_CHECK(ImNodeGraph::GetNodePos(NodeID(1)).x == moved_pos.x && ImNodeGraph::GetNodePos(NodeID(1)).y == moved_pos.y);
+    IM_CHECK(ImNodeGraph::FindLink(graph, 0x40000001u) != 0);
+
+    // Undoing the additions and the move gives back the saved graph
+    ImNodeGraph::RemoveNode(NodeID(new_n));
+    for (int n = 0; n < saved.Nodes.Size; n++)
+        if (saved.Nodes[n].ID == NodeID(1))
+            ImNodeGraph::SetNodePos(NodeID(1), saved.Nodes[n].Pos);
+    CheckSnapshot(graph, saved);
+
+    IM_CHECK(ImNodeGraph::LoadGraph(BinaryTestFilename));
+    CheckSnapshot(graph, saved);
+    EndTestFrame();
+}
+
+// Each corruption is applied to a copy of a valid file, loading must fail and leave the current graph as it was
+static void TestFileCorrupt()
+{
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    BuildFileTestGraph(100);
+    IM_CHECK(ImNodeGraph::SaveGraph(BinaryTestFilename, FileTestPayload));
+    ImVector<char> valid;
+    IM_CHECK(ReadTestFile(BinaryTestFilename, &valid));
+    ImNodeGraph::RemoveNode(NodeID(1));
+    GraphSnapshot current;
+    TakeSnapshot(graph, &current);
+
+    enum Corruption
+    {
+        Corruption_TruncatedHeader,
+        Corruption_TruncatedBody,
+        Corruption_Magic,
+        Corruption_Version,
+        Corruption_FileSize,
+        Corruption_NodeCount,
+        Corruption_SectionOffset,
+        Corruption_SectionSize,
+        Corruption_HandleOutOfRange,
+        Corruption_PayloadRange,
+        Corruption_PinChainLoop,
+        Corruption_PinOwner,
+        Corruption_LinkChainLoop,
+        Corruption_PinDirection,
+        Corruption_NodePosNaN,
+        Corruption_NodePosHuge,
+        Corruption_NodeSizeNegative,
+        Corruption_NodeSizeHuge,
+        Corruption_PinOffsetNaN,
+        Corruption_PinOffsetHuge,
+        Corruption_DuplicateNodeID,
+        Corruption_DuplicatePinID,
+        Corruption_DuplicateLinkID,
+        Corruption_COUNT
+    };
+    for (int corruption = 0; corruption < Corruption_COUNT; corruption++)
+    {
+        ImVector<char> data = valid;
+        ImNodeGraphFileHeader* header = (ImNodeGraphFileHeader*)(void*)data.Data;
+        ImNodeGraphHandle* pin_next_pin = (ImNodeGraphHandle*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_PinNextPin].Offset);
+        ImNodeGraphHandle* link_next_at_start = (ImNodeGraphHandle*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_LinkNextAtStart].Offset);
+        ImNodeGraphHandle* pin_node = (ImNodeGraphHandle*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_PinNode].Offset);
+        ImNodeGraphFileRange* payloads = (ImNodeGraphFileRange*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_NodePayload].Offset);
+        ImVec2* node_pos = (ImVec2*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_NodePos].Offset);
+        ImVec2* node_size = (ImVec2*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_NodeSize].Offset);
+        ImVec2* pin_offset = (ImVec2*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_PinOffset].Offset);
+        ImGuiID* node_ids = (ImGuiID*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_NodeID].Offset);
+        ImGuiID* pin_ids = (ImGuiID*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_PinID].Offset);
+        ImGuiID* link_ids = (ImGuiID*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_LinkID].Offset);
+        const ImNodeGraphHandle first_slot = (1u << IMNODEGRAPH_HANDLE_INDEX_BITS);     // Saved handles are dense, of generation 1
+        const ImU32 nan_bits = 0x7FC00000;
+        float nan;
+        memcpy(&nan, &nan_bits, sizeof(nan));
+        switch (corruption)
+        {
+        case Corruption_TruncatedHeader:    data.resize((int)sizeof(ImNodeGraphFileHeader) / 2); break;
+        case Corruption_TruncatedBody:      data.resize(data.Size - 1); break;
+        case Corruption_Magic:              header->Magic[0] ^= 1; break;
+        case Corruption_Version:            header->Version = IMNODEGRAPH_FILE_VERSION + 1; break;
+        case Corruption_FileSize:           header->FileSize += 16; break;
+        case Corruption_NodeCount:          header->NodeCount = IMNODEGRAPH_HANDLE_MAX_SLOTS; break;
+        case Corruption_SectionOffset:      header->Sections[ImNodeGraphFileSection_PinID].Offset = (ImU64)data.Size; break;
+        case Corruption_SectionSize:        header->Sections[ImNodeGraphFileSection_LinkID].Size -= 4; break;
+        case Corruption_HandleOutOfRange:   pin_node[0] = first_slot | header->NodeCount; break;
+        case Corruption_PayloadRange:       payloads[0].Size = header->Sections[ImNodeGraphFileSection_PayloadData].Size + 1; break;
+        case Corruption_PinChainLoop:       pin_next_pin[0] = first_slot | 0; break;
+        case Corruption_PinOwner:           pin_node[0] = first_slot | 1; break;    // Still listed by node 0
+        case Corruption_LinkChainLoop:      link_next_at_start[0] = first_slot | 0; break;
+        case Corruption_PinDirection:       ((ImPinDirection*)(void*)(data.Data + header->Sections[ImNodeGraphFileSection_PinDirection].Offset))[0] = 7; break;
+        case Corruption_NodePosNaN:         node_pos[1].y = nan; break;
+        case Corruption_NodePosHuge:        node_pos[1].x = 1e30f; break;
+        case Corruption_NodeSizeNegative:   node_size[2].x = -1.0f; break;
+        case Corruption_NodeSizeHuge:       node_size[2].y = IMNODEGRAPH_FILE_MAX_NODE_SIZE * 2.0f; break;
+        case Corruption_PinOffsetNaN:       pin_offset[3].x = nan; break;
+        case Corruption_PinOffsetHuge:      pin_offset[3].y = -1e30f; break;
+        case Corruption_DuplicateNodeID:    node_ids[5] = node_ids[4]; break;
+        case Corruption_DuplicatePinID:     pin_ids[7] = pin_ids[2]; break;
+        case Corruption_DuplicateLinkID:    link_ids[3] = link_ids[0]; break;
+        }
+        IM_CHECK(WriteTestFile(CorruptTestFilename, data.Data, (size_t)data.Size));
+        if (ImNodeGraph::LoadGraph(CorruptTestFilename))
+        {
+            fprintf(stderr, "corruption %d was loaded\n", corruption);
+            IM_CHECK(false);
+        }
+        CheckSnapshot(graph, current);
+    }
+    IM_CHECK(!ImNodeGraph::LoadGraph("imnode_graph_tests_missing.bin"));
+    CheckSnapshot(graph, current);
+
+    // The untouched copy still loads
+    IM_CHECK(WriteTestFile(CorruptTestFilename, valid.Data, (size_t)valid.Size));
+    IM_CHECK(ImNodeGraph::LoadGraph(CorruptTestFilename));
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// JSON graph files
+//-----------------------------------------------------------------------------
+
+static bool WriteJsonToVector(const void* data, size_t size, void* user_data)
+{
+    ImVector<char>* buf = (ImVector<char>*)user_data;
+    const int offset = buf->Size;
+    buf->resize(offset + (int)size);
+    memcpy(buf->Data + offset, data, size);
+    return true;
+}
+
+// Hands out at most ChunkSize bytes per call
+struct JsonTestReader
+{
+    const char* Data;
+    size_t      Size;
+    size_t      Pos;
+    size_t      ChunkSize;
+};
+
+static size_t ReadJsonFromMemory(void* buffer, size_t size, void* user_data)
+{
+    JsonTestReader* reader = (JsonTestReader*)user_data;
+    const size_t count = ImMin(ImMin(size, reader->ChunkSize), reader->Size - reader->Pos);
+    memcpy(buffer, reader->Data + reader->Pos, count);
+    reader->Pos += count;
+    return count;
+}
+
+static bool LoadJsonFromMemory(const char* data, size_t size, size_t chunk_size)
+{
+    JsonTestReader reader = { data, size, 0, chunk_size };
+    return ImNodeGraph::LoadGraphJson(ReadJsonFromMemory, &reader);
+}
+
+// The loaded storage replaces what the frame works with: the next frames must draw, select and move it like any other
+static void CheckLoadedGraphUsable(ImNodeGraphData* graph, const GraphSnapshot& saved)
+{
+    EndTestFrame();
+    BeginTestFrame();
+    int submitted = 0;
+    for (int n = 0; n < saved.Nodes.Size; n++)
+    {
+        const ImGuiID node_id = saved.Nodes[n].ID;
+        if (!ImNodeGraph::BeginNode(node_id, "Node", 1))
+            continue;
+        ImNodeGraph::Pin(node_id + 1, "A", ImPinDirection_Input);
+        ImNodeGraph::Pin(node_id + 2, "B", ImPinDirection_Input);
+        ImNodeGraph::Pin(node_id + 3, "Out", ImPinDirection_Output);
+        ImNodeGraph::EndNode();
+        submitted++;
+    }
+    IM_CHECK(submitted > 0);
+    ImNodeGraph::SelectAll();
+    IM_CHECK_EQ(ImNodeGraph::GetSelectedNodeCount(), saved.Nodes.Size);
+    ImNodeGraph::InvertSelection();
+    IM_CHECK_EQ(ImNodeGraph::GetSelectedNodeCount(), 0);
+
+    // Moved across minimap cells, every node still counted once
+    const float minimap_cell_size = graph->NodeGrid.CellSize * IMNODEGRAPH_MINIMAP_CELL_SCALE;
+    for (int n = 0; n < saved.Nodes.Size; n += 3)
+        ImNodeGraph::SetNodePos(saved.Nodes[n].ID, saved.Nodes[n].Pos + ImVec2(minimap_cell_size * 3.0f, minimap_cell_size));
+    ImU32 minimap_count = graph->Minimap.Cells.HasZeroKey ? graph->Minimap.Cells.ZeroKeyValue : 0;
+    for (int n = 0; n < graph->Minimap.Cells.Pairs.Size; n++)
+        minimap_count += (graph->Minimap.Cells.Pairs[n].Key != 0) ? graph->Minimap.Cells.Pairs[n].Value : 0;
+    IM_CHECK_EQ(minimap_count, saved.Nodes.Size);
+    for (int n = 0; n < saved.Nodes.Size; n += 3)
+        ImNodeGraph::SetNodePos(saved.Nodes[n].ID, saved.Nodes[n].Pos);
+    EndTestFrame();
+    BeginTestFrame();
+}
+
+static void TestJsonRoundTrip()
+{
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    BuildFileTestGraph(300);
+    GraphSnapshot saved;
+    TakeSnapshot(graph, &saved);
+    ImVector<char> json;
+    IM_CHECK(ImNodeGraph::SaveGraphJson(WriteJsonToVector, &json));
+
+    ImNodeGraph::RemoveNode(NodeID(1));
+    IM_CHECK(LoadJsonFromMemory(json.Data, (size_t)json.Size, IMNODEGRAPH_JSON_CHUNK_SIZE));
+    CheckSnapshot(graph, saved);
+
+    // Saving the loaded graph gives the same graph again, through files this time
+    IM_CHECK(ImNodeGraph::SaveGraphJson("imnode_graph_tests.json"));
+    ImNodeGraph::RemoveNode(NodeID(2));
+    IM_CHECK(ImNodeGraph::LoadGraphJson("imnode_graph_tests.json"));
+    CheckSnapshot(graph, saved);
+    CheckLoadedGraphUsable(graph, saved);
+    EndTestFrame();
+}
+
+// Every token straddles a chunk boundary
+static void TestJsonByteChunks()
+{
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    BuildFileTestGraph(100);
+    GraphSnapshot saved;
+    TakeSnapshot(graph, &saved);
+    ImVector<char> json;
+    IM_CHECK(ImNodeGraph::SaveGraphJson(WriteJsonToVector, &json));
+    const size_t chunk_sizes[] = { 1, 2, 3, 7 };
+    for (int n = 0; n < IM_ARRAYSIZE(chunk_sizes); n++)
+    {
+        ImNodeGraph::RemoveNode(NodeID(1 + n));
+        IM_CHECK(LoadJsonFromMemory(json.Data, (size_t)json.Size, chunk_sizes[n]));
+        CheckSnapshot(graph, saved);
+        CheckLoadedGraphUsable(graph, saved);
+    }
+    EndTestFrame();
+}
+
+// Malformed input fails and leaves the current graph as it was
+static void TestJsonMalformed()
+{
+    static const char* const documents[] =
+    {
+        "",
+        "{",
+        "[]",
+        "{\"version\":2,\"nodes\":[],\"links\":[]}",
+        "{\"version\":1,\"nodes\":[]}x",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pos\":[0,0]},]}",
+        "{\"version\":1,\"nodes\":[{\"id\":-3,\"pos\":[0,0]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1.5,\"pos\":[0,0]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pos\":[0,1e]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pins\":[{\"id\":2,\"direction\":\"sideways\"}]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pins\":[{\"id\":2,\"direction\":\"input\",\"type\":1.5}]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pins\":[{\"id\":2,\"direction\":\"input\",\"type\":-1}]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pins\":[{\"id\":2,\"direction\":\"input\",\"type\":1e10}]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"pins\":[{\"id\":2,\"direction\":\"input\",\"type\":\"int\"}]}]}",
+        "{\"version\":1,\"nodes\":[{\"id\":1,\"unknown\":\"unterminated}]}",
+        "{\"version\":1,\"nodes\":[],\"links\":[{\"id\":1,\"start\":2,\"end\":3},{\"id\":1,\"start\":2,\"end\":3}]}",
+    };
+
+    BeginTestFrame();
+    ImNodeGraphData* graph = ImNodeGraph::GetCurrentGraph();
+    BuildFileTestGraph(50);
+    GraphSnapshot current;
+    TakeSnapshot(graph, &current);
+    for (int n = 0; n < IM_ARRAYSIZE(documents); n++)
+    {
+        if (LoadJsonFromMemory(documents[n], strlen(documents[n]), 1))
+        {
+            fprintf(stderr, "malformed document %d was loaded\n", n);
+            IM_CHECK(false);
+        }
+        CheckSnapshot(graph, current);
+    }
+
+    // Cut anywhere before the closing brace
+    ImVector<char> json;
+    IM_CHECK(ImNodeGraph::SaveGraphJson(WriteJsonToVector, &json));
+    int end = json.Size;
+    while (end > 0 && json[end - 1] != '}')
+        end--;
+    for (int size = 0; size < end; size += 1 + size / 8)
+    {
+        IM_CHECK(!LoadJsonFromMemory(json.Data, (size_t)size, 5));
+        CheckSnapshot(graph, current);
+    }
+    IM_CHECK(!LoadJsonFromMemory(json.Data, (size_t)end - 1, 5));
+    IM_CHECK(LoadJsonFromMemory(json.Data, (size_t)json.Size, 5));
+    CheckSnapshot(graph, current);
+    EndTestFrame();
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+struct TestEntry
+{
+    const char* Name;
+    void        (*Func)();
+};
+
+static const TestEntry Tests[] =
+{
+    { "graph_build",                TestGraphBuild },
+    { "idmap_zero_key",             TestIDMapZeroKey },
+    { "idmap_backward_shift",       TestIDMapBackwardShift },
+    { "idmap_growth",               TestIDMapGrowth },
+    { "idmap_churn",                TestIDMapChurn },
+    { "eval_parallel",              TestEvalParallel },
+    { "eval_deterministic",         TestEvalDeterministic },
+    { "topo_random_links",          TestTopoRandomLinks },
+    { "undo_budget",                TestUndoBudget },
+    { "undo_groups_wrap",           TestUndoGroupsWrap },
+    { "undo_budget_shrink",         TestUndoBudgetShrink },
+    { "undo_merge_moves",           TestUndoMergeMoves },
+    { "layout_incremental",         TestLayoutIncremental },
+    { "layout_force_incremental",   TestLayoutForceIncremental },
+    { "file_round_trip",            TestFileRoundTrip },
+    { "file_mutate_after_load",     TestFileMutateAfterLoad },
+    { "file_corrupt",               TestFileCorrupt },
+    { "json_round_trip",            TestJsonRoundTrip },
+    { "json_byte_chunks",           TestJsonByteChunks },
+    { "json_malformed",             TestJsonMalformed },
+};
+
+static bool MatchTest(const char* name, int argc, char** argv)
+{
+    if (argc <= 1)
+        return true;
+    for (int n = 1; n < argc; n++)
+        if (strncmp(name, argv[n], strlen(argv[n])) == 0)
+            return true;
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = DisplaySize;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    int run_count = 0, failed_count = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(Tests); n++)
+    {
+        if (!MatchTest(Tests[n].Name, argc, argv))
+            continue;
+        const int failures_before = GCheckFailures;
+        GRandState = 1;
+        ImNodeGraph::CreateContext();
+        Tests[n].Func();
+        if (ImNodeGraph::GetCurrentGraph() != NULL)
+            EndTestFrame();     // Failed check within a frame
+        ImNodeGraph::DestroyContext();
+        const bool failed = (GCheckFailures != failures_before);
+        printf("%-32s %s\n", Tests[n].Name, failed ? "FAILED" : "ok");
+        run_count++;
+        failed_count += failed ? 1 : 0;
+    }
+    ImGui::DestroyContext();
+    printf("%d tests, %d failed\n", run_count, failed_count);
+    return (failed_count == 0) ? 0 : 1;
+}